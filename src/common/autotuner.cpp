@@ -0,0 +1,265 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// autotuner.cpp
+//
+// Identification: src/common/autotuner.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/autotuner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace focus {
+
+namespace {
+
+// Bump when the meaning of stored choices changes.
+const char *kCacheHeader = "focus-tuning-cache\t1";
+
+std::string make_key(const std::string &op, const std::string &signature) {
+  if (op.empty() || signature.empty() ||
+      op.find_first_of(" \t\n") != std::string::npos ||
+      signature.find_first_of(" \t\n") != std::string::npos) {
+    throw std::invalid_argument("Autotuner: op and signature must be "
+                                "non-empty and free of whitespace");
+  }
+  return op + "\t" + signature;
+}
+
+} // namespace
+
+Autotuner::Autotuner(const std::string &cache_path, const std::string &cpu)
+    : repeats_(3), cache_path_(cache_path), cpu_(cpu) {
+  load();
+}
+
+/**
+ * @brief Returns the process-wide tuner.
+ *
+ * Persists to the file named by the `FOCUS_TUNING_CACHE` environment variable
+ * when set, and keeps the table in memory otherwise.
+ *
+ * @return Autotuner&
+ */
+Autotuner &Autotuner::global() {
+  static Autotuner tuner(std::getenv("FOCUS_TUNING_CACHE") != nullptr
+                             ? std::getenv("FOCUS_TUNING_CACHE")
+                             : "");
+  return tuner;
+}
+
+/**
+ * @brief Returns the CPU model name of this host.
+ *
+ * @return std::string
+ */
+std::string Autotuner::cpu_model() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0) {
+      size_t colon = line.find(':');
+      if (colon != std::string::npos) {
+        size_t start = line.find_first_not_of(" \t", colon + 1);
+        return start == std::string::npos ? "unknown" : line.substr(start);
+      }
+    }
+  }
+  return "unknown";
+}
+
+/**
+ * @brief Returns the index of the fastest of `num_candidates` configurations
+ * for `op` at `signature`.
+ *
+ * On a cache miss `run(i)` is timed for every candidate `i` and the winner is
+ * recorded. `op` and `signature` must not contain whitespace.
+ *
+ * @param op The op name, e.g. `"conv1d"`.
+ * @param signature The shape signature, e.g. `"n=8,l=4096,k=256"`.
+ * @param num_candidates Number of configurations to choose from.
+ * @param run Runs the op once with the given configuration.
+ * @return size_t
+ */
+size_t Autotuner::select(const std::string &op, const std::string &signature,
+                         size_t num_candidates,
+                         const std::function<void(size_t)> &run) {
+  if (num_candidates == 0) {
+    throw std::invalid_argument("Autotuner: no candidates");
+  }
+  size_t choice;
+  if (lookup(op, signature, choice) && choice < num_candidates) {
+    return choice;
+  }
+
+  // Time outside the lock; a concurrent miss on the same key only costs a
+  // second tuning run.
+  double best = std::numeric_limits<double>::max();
+  choice = 0;
+  for (size_t c = 0; c < num_candidates; ++c) {
+    run(c);
+    double fastest = std::numeric_limits<double>::max();
+    for (size_t r = 0; r < repeats_; ++r) {
+      auto start = std::chrono::steady_clock::now();
+      run(c);
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      fastest = std::min(fastest, elapsed.count());
+    }
+    if (fastest < best) {
+      best = fastest;
+      choice = c;
+    }
+  }
+  record(op, signature, choice);
+  return choice;
+}
+
+/**
+ * @brief Looks up a tuned configuration without timing anything.
+ *
+ * @param op The op name.
+ * @param signature The shape signature.
+ * @param choice Receives the configuration index on a hit.
+ * @return `true` on a hit, `false` otherwise.
+ */
+bool Autotuner::lookup(const std::string &op, const std::string &signature,
+                       size_t &choice) {
+  std::string key = make_key(op, signature);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, size_t>::const_iterator it = table_.find(key);
+  if (it == table_.end()) {
+    return false;
+  }
+  choice = it->second;
+  return true;
+}
+
+/**
+ * @brief Records input `choice` for `op` at `signature` and persists it.
+ *
+ * @param op The op name.
+ * @param signature The shape signature.
+ * @param choice The configuration index.
+ */
+void Autotuner::record(const std::string &op, const std::string &signature,
+                       size_t choice) {
+  std::string key = make_key(op, signature);
+  std::lock_guard<std::mutex> lock(mutex_);
+  table_[key] = choice;
+  save();
+}
+
+/*
+ * The cache file is a header line followed by one section per CPU model:
+ *
+ *   focus-tuning-cache<TAB>1
+ *   cpu<TAB><model name>
+ *   <op><TAB><signature><TAB><choice>
+ *   ...
+ *
+ * Files with another header are ignored and rewritten on the next save.
+ */
+void Autotuner::load() {
+  if (cache_path_.empty()) {
+    return;
+  }
+  std::ifstream in(cache_path_.c_str());
+  std::string line;
+  if (!std::getline(in, line) || line != kCacheHeader) {
+    return;
+  }
+  bool ours = false;
+  while (std::getline(in, line)) {
+    if (line.compare(0, 4, "cpu\t") == 0) {
+      ours = line.substr(4) == cpu_;
+      continue;
+    }
+    size_t tab = line.rfind('\t');
+    if (!ours || tab == std::string::npos || tab == 0) {
+      continue;
+    }
+    table_[line.substr(0, tab)] =
+        std::strtoul(line.c_str() + tab + 1, nullptr, 10);
+  }
+}
+
+void Autotuner::save() {
+  if (cache_path_.empty()) {
+    return;
+  }
+
+  // Keep the sections of other CPU models found in the current file.
+  std::ostringstream others;
+  {
+    std::ifstream in(cache_path_.c_str());
+    std::string line;
+    if (std::getline(in, line) && line == kCacheHeader) {
+      bool ours = false;
+      while (std::getline(in, line)) {
+        if (line.compare(0, 4, "cpu\t") == 0) {
+          ours = line.substr(4) == cpu_;
+        }
+        if (!ours) {
+          others << line << "\n";
+        }
+      }
+    }
+  }
+
+  std::ostringstream out;
+  out << kCacheHeader << "\n" << others.str() << "cpu\t" << cpu_ << "\n";
+  for (std::map<std::string, size_t>::const_iterator it = table_.begin();
+       it != table_.end(); ++it) {
+    out << it->first << "\t" << it->second << "\n";
+  }
+  const std::string contents = out.str();
+
+  // Write to a uniquely named file next to the cache and rename it into
+  // place, so concurrent readers never see a partial table and concurrent
+  // writers never share a temporary file.
+  std::string tmp_path = cache_path_ + ".XXXXXX";
+  std::vector<char> name(tmp_path.begin(), tmp_path.end());
+  name.push_back('\0');
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    return;
+  }
+  // mkstemp creates the file private to its owner; match a plain create.
+  fchmod(fd, 0644);
+  const char *data = contents.data();
+  size_t left = contents.size();
+  while (left > 0) {
+    ssize_t n = write(fd, data, left);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    data += n;
+    left -= static_cast<size_t>(n);
+  }
+  if (close(fd) != 0 || left > 0 ||
+      std::rename(name.data(), cache_path_.c_str()) != 0) {
+    unlink(name.data());
+  }
+}
+
+} // namespace focus
@@ -0,0 +1,359 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// placement.cpp
+//
+// Identification: src/common/placement.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/placement.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "common/thread_pool.h"
+
+namespace focus {
+
+namespace {
+
+const size_t kHugePageSize = size_t(2) << 20;
+
+// Memory policy modes from <linux/mempolicy.h>, which not every toolchain
+// ships.
+const int kMpolBind = 2;
+const int kMpolInterleave = 3;
+
+// Pages queried per `move_pages` call.
+const size_t kQueryBatch = 1024;
+
+struct Allocation {
+  size_t bytes_;
+  size_t mapped_;
+  bool huge_;
+};
+
+std::mutex &registry_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<void *, Allocation> &registry() {
+  static std::map<void *, Allocation> allocations;
+  return allocations;
+}
+
+size_t page_size() {
+  static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+size_t round_up(size_t n, size_t multiple) {
+  return (n + multiple - 1) / multiple * multiple;
+}
+
+void *map_anonymous(size_t bytes, int flags) {
+  return mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+}
+
+/**
+ * Maps at least `bytes` bytes with the page size `options` asks for, and
+ * returns the mapped length and whether reserved huge pages back it.
+ */
+char *map_pages(size_t bytes, const PlacementOptions &options, size_t &mapped,
+                bool &huge) {
+  huge = false;
+  const bool large = bytes >= options.huge_page_threshold_;
+  if (large && options.huge_pages_ == HugePagePolicy::EXPLICIT) {
+    mapped = round_up(bytes, kHugePageSize);
+    void *data = map_anonymous(mapped, MAP_HUGETLB);
+    if (data != MAP_FAILED) {
+      huge = true;
+      return static_cast<char *>(data);
+    }
+  }
+
+  if (large && options.huge_pages_ != HugePagePolicy::NONE) {
+    // Over-map and trim so the range starts on a huge page boundary and
+    // transparent huge pages can back all of it.
+    mapped = round_up(bytes, kHugePageSize);
+    const size_t span = mapped + kHugePageSize;
+    void *raw = map_anonymous(span, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    char *base = static_cast<char *>(raw);
+    char *data = reinterpret_cast<char *>(
+        round_up(reinterpret_cast<uintptr_t>(base), kHugePageSize));
+    if (data > base) {
+      munmap(base, data - base);
+    }
+    if (base + span > data + mapped) {
+      munmap(data + mapped, base + span - (data + mapped));
+    }
+    // Advisory only; kernels with THP disabled keep base pages.
+    madvise(data, mapped, MADV_HUGEPAGE);
+    return data;
+  }
+
+  mapped = round_up(bytes, page_size());
+  void *data = map_anonymous(mapped, 0);
+  if (data == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  return static_cast<char *>(data);
+}
+
+/**
+ * Applies the node policy to a mapping before any page is touched. A refused
+ * `mbind` leaves the default policy in place.
+ */
+void bind_pages(void *data, size_t mapped, const PlacementOptions &options) {
+  if (options.numa_ != NumaPolicy::BIND &&
+      options.numa_ != NumaPolicy::INTERLEAVE) {
+    return;
+  }
+  const size_t nodes = numa_node_count();
+  const size_t bits = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> mask((nodes + bits - 1) / bits, 0);
+  int mode = kMpolInterleave;
+  if (options.numa_ == NumaPolicy::BIND) {
+    mode = kMpolBind;
+    mask[options.node_ / bits] |= 1UL << (options.node_ % bits);
+  } else {
+    for (size_t node = 0; node < nodes; ++node) {
+      mask[node / bits] |= 1UL << (node % bits);
+    }
+  }
+  // The kernel reads `maxnode - 1` bits of the mask.
+  syscall(SYS_mbind, data, mapped, mode, mask.data(), nodes + 1, 0);
+}
+
+void merge(PlacementReport &into, const PlacementReport &from) {
+  for (size_t node = 0; node < from.node_bytes_.size(); ++node) {
+    into.node_bytes_[node] += from.node_bytes_[node];
+  }
+  into.unresident_bytes_ += from.unresident_bytes_;
+  into.unknown_bytes_ += from.unknown_bytes_;
+  into.huge_page_bytes_ += from.huge_page_bytes_;
+}
+
+} // namespace
+
+/**
+ * @brief Returns one line per node plus the unresident, unknown and huge page
+ * totals.
+ *
+ * @return std::string
+ */
+std::string PlacementReport::to_string() const {
+  std::ostringstream out;
+  for (size_t node = 0; node < node_bytes_.size(); ++node) {
+    out << "node " << node << ": " << node_bytes_[node] << " bytes\n";
+  }
+  out << "unresident: " << unresident_bytes_ << " bytes\n";
+  out << "unknown: " << unknown_bytes_ << " bytes\n";
+  out << "huge pages: " << huge_page_bytes_ << " bytes\n";
+  return out.str();
+}
+
+/**
+ * @brief Returns the number of NUMA nodes on this host, at least 1.
+ *
+ * @return size_t
+ */
+size_t numa_node_count() {
+  static const size_t count = [] {
+    size_t nodes = 1;
+    DIR *dir = opendir("/sys/devices/system/node");
+    if (dir == nullptr) {
+      return nodes;
+    }
+    while (struct dirent *entry = readdir(dir)) {
+      const char *name = entry->d_name;
+      if (std::strncmp(name, "node", 4) != 0 || name[4] < '0' ||
+          name[4] > '9') {
+        continue;
+      }
+      nodes = std::max<size_t>(nodes, std::strtoul(name + 4, nullptr, 10) + 1);
+    }
+    closedir(dir);
+    return nodes;
+  }();
+  return count;
+}
+
+/**
+ * @brief Maps `bytes` bytes placed according to `options`.
+ *
+ * The memory is zeroed, or copied from `init` when it is not `nullptr`. With
+ * `NumaPolicy::PARALLEL_PREFAULT` the fill is split with `parallel_for`, which
+ * faults pages in from several threads at once but does not choose their
+ * nodes. Node policies are best effort: hosts or sandboxes that refuse `mbind`
+ * keep the default policy. Allocations are rounded up to whole pages, so this
+ * is meant for large buffers.
+ *
+ * @param bytes The size in bytes.
+ * @param options The placement policies.
+ * @param init Optional `bytes` bytes to copy in, may be `nullptr`.
+ * @return void*
+ */
+void *placed_alloc(size_t bytes, const PlacementOptions &options,
+                   const void *init) {
+  if (options.numa_ == NumaPolicy::BIND &&
+      options.node_ >= numa_node_count()) {
+    throw std::out_of_range("placed_alloc: node out of range");
+  }
+  size_t mapped;
+  bool huge;
+  char *data = map_pages(std::max<size_t>(bytes, 1), options, mapped, huge);
+  bind_pages(data, mapped, options);
+
+  // Fresh anonymous pages read as zero, so only prefaulting needs a fill
+  // without `init`. Part 0 runs on the caller and the rest go to whichever
+  // worker is free, so this parallelises the page faults; it does not tie a
+  // slice to a node.
+  const char *src = static_cast<const char *>(init);
+  if (options.numa_ == NumaPolicy::PARALLEL_PREFAULT) {
+    parallel_for(0, bytes, [&](size_t lo, size_t hi) {
+      if (src != nullptr) {
+        std::memcpy(data + lo, src + lo, hi - lo);
+      } else {
+        std::memset(data + lo, 0, hi - lo);
+      }
+    });
+  } else if (src != nullptr) {
+    std::memcpy(data, src, bytes);
+  }
+
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  Allocation allocation = {bytes, mapped, huge};
+  registry()[data] = allocation;
+  return data;
+}
+
+/**
+ * @brief Unmaps memory returned by `placed_alloc`.
+ *
+ * @param ptr The allocation, may be `nullptr`.
+ */
+void placed_free(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  size_t mapped;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    auto it = registry().find(ptr);
+    if (it == registry().end()) {
+      throw std::invalid_argument("placed_free: unknown allocation");
+    }
+    mapped = it->second.mapped_;
+    registry().erase(it);
+  }
+  munmap(ptr, mapped);
+}
+
+/**
+ * @brief Makes memory returned by `placed_alloc` read-only.
+ *
+ * @param ptr The allocation.
+ */
+void placed_protect(void *ptr) {
+  size_t mapped;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    auto it = registry().find(ptr);
+    if (it == registry().end()) {
+      throw std::invalid_argument("placed_protect: unknown allocation");
+    }
+    mapped = it->second.mapped_;
+  }
+  if (mprotect(ptr, mapped, PROT_READ) != 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "placed_protect: mprotect");
+  }
+}
+
+/**
+ * @brief Reports where the pages of `[data, data + bytes)` live.
+ *
+ * @param data The first byte.
+ * @param bytes The size in bytes.
+ * @return PlacementReport
+ */
+PlacementReport placement_report(const void *data, size_t bytes) {
+  PlacementReport report;
+  report.node_bytes_.assign(numa_node_count(), 0);
+  const size_t page = page_size();
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+  const uintptr_t end = begin + bytes;
+
+  std::vector<void *> pages;
+  std::vector<int> status;
+  for (uintptr_t first = begin / page * page; first < end;
+       first += kQueryBatch * page) {
+    pages.clear();
+    for (uintptr_t p = first; p < end && pages.size() < kQueryBatch;
+         p += page) {
+      pages.push_back(reinterpret_cast<void *>(p));
+    }
+    status.assign(pages.size(), 0);
+    // With no target nodes, `move_pages` only reports where pages are.
+    long rc = syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr,
+                      status.data(), 0);
+    for (size_t i = 0; i < pages.size(); ++i) {
+      const uintptr_t p = reinterpret_cast<uintptr_t>(pages[i]);
+      const size_t overlap = std::min(end, p + page) - std::max(begin, p);
+      if (rc != 0) {
+        report.unknown_bytes_ += overlap;
+      } else if (status[i] >= 0 &&
+                 static_cast<size_t>(status[i]) < report.node_bytes_.size()) {
+        report.node_bytes_[status[i]] += overlap;
+      } else if (status[i] == -ENOENT || status[i] == -EFAULT) {
+        report.unresident_bytes_ += overlap;
+      } else {
+        report.unknown_bytes_ += overlap;
+      }
+    }
+  }
+  return report;
+}
+
+/**
+ * @brief Reports where the pages of every live `placed_alloc` allocation
+ * live.
+ *
+ * @return PlacementReport
+ */
+PlacementReport placement_report() {
+  PlacementReport report;
+  report.node_bytes_.assign(numa_node_count(), 0);
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  for (auto it = registry().begin(); it != registry().end(); ++it) {
+    merge(report, placement_report(it->first, it->second.bytes_));
+    if (it->second.huge_) {
+      report.huge_page_bytes_ += it->second.bytes_;
+    }
+  }
+  return report;
+}
+
+} // namespace focus
@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// thread_pool.cpp
+//
+// Identification: src/common/thread_pool.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+
+namespace focus {
+
+namespace {
+
+// Set on pool workers so nested `parallel_for` calls run inline.
+thread_local bool in_worker = false;
+
+size_t default_num_threads() {
+  const char *env = std::getenv("FOCUS_NUM_THREADS");
+  if (env != nullptr) {
+    long value = std::strtol(env, nullptr, 10);
+    if (value > 0) {
+      return static_cast<size_t>(value);
+    }
+  }
+  size_t hw = std::thread::hardware_concurrency();
+  return hw > 0 ? hw : 1;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads) : stopping_(false) {
+  num_threads = std::max<size_t>(num_threads, 1);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::thread(&ThreadPool::run, this));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i].join();
+  }
+}
+
+/**
+ * @brief Returns the process-wide pool used by the kernels.
+ *
+ * Sized from the `FOCUS_NUM_THREADS` environment variable when set, and from
+ * the hardware concurrency otherwise.
+ *
+ * @return ThreadPool&
+ */
+ThreadPool &ThreadPool::global() {
+  static ThreadPool pool(default_num_threads());
+  return pool;
+}
+
+/**
+ * @brief Queues input `task` to run on a worker thread.
+ *
+ * @param task The task to run.
+ */
+void ThreadPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+/**
+ * @brief Splits `[begin, end)` into at most `num_threads()` contiguous ranges
+ * and runs `fn(range_begin, range_end)` on each in parallel.
+ *
+ * The calling thread runs one of the ranges itself and returns once all of
+ * them are done. The first exception thrown by `fn` is rethrown. Calls made
+ * from inside a worker run serially so nested parallelism cannot deadlock.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param fn The function to run on each range.
+ */
+void ThreadPool::parallel_for(size_t begin, size_t end,
+                              const std::function<void(size_t, size_t)> &fn) {
+  if (begin >= end) {
+    return;
+  }
+  size_t total = end - begin;
+  size_t parts = std::min(total, workers_.size());
+  if (parts <= 1 || in_worker) {
+    fn(begin, end);
+    return;
+  }
+
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  size_t remaining = parts - 1;
+  std::exception_ptr error;
+
+  auto run_part = [&](size_t part) {
+    size_t lo = begin + total * part / parts;
+    size_t hi = begin + total * (part + 1) / parts;
+    try {
+      fn(lo, hi);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(done_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  for (size_t part = 1; part < parts; ++part) {
+    submit([&, part] {
+      run_part(part);
+      std::lock_guard<std::mutex> lock(done_mutex);
+      if (--remaining == 0) {
+        done_cv.notify_one();
+      }
+    });
+  }
+  run_part(0);
+
+  std::unique_lock<std::mutex> lock(done_mutex);
+  done_cv.wait(lock, [&] { return remaining == 0; });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::run() {
+  in_worker = true;
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (stopping_ && tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+/**
+ * @brief Runs `fn` over `[begin, end)` on the global thread pool.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param fn The function to run on each range.
+ */
+void parallel_for(size_t begin, size_t end,
+                  const std::function<void(size_t, size_t)> &fn) {
+  ThreadPool::global().parallel_for(begin, end, fn);
+}
+
+} // namespace focus
@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// workspace.cpp
+//
+// Identification: src/common/workspace.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/workspace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace focus {
+
+namespace {
+
+// Cache-line alignment, which also suits every vector width in use.
+const size_t kAlignment = 64;
+
+// Smallest block, so tiny first requests do not cause a chain of growths.
+const size_t kMinBlock = size_t(64) << 10;
+
+size_t align_up(size_t n) {
+  return (n + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+char *allocate_block(size_t bytes) {
+  void *data = nullptr;
+  if (posix_memalign(&data, kAlignment, bytes) != 0) {
+    throw std::bad_alloc();
+  }
+  return static_cast<char *>(data);
+}
+
+} // namespace
+
+Workspace::Workspace() : current_(0), used_(0), high_water_(0) {}
+
+Workspace::~Workspace() {
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    std::free(blocks_[i].data_);
+  }
+}
+
+/**
+ * @brief Returns the workspace of the calling thread.
+ *
+ * @return Workspace&
+ */
+Workspace &Workspace::local() {
+  thread_local Workspace workspace;
+  return workspace;
+}
+
+/**
+ * @brief Returns `bytes` uninitialized bytes, aligned to 64 bytes.
+ *
+ * The memory stays valid until the enclosing `WorkspaceScope` closes.
+ *
+ * @param bytes The size in bytes.
+ * @return void*
+ */
+void *Workspace::allocate(size_t bytes) {
+  bytes = align_up(std::max<size_t>(bytes, 1));
+  // Move on to a later block that fits, or add one. Earlier blocks stay put so
+  // outstanding pointers remain valid.
+  while (current_ < blocks_.size() &&
+         blocks_[current_].offset_ + bytes > blocks_[current_].size_) {
+    ++current_;
+    if (current_ < blocks_.size()) {
+      blocks_[current_].offset_ = 0;
+    }
+  }
+  if (current_ == blocks_.size()) {
+    const size_t size = std::max(std::max(bytes, kMinBlock), 2 * capacity());
+    Block block = {allocate_block(size), size, 0};
+    blocks_.push_back(block);
+  }
+
+  Block &block = blocks_[current_];
+  char *data = block.data_ + block.offset_;
+  block.offset_ += bytes;
+  used_ += bytes;
+  high_water_ = std::max(high_water_, used_);
+  return data;
+}
+
+/** @brief Returns the current position. */
+Workspace::Mark Workspace::mark() const {
+  Mark mark = {current_, current_ < blocks_.size() ? blocks_[current_].offset_
+                                                   : 0};
+  return mark;
+}
+
+/**
+ * @brief Releases everything allocated since `mark` was taken.
+ *
+ * @param mark A position returned by `mark`.
+ */
+void Workspace::release(const Mark &mark) {
+  size_t freed = 0;
+  for (size_t i = mark.block_; i <= current_ && i < blocks_.size(); ++i) {
+    const size_t from = i == mark.block_ ? mark.offset_ : 0;
+    freed += blocks_[i].offset_ - from;
+    blocks_[i].offset_ = from;
+  }
+  current_ = mark.block_;
+  used_ -= freed;
+
+  // Once idle, replace a chain of blocks with one block that fits the
+  // high-water mark.
+  if (used_ == 0 && blocks_.size() > 1) {
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      std::free(blocks_[i].data_);
+    }
+    blocks_.clear();
+    const size_t size = std::max(high_water_, kMinBlock);
+    Block block = {allocate_block(size), size, 0};
+    blocks_.push_back(block);
+    current_ = 0;
+  }
+}
+
+/** @brief Returns the bytes reserved across all blocks. */
+size_t Workspace::capacity() const {
+  size_t total = 0;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    total += blocks_[i].size_;
+  }
+  return total;
+}
+
+} // namespace focus
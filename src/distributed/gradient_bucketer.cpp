@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// gradient_bucketer.cpp
+//
+// Identification: src/distributed/gradient_bucketer.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "distributed/gradient_bucketer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace focus {
+
+/**
+ * @param group The group to reduce across.
+ * @param params The parameters in forward order; all must require grad.
+ * @param options Bucketing options.
+ */
+GradientBucketer::GradientBucketer(ProcessGroup &group,
+                                   std::vector<FloatTensor *> params,
+                                   GradientBucketerOptions options)
+    : group_(group), options_(options), marked_(params.size(), false),
+      launched_(0), completed_(0), stopping_(false) {
+  size_t numel = 0;
+  for (size_t i = params.size(); i-- > 0;) {
+    FloatTensor *param = params[i];
+    if (!param->requires_grad_) {
+      throw std::invalid_argument("GradientBucketer: parameter has no grad");
+    }
+    if (!param_index_.insert(std::make_pair(param, i)).second) {
+      throw std::invalid_argument("GradientBucketer: duplicate parameter");
+    }
+    if (buckets_.empty() || numel + param->numel_ > options_.bucket_numel_) {
+      buckets_.push_back(Bucket());
+      numel = 0;
+    }
+    buckets_.back().params_.push_back(param);
+    bucket_of_[param] = buckets_.size() - 1;
+    numel += param->numel_;
+  }
+  for (size_t b = 0; b < buckets_.size(); ++b) {
+    Bucket &bucket = buckets_[b];
+    size_t total = 0;
+    for (size_t i = 0; i < bucket.params_.size(); ++i) {
+      total += bucket.params_[i]->numel_;
+    }
+    bucket.flat_.resize(total);
+    bucket.pending_ = bucket.params_.size();
+  }
+  worker_ = std::thread(&GradientBucketer::run, this);
+}
+
+GradientBucketer::~GradientBucketer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    // Destroyed mid-step with a bucket still unreduced: the worker may be
+    // blocked in a collective the other ranks will never finish, and they in
+    // one this rank will never join. Abort the group so both sides fail
+    // instead of hanging. A step whose buckets all finished leaves it alone.
+    if (completed_ < buckets_.size() &&
+        std::find(marked_.begin(), marked_.end(), true) != marked_.end()) {
+      group_.abort();
+    }
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+/**
+ * @brief Declares that `param.grad_` is final for this step.
+ *
+ * @param param One of the parameters the bucketer was built with.
+ */
+void GradientBucketer::mark_ready(FloatTensor &param) {
+  std::map<FloatTensor *, size_t>::iterator it = param_index_.find(&param);
+  if (it == param_index_.end()) {
+    throw std::invalid_argument("mark_ready: unknown parameter");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (marked_[it->second]) {
+    throw std::invalid_argument("mark_ready: parameter marked twice");
+  }
+  marked_[it->second] = true;
+  --buckets_[bucket_of_[&param]].pending_;
+
+  // Launch only the ready prefix so every rank reduces buckets in the same
+  // order, whatever order its gradients finish in.
+  size_t launched = launched_;
+  while (launched_ < buckets_.size() && buckets_[launched_].pending_ == 0) {
+    ++launched_;
+  }
+  if (launched_ != launched) {
+    cv_.notify_all();
+  }
+}
+
+/**
+ * @brief Returns `true` once every bucket of the current step has been
+ * reduced, without blocking.
+ *
+ * @return bool
+ */
+bool GradientBucketer::finished() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return completed_ == buckets_.size();
+}
+
+/**
+ * @brief Blocks until every bucket has been reduced, then resets for the next
+ * step. Rethrows the first communication error.
+ */
+void GradientBucketer::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (launched_ != buckets_.size()) {
+    throw std::logic_error("wait: not every parameter was marked ready");
+  }
+  cv_.wait(lock, [this] { return completed_ == buckets_.size(); });
+
+  launched_ = 0;
+  completed_ = 0;
+  std::fill(marked_.begin(), marked_.end(), false);
+  for (size_t b = 0; b < buckets_.size(); ++b) {
+    buckets_[b].pending_ = buckets_[b].params_.size();
+  }
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void GradientBucketer::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this] { return stopping_ || completed_ < launched_; });
+    if (completed_ == launched_) {
+      return;
+    }
+    Bucket &bucket = buckets_[completed_];
+    bool failed = error_ != nullptr;
+    lock.unlock();
+    // Once a collective has failed the ranks are out of step; skip the rest.
+    if (!failed) {
+      try {
+        reduce(bucket);
+      } catch (...) {
+        lock.lock();
+        error_ = std::current_exception();
+        lock.unlock();
+      }
+    }
+    lock.lock();
+    ++completed_;
+    cv_.notify_all();
+  }
+}
+
+void GradientBucketer::reduce(Bucket &bucket) {
+  float *flat = bucket.flat_.data();
+  for (size_t i = 0; i < bucket.params_.size(); ++i) {
+    FloatTensor *param = bucket.params_[i];
+    std::copy(param->grad_, param->grad_ + param->numel_, flat);
+    flat += param->numel_;
+  }
+
+  group_.all_reduce(bucket.flat_.data(), bucket.flat_.size(),
+                    options_.algorithm_);
+
+  float scale = options_.average_ ? 1.0f / group_.world_size() : 1.0f;
+  flat = bucket.flat_.data();
+  for (size_t i = 0; i < bucket.params_.size(); ++i) {
+    FloatTensor *param = bucket.params_[i];
+    for (size_t j = 0; j < param->numel_; ++j) {
+      param->grad_[j] = flat[j] * scale;
+    }
+    flat += param->numel_;
+  }
+}
+
+} // namespace focus
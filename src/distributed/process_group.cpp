@@ -0,0 +1,300 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// process_group.cpp
+//
+// Identification: src/distributed/process_group.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "distributed/process_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <sys/mman.h>
+
+namespace focus {
+
+namespace {
+
+const uint64_t kGroupMagic = 0x464f435553504731ULL; // "FOCUSPG1"
+
+const size_t kAlignment = 64;
+
+// How long non-zero ranks wait for rank 0 to create the group.
+const std::chrono::seconds kJoinTimeout(30);
+
+size_t align_up(size_t n) {
+  return (n + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+} // namespace
+
+struct ProcessGroup::Header {
+  std::atomic<uint64_t> magic_;
+  uint64_t session_;
+  uint64_t world_size_;
+  uint64_t buffer_numel_;
+  alignas(64) std::atomic<uint64_t> arrived_;
+  alignas(64) std::atomic<uint64_t> generation_;
+  std::atomic<uint64_t> aborted_;
+};
+
+ProcessGroup::ProcessGroup(const std::string &name, uint64_t session,
+                           size_t rank, size_t world_size,
+                           size_t buffer_numel)
+    : rank_(rank), world_size_(world_size), buffer_numel_(buffer_numel) {
+  if (world_size == 0 || rank >= world_size || buffer_numel == 0) {
+    throw std::invalid_argument("ProcessGroup: invalid rank or size");
+  }
+  const size_t bytes = align_up(sizeof(Header)) +
+                       world_size * align_up(buffer_numel * sizeof(float));
+
+  if (rank == 0) {
+    // Drop a segment left behind by a crashed run before recreating it.
+    std::string path = name.empty() || name[0] != '/' ? "/" + name : name;
+    shm_unlink(path.c_str());
+    segment_.reset(new SharedMemorySegment(name, bytes));
+    Header *h = new (segment_->data()) Header();
+    h->session_ = session;
+    h->world_size_ = world_size;
+    h->buffer_numel_ = buffer_numel;
+    h->arrived_.store(0);
+    h->generation_.store(0);
+    h->aborted_.store(0);
+    h->magic_.store(kGroupMagic);
+  } else {
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + kJoinTimeout;
+    for (;;) {
+      try {
+        segment_.reset(new SharedMemorySegment(name));
+        // A segment from another run is skipped until rank 0 replaces it.
+        if (segment_->size() >= bytes &&
+            header()->magic_.load() == kGroupMagic &&
+            header()->session_ == session) {
+          break;
+        }
+        segment_.reset();
+      } catch (const std::system_error &) {
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        throw std::runtime_error("ProcessGroup: timed out joining " + name);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (header()->world_size_ != world_size ||
+        header()->buffer_numel_ != buffer_numel) {
+      throw std::invalid_argument("ProcessGroup: configuration mismatch");
+    }
+  }
+  barrier();
+}
+
+ProcessGroup::~ProcessGroup() {}
+
+/**
+ * @brief Blocks until every rank has reached the barrier.
+ *
+ * @throws std::runtime_error if the group has been aborted.
+ */
+void ProcessGroup::barrier() {
+  Header *h = header();
+  if (h->aborted_.load(std::memory_order_acquire) != 0) {
+    throw std::runtime_error("ProcessGroup: group was aborted");
+  }
+  uint64_t generation = h->generation_.load(std::memory_order_acquire);
+  if (h->arrived_.fetch_add(1, std::memory_order_acq_rel) ==
+      world_size_ - 1) {
+    h->arrived_.store(0, std::memory_order_relaxed);
+    h->generation_.fetch_add(1, std::memory_order_acq_rel);
+    return;
+  }
+  while (h->generation_.load(std::memory_order_acquire) == generation) {
+    if (h->aborted_.load(std::memory_order_acquire) != 0) {
+      throw std::runtime_error("ProcessGroup: group was aborted");
+    }
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * @brief Fails the group on every rank.
+ *
+ * Any collective blocked on this or another rank, and every later one, throws
+ * `std::runtime_error`. Safe to call from any thread; used to tear down a rank
+ * whose peers will never arrive.
+ */
+void ProcessGroup::abort() {
+  header()->aborted_.store(1, std::memory_order_release);
+}
+
+/**
+ * @brief Replaces `data` on every rank with the element-wise sum over ranks.
+ *
+ * @param data The values to reduce, `count` floats.
+ * @param count Number of floats.
+ * @param algorithm The reduction schedule.
+ */
+void ProcessGroup::all_reduce(float *data, size_t count,
+                              AllReduceAlgorithm algorithm) {
+  if (world_size_ == 1) {
+    return;
+  }
+  for (size_t offset = 0; offset < count; offset += buffer_numel_) {
+    size_t n = std::min(buffer_numel_, count - offset);
+    if (algorithm == AllReduceAlgorithm::RING) {
+      ring_all_reduce(data + offset, n);
+    } else {
+      tree_all_reduce(data + offset, n);
+    }
+  }
+}
+
+/**
+ * @brief Sums `tensor.grad_` across ranks in place.
+ *
+ * @param tensor The tensor whose gradient to reduce.
+ * @param algorithm The reduction schedule.
+ */
+void ProcessGroup::all_reduce_grad(FloatTensor &tensor,
+                                   AllReduceAlgorithm algorithm) {
+  if (!tensor.requires_grad_) {
+    throw std::invalid_argument("all_reduce_grad: tensor has no gradient");
+  }
+  all_reduce(tensor.grad_, tensor.numel_, algorithm);
+}
+
+/**
+ * @brief Copies `data` from rank `root` to every other rank.
+ *
+ * @param data The values to send on `root` and to overwrite elsewhere.
+ * @param count Number of floats.
+ * @param root The sending rank.
+ */
+void ProcessGroup::broadcast(float *data, size_t count, size_t root) {
+  if (root >= world_size_) {
+    throw std::invalid_argument("broadcast: invalid root");
+  }
+  for (size_t offset = 0; offset < count; offset += buffer_numel_) {
+    size_t n = std::min(buffer_numel_, count - offset);
+    if (rank_ == root) {
+      std::memcpy(buffer(root), data + offset, n * sizeof(float));
+    }
+    barrier();
+    if (rank_ != root) {
+      std::memcpy(data + offset, buffer(root), n * sizeof(float));
+    }
+    barrier();
+  }
+}
+
+/**
+ * @brief Sums `input` across ranks and leaves chunk `rank()` of the result in
+ * `output`.
+ *
+ * @param input `world_size() * count` floats on every rank.
+ * @param output Receives `count` floats.
+ * @param count Number of floats per rank.
+ */
+void ProcessGroup::reduce_scatter(const float *input, float *output,
+                                  size_t count) {
+  // Stage every rank's copy of one slice of each chunk, then let every rank
+  // sum its own chunk straight out of the peers' buffers.
+  const size_t piece = std::max<size_t>(1, buffer_numel_ / world_size_);
+  for (size_t offset = 0; offset < count; offset += piece) {
+    size_t n = std::min(piece, count - offset);
+    float *mine = buffer(rank_);
+    for (size_t r = 0; r < world_size_; ++r) {
+      std::memcpy(mine + r * n, input + r * count + offset, n * sizeof(float));
+    }
+    barrier();
+    std::fill(output + offset, output + offset + n, 0.0f);
+    for (size_t r = 0; r < world_size_; ++r) {
+      const float *src = buffer(r) + rank_ * n;
+      for (size_t i = 0; i < n; ++i) {
+        output[offset + i] += src[i];
+      }
+    }
+    barrier();
+  }
+}
+
+ProcessGroup::Header *ProcessGroup::header() const {
+  return static_cast<Header *>(segment_->data());
+}
+
+float *ProcessGroup::buffer(size_t rank) const {
+  char *base = static_cast<char *>(segment_->data()) + align_up(sizeof(Header));
+  return reinterpret_cast<float *>(
+      base + rank * align_up(buffer_numel_ * sizeof(float)));
+}
+
+/*
+ * Ring all-reduce over the staging buffers. The data is cut into one chunk
+ * per rank. In reduce-scatter step `s`, rank `r` adds chunk `r - s - 1` of its
+ * left neighbour into its own buffer; after `W - 1` steps it holds the full
+ * sum of chunk `r + 1`. The all-gather phase then passes the finished chunks
+ * around the ring the same way. In every step a rank writes a different chunk
+ * from the one its right neighbour reads, so one barrier per step suffices.
+ */
+void ProcessGroup::ring_all_reduce(float *data, size_t count) {
+  const size_t w = world_size_;
+  float *mine = buffer(rank_);
+  const float *left = buffer((rank_ + w - 1) % w);
+  std::memcpy(mine, data, count * sizeof(float));
+  barrier();
+
+  for (size_t s = 0; s + 1 < w; ++s) {
+    size_t chunk = (rank_ + 2 * w - s - 1) % w;
+    size_t lo = count * chunk / w;
+    size_t hi = count * (chunk + 1) / w;
+    for (size_t i = lo; i < hi; ++i) {
+      mine[i] += left[i];
+    }
+    barrier();
+  }
+  for (size_t s = 0; s + 1 < w; ++s) {
+    size_t chunk = (rank_ + 2 * w - s) % w;
+    size_t lo = count * chunk / w;
+    size_t hi = count * (chunk + 1) / w;
+    std::memcpy(mine + lo, left + lo, (hi - lo) * sizeof(float));
+    barrier();
+  }
+
+  std::memcpy(data, mine, count * sizeof(float));
+  barrier();
+}
+
+/*
+ * Binomial-tree reduction into rank 0 followed by every rank copying the
+ * result out of rank 0's buffer.
+ */
+void ProcessGroup::tree_all_reduce(float *data, size_t count) {
+  float *mine = buffer(rank_);
+  std::memcpy(mine, data, count * sizeof(float));
+  barrier();
+
+  for (size_t stride = 1; stride < world_size_; stride *= 2) {
+    if (rank_ % (2 * stride) == 0 && rank_ + stride < world_size_) {
+      const float *peer = buffer(rank_ + stride);
+      for (size_t i = 0; i < count; ++i) {
+        mine[i] += peer[i];
+      }
+    }
+    barrier();
+  }
+
+  std::memcpy(data, buffer(0), count * sizeof(float));
+  barrier();
+}
+
+} // namespace focus
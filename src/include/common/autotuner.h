@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// autotuner.h
+//
+// Identification: src/include/common/autotuner.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace focus {
+
+/**
+ * @brief Picks the fastest kernel configuration per op and shape.
+ *
+ * Candidates are timed on first use of an (op, signature) pair and the winner
+ * is kept in memory. When a cache path is set the table is also persisted to
+ * a versioned file, in one section per CPU model, so later processes on the
+ * same kind of host skip tuning.
+ */
+class Autotuner {
+public:
+  /**
+   * @brief Creates a tuner backed by input `cache_path`.
+   *
+   * @param cache_path The cache file, or an empty string for memory only.
+   * @param cpu The CPU model the entries are keyed by.
+   */
+  explicit Autotuner(const std::string &cache_path = "",
+                     const std::string &cpu = cpu_model());
+
+  /**
+   * @brief Returns the process-wide tuner.
+   *
+   * Persists to the file named by the `FOCUS_TUNING_CACHE` environment
+   * variable when set, and keeps the table in memory otherwise.
+   *
+   * @return Autotuner&
+   */
+  static Autotuner &global();
+
+  /**
+   * @brief Returns the CPU model name of this host.
+   *
+   * @return std::string
+   */
+  static std::string cpu_model();
+
+  /**
+   * @brief Returns the index of the fastest of `num_candidates`
+   * configurations for `op` at `signature`.
+   *
+   * On a cache miss `run(i)` is timed for every candidate `i` and the winner
+   * is recorded. `op` and `signature` must not contain whitespace.
+   *
+   * @param op The op name, e.g. `"conv1d"`.
+   * @param signature The shape signature, e.g. `"n=8,l=4096,k=256"`.
+   * @param num_candidates Number of configurations to choose from.
+   * @param run Runs the op once with the given configuration.
+   * @return size_t
+   */
+  size_t select(const std::string &op, const std::string &signature,
+                size_t num_candidates, const std::function<void(size_t)> &run);
+
+  /**
+   * @brief Looks up a tuned configuration without timing anything.
+   *
+   * @param op The op name.
+   * @param signature The shape signature.
+   * @param choice Receives the configuration index on a hit.
+   * @return `true` on a hit, `false` otherwise.
+   */
+  bool lookup(const std::string &op, const std::string &signature,
+              size_t &choice);
+
+  /**
+   * @brief Records input `choice` for `op` at `signature` and persists it.
+   *
+   * @param op The op name.
+   * @param signature The shape signature.
+   * @param choice The configuration index.
+   */
+  void record(const std::string &op, const std::string &signature,
+              size_t choice);
+
+  /** @brief Number of timed runs per candidate, after one warm-up run. */
+  size_t repeats_;
+
+private:
+  void load();
+  void save();
+
+  std::string cache_path_;
+  std::string cpu_;
+  std::map<std::string, size_t> table_;
+  std::mutex mutex_;
+};
+
+} // namespace focus
@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// mpmc_queue.h
+//
+// Identification: src/include/common/mpmc_queue.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace focus {
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * Every slot carries a sequence number that tells producers and consumers
+ * whether the slot is free for the current lap of the ring, so neither side
+ * ever takes a lock. `capacity` is rounded up to the next power of two.
+ */
+template <typename T>
+class MpmcQueue {
+public:
+  explicit MpmcQueue(size_t capacity)
+      : mask_(round_up_pow2(capacity) - 1), slots_(mask_ + 1), enqueue_pos_(0),
+        dequeue_pos_(0) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+  /**
+   * @brief Pushes input `value` onto the queue.
+   *
+   * @param value The value to push.
+   * @return `false` if the queue is full, `true` otherwise.
+   */
+  bool push(const T &value) {
+    Slot *slot;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->sequence_.load(std::memory_order_acquire);
+      ptrdiff_t diff =
+          static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value_ = value;
+    slot->sequence_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pops the oldest value off the queue into input `value`.
+   *
+   * @param value Receives the popped value.
+   * @return `false` if the queue is empty, `true` otherwise.
+   */
+  bool pop(T &value) {
+    Slot *slot;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->sequence_.load(std::memory_order_acquire);
+      ptrdiff_t diff =
+          static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = slot->value_;
+    slot->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** @brief Returns the number of slots in the ring. */
+  size_t capacity() const { return mask_ + 1; }
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence_;
+    T value_;
+  };
+
+  static size_t round_up_pow2(size_t n) {
+    size_t out = 1;
+    while (out < n) {
+      out <<= 1;
+    }
+    return out;
+  }
+
+  const size_t mask_;
+  std::vector<Slot> slots_;
+
+  // Producers and consumers hammer separate counters, keep them on separate
+  // cache lines.
+  alignas(64) std::atomic<size_t> enqueue_pos_;
+  alignas(64) std::atomic<size_t> dequeue_pos_;
+};
+
+} // namespace focus
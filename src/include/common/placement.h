@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// placement.h
+//
+// Identification: src/include/common/placement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace focus {
+
+/** @brief Which NUMA nodes back an allocation. */
+enum class NumaPolicy {
+  /** @brief The kernel default: the node of the thread that touches a page. */
+  DEFAULT,
+  /** @brief Every page on one node. */
+  BIND,
+  /** @brief Pages spread round-robin over every node. */
+  INTERLEAVE,
+  /**
+   * @brief The default node policy, with every page faulted in up front by a
+   * `parallel_for` over the thread pool. Each page lands on the node of
+   * whichever worker touched it, which says nothing about the thread that
+   * later uses it.
+   */
+  PARALLEL_PREFAULT
+};
+
+/** @brief Which page size backs an allocation. */
+enum class HugePagePolicy {
+  /** @brief Base pages only. */
+  NONE,
+  /** @brief Base pages with transparent huge pages advised. */
+  TRANSPARENT,
+  /**
+   * @brief Reserved 2 MB pages, falling back to `TRANSPARENT` when none are
+   * available.
+   */
+  EXPLICIT
+};
+
+struct PlacementOptions {
+  /** @brief Node policy. */
+  NumaPolicy numa_ = NumaPolicy::DEFAULT;
+
+  /** @brief Target node of `NumaPolicy::BIND`. */
+  size_t node_ = 0;
+
+  /** @brief Page-size policy. */
+  HugePagePolicy huge_pages_ = HugePagePolicy::NONE;
+
+  /** @brief Smallest allocation, in bytes, the page-size policy applies to. */
+  size_t huge_page_threshold_ = size_t(2) << 20;
+};
+
+/** @brief Where the bytes of one or more allocations currently live. */
+struct PlacementReport {
+  /** @brief Resident bytes on each node, indexed by node id. */
+  std::vector<size_t> node_bytes_;
+
+  /** @brief Bytes not faulted in yet. */
+  size_t unresident_bytes_ = 0;
+
+  /** @brief Bytes whose node could not be queried. */
+  size_t unknown_bytes_ = 0;
+
+  /** @brief Bytes backed by reserved huge pages. */
+  size_t huge_page_bytes_ = 0;
+
+  /**
+   * @brief Returns one line per node plus the unresident, unknown and huge
+   * page totals.
+   *
+   * @return std::string
+   */
+  std::string to_string() const;
+};
+
+/**
+ * @brief Returns the number of NUMA nodes on this host, at least 1.
+ *
+ * @return size_t
+ */
+size_t numa_node_count();
+
+/**
+ * @brief Maps `bytes` bytes placed according to `options`.
+ *
+ * The memory is zeroed, or copied from `init` when it is not `nullptr`. With
+ * `NumaPolicy::PARALLEL_PREFAULT` the fill is split with `parallel_for`, which
+ * faults pages in from several threads at once but does not choose their
+ * nodes. Node policies are best effort: hosts or sandboxes that refuse
+ * `mbind` keep the default policy. Allocations are rounded up to whole pages,
+ * so this is meant for large buffers.
+ *
+ * @param bytes The size in bytes.
+ * @param options The placement policies.
+ * @param init Optional `bytes` bytes to copy in, may be `nullptr`.
+ * @return void*
+ */
+void *placed_alloc(size_t bytes, const PlacementOptions &options,
+                   const void *init = nullptr);
+
+/**
+ * @brief Unmaps memory returned by `placed_alloc`.
+ *
+ * @param ptr The allocation, may be `nullptr`.
+ */
+void placed_free(void *ptr);
+
+/**
+ * @brief Makes memory returned by `placed_alloc` read-only.
+ *
+ * @param ptr The allocation.
+ */
+void placed_protect(void *ptr);
+
+/**
+ * @brief Reports where the pages of `[data, data + bytes)` live.
+ *
+ * @param data The first byte.
+ * @param bytes The size in bytes.
+ * @return PlacementReport
+ */
+PlacementReport placement_report(const void *data, size_t bytes);
+
+/**
+ * @brief Reports where the pages of every live `placed_alloc` allocation
+ * live.
+ *
+ * @return PlacementReport
+ */
+PlacementReport placement_report();
+
+} // namespace focus
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// thread_pool.h
+//
+// Identification: src/include/common/thread_pool.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace focus {
+
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Returns the process-wide pool used by the kernels.
+   *
+   * Sized from the `FOCUS_NUM_THREADS` environment variable when set, and from
+   * the hardware concurrency otherwise.
+   *
+   * @return ThreadPool&
+   */
+  static ThreadPool &global();
+
+  /** @brief Returns the number of worker threads. */
+  size_t num_threads() const { return workers_.size(); }
+
+  /**
+   * @brief Queues input `task` to run on a worker thread.
+   *
+   * @param task The task to run.
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Splits `[begin, end)` into at most `num_threads()` contiguous
+   * ranges and runs `fn(range_begin, range_end)` on each in parallel.
+   *
+   * The calling thread runs one of the ranges itself and returns once all of
+   * them are done. The first exception thrown by `fn` is rethrown. Calls made
+   * from inside a worker run serially so nested parallelism cannot deadlock.
+   *
+   * @param begin First index.
+   * @param end One past the last index.
+   * @param fn The function to run on each range.
+   */
+  void parallel_for(size_t begin, size_t end,
+                    const std::function<void(size_t, size_t)> &fn);
+
+private:
+  void run();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_;
+};
+
+/**
+ * @brief Runs `fn` over `[begin, end)` on the global thread pool.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param fn The function to run on each range.
+ */
+void parallel_for(size_t begin, size_t end,
+                  const std::function<void(size_t, size_t)> &fn);
+
+} // namespace focus
@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// workspace.h
+//
+// Identification: src/include/common/workspace.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace focus {
+
+/**
+ * @brief A per-thread bump allocator for kernel scratch space.
+ *
+ * Allocations are released in stack order through `WorkspaceScope`. When a
+ * request does not fit, another block is added, and once every scope has
+ * closed the blocks are merged into one block as large as the high-water
+ * mark. After warm-up, kernels therefore allocate nothing for scratch on the
+ * hot path.
+ */
+class Workspace {
+public:
+  /** @brief Position to roll back to, taken by `mark`. */
+  struct Mark {
+    size_t block_;
+    size_t offset_;
+  };
+
+  Workspace();
+  ~Workspace();
+
+  Workspace(const Workspace &) = delete;
+  Workspace &operator=(const Workspace &) = delete;
+
+  /**
+   * @brief Returns the workspace of the calling thread.
+   *
+   * @return Workspace&
+   */
+  static Workspace &local();
+
+  /**
+   * @brief Returns `bytes` uninitialized bytes, aligned to 64 bytes.
+   *
+   * The memory stays valid until the enclosing `WorkspaceScope` closes.
+   *
+   * @param bytes The size in bytes.
+   * @return void*
+   */
+  void *allocate(size_t bytes);
+
+  /**
+   * @brief Returns `count` uninitialized elements of type `T`.
+   *
+   * @param count Number of elements.
+   * @return T*
+   */
+  template <typename T> T *alloc(size_t count) {
+    return static_cast<T *>(allocate(count * sizeof(T)));
+  }
+
+  /** @brief Returns the current position. */
+  Mark mark() const;
+
+  /**
+   * @brief Releases everything allocated since `mark` was taken.
+   *
+   * @param mark A position returned by `mark`.
+   */
+  void release(const Mark &mark);
+
+  /** @brief Returns the bytes currently allocated. */
+  size_t used() const { return used_; }
+
+  /** @brief Returns the most bytes ever allocated at once. */
+  size_t high_water() const { return high_water_; }
+
+  /** @brief Returns the bytes reserved across all blocks. */
+  size_t capacity() const;
+
+  /** @brief Returns the number of blocks; 1 once the size has settled. */
+  size_t num_blocks() const { return blocks_.size(); }
+
+private:
+  struct Block {
+    char *data_;
+    size_t size_;
+    size_t offset_;
+  };
+
+  std::vector<Block> blocks_;
+  size_t current_;
+  size_t used_;
+  size_t high_water_;
+};
+
+/**
+ * @brief Releases every workspace allocation made during its lifetime.
+ */
+class WorkspaceScope {
+public:
+  /**
+   * @param workspace The workspace to scope, by default the calling thread's.
+   */
+  explicit WorkspaceScope(Workspace &workspace = Workspace::local())
+      : workspace_(workspace), mark_(workspace.mark()) {}
+
+  ~WorkspaceScope() { workspace_.release(mark_); }
+
+  WorkspaceScope(const WorkspaceScope &) = delete;
+  WorkspaceScope &operator=(const WorkspaceScope &) = delete;
+
+  /**
+   * @brief Returns `count` uninitialized elements of type `T` from the
+   * scoped workspace.
+   *
+   * @param count Number of elements.
+   * @return T*
+   */
+  template <typename T> T *alloc(size_t count) {
+    return workspace_.alloc<T>(count);
+  }
+
+private:
+  Workspace &workspace_;
+  Workspace::Mark mark_;
+};
+
+} // namespace focus
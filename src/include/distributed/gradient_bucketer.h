@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// gradient_bucketer.h
+//
+// Identification: src/include/distributed/gradient_bucketer.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "distributed/process_group.h"
+#include "type/float_tensor.h"
+
+namespace focus {
+
+struct GradientBucketerOptions {
+  /** @brief Largest bucket in floats; a larger gradient gets its own bucket. */
+  size_t bucket_numel_ = 1 << 18;
+
+  /** @brief Divide the summed gradients by the world size. */
+  bool average_ = true;
+
+  /** @brief The all-reduce schedule used for every bucket. */
+  AllReduceAlgorithm algorithm_ = AllReduceAlgorithm::RING;
+};
+
+/**
+ * @brief Overlaps gradient all-reduce with the backward pass.
+ *
+ * Parameters are packed into buckets in reverse order, the order backward
+ * produces their gradients. Once every gradient in a bucket is marked ready,
+ * a background thread flattens the bucket into one message, all-reduces it and
+ * writes the result back, while backward keeps running on the caller's thread.
+ * Buckets are always reduced in the same order so every rank issues the same
+ * sequence of collectives. The process group must not be used by anyone else
+ * between the first `mark_ready` and `wait`. Destroying the bucketer while a
+ * bucket is still unreduced aborts the group, on every rank, rather than
+ * waiting for collectives that may never complete.
+ */
+class GradientBucketer {
+public:
+  /**
+   * @param group The group to reduce across.
+   * @param params The parameters in forward order; all must require grad.
+   * @param options Bucketing options.
+   */
+  GradientBucketer(ProcessGroup &group, std::vector<FloatTensor *> params,
+                   GradientBucketerOptions options = GradientBucketerOptions());
+  ~GradientBucketer();
+
+  GradientBucketer(const GradientBucketer &) = delete;
+  GradientBucketer &operator=(const GradientBucketer &) = delete;
+
+  /** @brief Returns the number of buckets. */
+  size_t num_buckets() const { return buckets_.size(); }
+
+  /**
+   * @brief Declares that `param.grad_` is final for this step.
+   *
+   * @param param One of the parameters the bucketer was built with.
+   */
+  void mark_ready(FloatTensor &param);
+
+  /**
+   * @brief Returns `true` once every bucket of the current step has been
+   * reduced, without blocking.
+   *
+   * @return bool
+   */
+  bool finished() const;
+
+  /**
+   * @brief Blocks until every bucket has been reduced, then resets for the
+   * next step. Rethrows the first communication error.
+   */
+  void wait();
+
+private:
+  struct Bucket {
+    std::vector<FloatTensor *> params_;
+    std::vector<float> flat_;
+    size_t pending_;
+  };
+
+  void run();
+  void reduce(Bucket &bucket);
+
+  ProcessGroup &group_;
+  GradientBucketerOptions options_;
+  std::vector<Bucket> buckets_;
+  std::map<FloatTensor *, size_t> bucket_of_;
+  std::vector<bool> marked_;
+  std::map<FloatTensor *, size_t> param_index_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t launched_;
+  size_t completed_;
+  bool stopping_;
+  std::exception_ptr error_;
+  std::thread worker_;
+};
+
+} // namespace focus
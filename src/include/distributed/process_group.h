@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// process_group.h
+//
+// Identification: src/include/distributed/process_group.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ipc/shared_memory.h"
+#include "type/float_tensor.h"
+
+namespace focus {
+
+enum class AllReduceAlgorithm {
+  /** @brief Bandwidth-optimal; each rank moves `2 (W - 1) / W` of the data. */
+  RING,
+  /** @brief Latency-optimal for small messages; `log2(W)` reduction steps. */
+  TREE
+};
+
+/**
+ * @brief Collective communication between the processes of one host.
+ *
+ * Every rank maps one shared memory segment holding a staging buffer per rank
+ * and a barrier. Collectives stage data through the buffers in pieces of
+ * `buffer_numel` floats, so tensors of any size can be reduced. Every rank
+ * must issue the same collectives in the same order. A group is used from one
+ * thread at a time, except for `abort`.
+ */
+class ProcessGroup {
+public:
+  /**
+   * @brief Joins the group `name` as `rank` of `world_size`.
+   *
+   * Rank 0 creates the segment and stamps it with `session`; the others wait
+   * for a segment carrying the same stamp, so a segment left behind by an
+   * earlier run under the same name is never joined. Returns once every rank
+   * has joined.
+   *
+   * @param name The segment name shared by all ranks.
+   * @param session An id the launcher gives every rank of this run.
+   * @param rank This process's rank, in `[0, world_size)`.
+   * @param world_size Number of processes.
+   * @param buffer_numel Staging buffer size per rank, in floats.
+   */
+  ProcessGroup(const std::string &name, uint64_t session, size_t rank,
+               size_t world_size, size_t buffer_numel = 1 << 20);
+  ~ProcessGroup();
+
+  ProcessGroup(const ProcessGroup &) = delete;
+  ProcessGroup &operator=(const ProcessGroup &) = delete;
+
+  /** @brief Returns this process's rank. */
+  size_t rank() const { return rank_; }
+
+  /** @brief Returns the number of processes. */
+  size_t world_size() const { return world_size_; }
+
+  /**
+   * @brief Blocks until every rank has reached the barrier.
+   *
+   * @throws std::runtime_error if the group has been aborted.
+   */
+  void barrier();
+
+  /**
+   * @brief Fails the group on every rank.
+   *
+   * Any collective blocked on this or another rank, and every later one,
+   * throws `std::runtime_error`. Safe to call from any thread; used to tear
+   * down a rank whose peers will never arrive.
+   */
+  void abort();
+
+  /**
+   * @brief Replaces `data` on every rank with the element-wise sum over ranks.
+   *
+   * @param data The values to reduce, `count` floats.
+   * @param count Number of floats.
+   * @param algorithm The reduction schedule.
+   */
+  void all_reduce(float *data, size_t count,
+                  AllReduceAlgorithm algorithm = AllReduceAlgorithm::RING);
+
+  /**
+   * @brief Sums `tensor.grad_` across ranks in place.
+   *
+   * @param tensor The tensor whose gradient to reduce.
+   * @param algorithm The reduction schedule.
+   */
+  void all_reduce_grad(FloatTensor &tensor,
+                       AllReduceAlgorithm algorithm = AllReduceAlgorithm::RING);
+
+  /**
+   * @brief Copies `data` from rank `root` to every other rank.
+   *
+   * @param data The values to send on `root` and to overwrite elsewhere.
+   * @param count Number of floats.
+   * @param root The sending rank.
+   */
+  void broadcast(float *data, size_t count, size_t root);
+
+  /**
+   * @brief Sums `input` across ranks and leaves chunk `rank()` of the result
+   * in `output`.
+   *
+   * @param input `world_size() * count` floats on every rank.
+   * @param output Receives `count` floats.
+   * @param count Number of floats per rank.
+   */
+  void reduce_scatter(const float *input, float *output, size_t count);
+
+private:
+  struct Header;
+
+  Header *header() const;
+  float *buffer(size_t rank) const;
+  void ring_all_reduce(float *data, size_t count);
+  void tree_all_reduce(float *data, size_t count);
+
+  size_t rank_;
+  size_t world_size_;
+  size_t buffer_numel_;
+  std::unique_ptr<SharedMemorySegment> segment_;
+};
+
+} // namespace focus
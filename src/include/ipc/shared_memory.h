@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// shared_memory.h
+//
+// Identification: src/include/ipc/shared_memory.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/** @brief Largest rank of a tensor stored in shared memory. */
+const size_t kSharedMaxDims = 8;
+
+/**
+ * @brief Named POSIX shared memory segment mapped into this process.
+ *
+ * The creating instance owns the name and unlinks it on destruction; mappings
+ * held by other processes stay valid until they are closed.
+ */
+class SharedMemorySegment {
+public:
+  /**
+   * @brief Creates a new segment of input `bytes` bytes, zero-filled.
+   *
+   * @param name The segment name; a leading `/` is added if missing.
+   * @param bytes The segment size.
+   */
+  SharedMemorySegment(const std::string &name, size_t bytes);
+
+  /**
+   * @brief Maps an existing segment in full.
+   *
+   * @param name The segment name; a leading `/` is added if missing.
+   */
+  explicit SharedMemorySegment(const std::string &name);
+
+  ~SharedMemorySegment();
+
+  SharedMemorySegment(const SharedMemorySegment &) = delete;
+  SharedMemorySegment &operator=(const SharedMemorySegment &) = delete;
+
+  /** @brief Returns the first mapped byte. */
+  void *data() const { return data_; }
+
+  /** @brief Returns the mapped size in bytes. */
+  size_t size() const { return size_; }
+
+  /** @brief Returns the segment name. */
+  const std::string &name() const { return name_; }
+
+private:
+  std::string name_;
+  void *data_;
+  size_t size_;
+  bool owner_;
+};
+
+/**
+ * @brief Process-independent reference to a tensor in a `SharedTensorArena`.
+ *
+ * Plain data, so it can be sent through pipes, sockets or a
+ * `SharedTensorRing`.
+ */
+struct SharedTensorHandle {
+  /** @brief Byte offset of the tensor record within the arena segment. */
+  uint64_t offset_;
+};
+
+/**
+ * @brief Bump allocator for tensors in a shared memory segment.
+ *
+ * One process creates the arena and allocates tensors, e.g. model weights;
+ * others attach by name and wrap the same storage in zero-copy
+ * `FloatTensor`s. Shapes live in the segment too, so the wrapping tensors
+ * borrow nothing from the creating process.
+ */
+class SharedTensorArena {
+public:
+  /**
+   * @brief Creates an arena holding up to input `bytes` bytes of tensors.
+   *
+   * @param name The segment name.
+   * @param bytes The usable capacity.
+   */
+  SharedTensorArena(const std::string &name, size_t bytes);
+
+  /**
+   * @brief Attaches to an existing arena.
+   *
+   * @param name The segment name.
+   */
+  explicit SharedTensorArena(const std::string &name);
+
+  /**
+   * @brief Allocates a zero-filled tensor of the given shape.
+   *
+   * Safe to call from several processes at once.
+   *
+   * @param size The extent of every dimension.
+   * @param ndim Number of dimensions, at most `kSharedMaxDims`.
+   * @return SharedTensorHandle
+   */
+  SharedTensorHandle allocate(const size_t *size, size_t ndim);
+
+  /** @brief Returns the elements of the tensor behind input `handle`. */
+  float *data(SharedTensorHandle handle) const;
+
+  /** @brief Returns the shape of the tensor behind input `handle`. */
+  size_t *size(SharedTensorHandle handle) const;
+
+  /** @brief Returns the rank of the tensor behind input `handle`. */
+  size_t ndim(SharedTensorHandle handle) const;
+
+  /** @brief Returns the underlying segment. */
+  const SharedMemorySegment &segment() const { return segment_; }
+
+private:
+  struct Header;
+  struct Record;
+
+  Header *header() const;
+  Record *record(SharedTensorHandle handle) const;
+
+  SharedMemorySegment segment_;
+};
+
+} // namespace focus
@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// shared_tensor_ring.h
+//
+// Identification: src/include/ipc/shared_tensor_ring.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ipc/shared_memory.h"
+
+namespace focus {
+
+/**
+ * @brief A claimed slot of a `SharedTensorRing`.
+ *
+ * `data_` and `size_` point into shared memory. Writers fill in `*ndim_`,
+ * `size_` and `data_`; readers wrap them in a `FloatTensor` without copying.
+ */
+struct SharedTensorSlot {
+  /** @brief Ring position, used to commit or release the slot. */
+  uint64_t position_;
+
+  /** @brief Element storage, `capacity_` floats. */
+  float *data_;
+
+  /** @brief Shape storage, `kSharedMaxDims` entries. */
+  size_t *size_;
+
+  /** @brief Rank. */
+  size_t *ndim_;
+
+  /** @brief Number of floats the slot can hold. */
+  size_t capacity_;
+};
+
+/**
+ * @brief Lock-free multi-producer multi-consumer ring of tensor slots in
+ * shared memory.
+ *
+ * Producers claim a free slot, write a tensor into it in place and commit it;
+ * consumers claim a committed slot, use the tensor in place and release it.
+ * Each slot carries a sequence number that says which of those states it is
+ * in, so no process ever takes a lock. A peer that dies between claiming and
+ * committing or releasing a slot leaves that slot's sequence number stuck,
+ * and every producer or consumer that reaches the slot afterwards blocks;
+ * the ring must then be recreated.
+ */
+class SharedTensorRing {
+public:
+  /**
+   * @brief Creates a ring of `num_slots` slots of `slot_numel` floats each.
+   *
+   * @param name The segment name.
+   * @param num_slots Number of slots, rounded up to a power of two.
+   * @param slot_numel Largest tensor a slot can hold.
+   */
+  SharedTensorRing(const std::string &name, size_t num_slots,
+                   size_t slot_numel);
+
+  /**
+   * @brief Attaches to an existing ring.
+   *
+   * @param name The segment name.
+   */
+  explicit SharedTensorRing(const std::string &name);
+
+  /**
+   * @brief Claims a free slot for writing.
+   *
+   * @param slot Receives the slot.
+   * @return `false` if every slot is in use, `true` otherwise.
+   */
+  bool try_acquire_write(SharedTensorSlot &slot);
+
+  /**
+   * @brief Publishes a slot claimed with `try_acquire_write`.
+   *
+   * @param slot The slot to publish.
+   */
+  void commit(const SharedTensorSlot &slot);
+
+  /**
+   * @brief Claims the oldest published slot for reading.
+   *
+   * @param slot Receives the slot.
+   * @return `false` if no slot is published, `true` otherwise.
+   */
+  bool try_acquire_read(SharedTensorSlot &slot);
+
+  /**
+   * @brief Returns a slot claimed with `try_acquire_read` to the producers.
+   *
+   * @param slot The slot to release.
+   */
+  void release(const SharedTensorSlot &slot);
+
+  /** @brief Returns the number of slots. */
+  size_t num_slots() const;
+
+  /** @brief Returns the number of floats each slot can hold. */
+  size_t slot_numel() const;
+
+private:
+  struct Header;
+  struct SlotHeader;
+
+  Header *header() const;
+  SlotHeader *slot_header(uint64_t position) const;
+  void fill_slot(uint64_t position, SharedTensorSlot &slot) const;
+
+  SharedMemorySegment segment_;
+};
+
+} // namespace focus
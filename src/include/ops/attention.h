@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// attention.h
+//
+// Identification: src/include/ops/attention.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+struct AttentionParams {
+  /** @brief Mask keys after each query's position. */
+  bool causal_ = false;
+
+  /** @brief Multiplier applied to the scores; 0 means `1 / sqrt(D)`. */
+  float scale_ = 0;
+};
+
+/**
+ * @brief Computes `softmax(Q K^T * scale) V` without materializing the
+ * score matrix.
+ *
+ * `query` is `[B, H, Lq, D]`, `key` is `[B, H, Lk, D]`, `value` is
+ * `[B, H, Lk, Dv]` and `output` must already be shaped `[B, H, Lq, Dv]`.
+ * Queries and keys are processed in tiles with a running maximum and sum per
+ * query, so memory is linear in the sequence length. Work is split across the
+ * thread pool over batch, heads and query tiles.
+ *
+ * With `causal_`, query `i` sees keys `j <= i + Lk - Lq`. Queries that see no
+ * key produce zeros.
+ *
+ * @param query The query tensor.
+ * @param key The key tensor.
+ * @param value The value tensor.
+ * @param key_lengths Optional `[B]` count of valid keys per batch entry; keys
+ * past it are padding. May be `nullptr`.
+ * @param output The output tensor.
+ * @param params Masking and scale.
+ */
+void scaled_dot_product_attention(
+    const FloatTensor &query, const FloatTensor &key, const FloatTensor &value,
+    const size_t *key_lengths, FloatTensor &output,
+    const AttentionParams &params = AttentionParams());
+
+} // namespace focus
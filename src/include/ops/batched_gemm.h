@@ -0,0 +1,39 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// batched_gemm.h
+//
+// Identification: src/include/ops/batched_gemm.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Computes `c[i] = a[i] b[i]` for every matrix in a batch of small
+ * matrices.
+ *
+ * `a` is `[B, M, K]`, `b` is `[B, K, N]` and `c` must already be shaped
+ * `[B, M, N]`. Either `a` or `b` may have a batch of 1, in which case that
+ * matrix is shared by the whole batch. The three tensors are addressed in
+ * place by batch stride, so no per-matrix tensors are built.
+ *
+ * Common shapes run on kernels specialized at compile time: up to 8x8 the
+ * matrices are interleaved in groups of 8 so the arithmetic vectorizes across
+ * matrices, and 16x16 and 32x32 use fully unrolled per-matrix kernels. The
+ * batch is split across the thread pool.
+ *
+ * @param a The left matrices.
+ * @param b The right matrices.
+ * @param c The output matrices.
+ */
+void batched_gemm(const FloatTensor &a, const FloatTensor &b, FloatTensor &c);
+
+} // namespace focus
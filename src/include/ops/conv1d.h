@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// conv1d.h
+//
+// Identification: src/include/ops/conv1d.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+struct Conv1dParams {
+  /** @brief Stride. */
+  size_t stride_ = 1;
+
+  /** @brief Implicit zero padding on each side. */
+  size_t pad_ = 0;
+};
+
+/**
+ * @brief Computes a 1-D convolution over an NCL input.
+ *
+ * `input` is `[N, C_in, L]`, `weight` is `[C_out, C_in, K]` and `output` must
+ * already be shaped `[N, C_out, OL]`. At stride 1 with long kernels the op
+ * runs through `fft_conv1d` when the autotuner finds it faster than the
+ * direct loop for the shape.
+ *
+ * @param input The input tensor.
+ * @param weight The filter tensor.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output The output tensor.
+ * @param params Stride and padding.
+ */
+void conv1d(const FloatTensor &input, const FloatTensor &weight,
+            const FloatTensor *bias, FloatTensor &output,
+            const Conv1dParams &params = Conv1dParams());
+
+} // namespace focus
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// conv2d.h
+//
+// Identification: src/include/ops/conv2d.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+struct Conv2dParams {
+  /** @brief Vertical and horizontal stride. */
+  size_t stride_h_ = 1;
+  size_t stride_w_ = 1;
+
+  /** @brief Implicit zero padding on each side. */
+  size_t pad_h_ = 0;
+  size_t pad_w_ = 0;
+
+  /** @brief Number of blocked connections from input to output channels. */
+  size_t groups_ = 1;
+};
+
+/**
+ * @brief Returns the spatial extent of a convolution output.
+ *
+ * @param in Input extent.
+ * @param kernel Kernel extent.
+ * @param stride Stride.
+ * @param pad Zero padding on each side.
+ * @return size_t
+ */
+size_t conv2d_output_size(size_t in, size_t kernel, size_t stride, size_t pad);
+
+/**
+ * @brief Computes a 2-D convolution over an NCHW input.
+ *
+ * `input` is `[N, C_in, H, W]`, `weight` is `[C_out, C_in / groups, KH, KW]`
+ * and `output` must already be shaped `[N, C_out, OH, OW]`. Groups are
+ * addressed in place, so no per-group copies are made. Depthwise layers
+ * (`groups == C_in == C_out`) with 3x3 or 5x5 kernels and stride 1 or 2 run on
+ * specialized kernels. Ungrouped stride-1 layers with 7x7 or larger filters
+ * run through `fft_conv2d` when the autotuner finds it faster for the shape.
+ *
+ * @param input The input tensor.
+ * @param weight The filter tensor.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output The output tensor.
+ * @param params Stride, padding and groups.
+ */
+void conv2d(const FloatTensor &input, const FloatTensor &weight,
+            const FloatTensor *bias, FloatTensor &output,
+            const Conv2dParams &params = Conv2dParams());
+
+/**
+ * @brief Accumulates the gradient with respect to the input of `conv2d`.
+ *
+ * Reads `output.grad_` and adds the transposed convolution of it with
+ * `weight` into `input.grad_`.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param weight The filter tensor.
+ * @param input The forward input, receiving the gradient.
+ * @param params Stride, padding and groups.
+ */
+void conv2d_backward_data(const FloatTensor &output, const FloatTensor &weight,
+                          FloatTensor &input,
+                          const Conv2dParams &params = Conv2dParams());
+
+/**
+ * @brief Accumulates the gradients with respect to the filter and bias of
+ * `conv2d`.
+ *
+ * The batch is split across the thread pool. Each worker accumulates into its
+ * own partial filter and bias buffers, which are summed into `weight.grad_`
+ * and `bias->grad_` at the end, so no atomics are needed.
+ *
+ * @param input The forward input.
+ * @param output The forward output, holding the incoming gradient.
+ * @param weight The filter tensor, receiving the gradient.
+ * @param bias Optional bias tensor receiving the gradient, may be `nullptr`.
+ * @param params Stride, padding and groups.
+ */
+void conv2d_backward_weight(const FloatTensor &input, const FloatTensor &output,
+                            FloatTensor &weight, FloatTensor *bias,
+                            const Conv2dParams &params = Conv2dParams());
+
+/**
+ * @brief Computes a 2-D transposed convolution over an NCHW input.
+ *
+ * `input` is `[N, C_in, H, W]`, `weight` is `[C_in, C_out / groups, KH, KW]`
+ * and `output` must already be shaped `[N, C_out, OH, OW]` such that a
+ * `conv2d` with the same parameters maps `OH x OW` back to `H x W`. Extra rows
+ * and columns allowed by that rule play the role of output padding.
+ *
+ * @param input The input tensor.
+ * @param weight The filter tensor.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output The output tensor.
+ * @param params Stride, padding and groups.
+ */
+void conv_transpose2d(const FloatTensor &input, const FloatTensor &weight,
+                      const FloatTensor *bias, FloatTensor &output,
+                      const Conv2dParams &params = Conv2dParams());
+
+} // namespace focus
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// embedding.h
+//
+// Identification: src/include/ops/embedding.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+enum class EmbeddingBagMode { SUM, MEAN };
+
+/**
+ * @brief Copies rows `indices[i]` of `table` into row `i` of `out`.
+ *
+ * `table` is `[R, ...]` and `out` must hold `num_indices` rows of the same
+ * width.
+ *
+ * @param table The tensor to read rows from.
+ * @param indices The row numbers to select.
+ * @param num_indices Number of entries in `indices`.
+ * @param out The tensor to overwrite.
+ */
+void index_select(const FloatTensor &table, const size_t *indices,
+                  size_t num_indices, FloatTensor &out);
+
+/**
+ * @brief Adds row `i` of `src` into row `indices[i]` of `table`.
+ *
+ * Repeated indices accumulate. The indices are sorted once so each
+ * destination row is owned by a single thread, which lets the update run in
+ * parallel without atomics.
+ *
+ * This method will perform addition as an in-place operation on `table`.
+ *
+ * @param table The tensor to add into.
+ * @param indices The destination row numbers.
+ * @param num_indices Number of entries in `indices`.
+ * @param src The rows to add, `num_indices` rows of the same width.
+ */
+void index_add_(FloatTensor &table, const size_t *indices, size_t num_indices,
+                const FloatTensor &src);
+
+/**
+ * @brief Gathers along the last dimension: `out[..., j] =
+ * input[..., index[..., j]]`.
+ *
+ * `index` holds `out.numel_` entries and `out` matches `input` in every
+ * dimension but the last.
+ *
+ * @param input The tensor to read from.
+ * @param index The positions to read within each row.
+ * @param out The tensor to overwrite.
+ */
+void gather(const FloatTensor &input, const size_t *index, FloatTensor &out);
+
+/**
+ * @brief Scatters along the last dimension: `out[..., index[..., j]] +=
+ * src[..., j]`.
+ *
+ * This method will perform addition as an in-place operation on `out`.
+ *
+ * @param out The tensor to add into.
+ * @param index The positions to write within each row, `src.numel_` entries.
+ * @param src The values to add.
+ */
+void scatter_add_(FloatTensor &out, const size_t *index,
+                  const FloatTensor &src);
+
+/**
+ * @brief Pools variable-length bags of `table` rows.
+ *
+ * Bag `b` covers `indices[offsets[b]]` up to `indices[offsets[b + 1]]` (or
+ * `num_indices` for the last bag). Rows are summed or averaged into row `b`
+ * of `out`, which must be `[num_bags, D]`. Bags are spread over the thread
+ * pool and upcoming rows are prefetched while the current one is added.
+ *
+ * @param table The `[R, D]` embedding table.
+ * @param indices The row numbers of every bag, back to back.
+ * @param num_indices Number of entries in `indices`.
+ * @param offsets Start of every bag within `indices`.
+ * @param num_bags Number of entries in `offsets`.
+ * @param mode How rows within a bag are pooled.
+ * @param out The tensor to overwrite.
+ */
+void embedding_bag(const FloatTensor &table, const size_t *indices,
+                   size_t num_indices, const size_t *offsets, size_t num_bags,
+                   EmbeddingBagMode mode, FloatTensor &out);
+
+/**
+ * @brief Accumulates the gradient of `embedding_bag` into `table.grad_`.
+ *
+ * Reads `out.grad_`. Uses the same sorted-index segmentation as `index_add_`,
+ * so rows shared by many bags are updated without conflicts.
+ *
+ * @param out The forward output, holding the incoming gradient.
+ * @param indices The row numbers of every bag, back to back.
+ * @param num_indices Number of entries in `indices`.
+ * @param offsets Start of every bag within `indices`.
+ * @param num_bags Number of entries in `offsets`.
+ * @param mode How rows within a bag were pooled.
+ * @param table The `[R, D]` embedding table, receiving the gradient.
+ */
+void embedding_bag_backward(const FloatTensor &out, const size_t *indices,
+                            size_t num_indices, const size_t *offsets,
+                            size_t num_bags, EmbeddingBagMode mode,
+                            FloatTensor &table);
+
+} // namespace focus
@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// fft.h
+//
+// Identification: src/include/ops/fft.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace focus {
+
+using Complex = std::complex<float>;
+
+/**
+ * @brief A complex discrete Fourier transform of one length.
+ *
+ * The length is factored into radix-4, 2, 3 and 5 passes, with a generic
+ * pass for any other prime, and the twiddle factors are computed once per
+ * plan. Plans are immutable, so one plan may be shared by many threads.
+ */
+class FftPlan {
+public:
+  /**
+   * @param n The transform length, at least 1.
+   */
+  explicit FftPlan(size_t n);
+
+  /**
+   * @brief Returns the shared plan for length `n`, building it on first use.
+   *
+   * @param n The transform length.
+   * @return std::shared_ptr<const FftPlan>
+   */
+  static std::shared_ptr<const FftPlan> cached(size_t n);
+
+  /**
+   * @brief Returns the smallest length `>= n` whose only prime factors are 2,
+   * 3 and 5, the lengths the specialized passes cover.
+   *
+   * @param n The minimum length.
+   * @return size_t
+   */
+  static size_t good_size(size_t n);
+
+  /** @brief Returns the transform length. */
+  size_t size() const { return n_; }
+
+  /**
+   * @brief Computes `out[k] = sum_j in[j] exp(-2 pi i j k / n)`.
+   *
+   * @param in `n` input values.
+   * @param out Receives `n` values; must not alias `in`.
+   */
+  void forward(const Complex *in, Complex *out) const;
+
+  /**
+   * @brief Computes the inverse transform, including the `1 / n` scale.
+   *
+   * @param in `n` input values.
+   * @param out Receives `n` values; must not alias `in`.
+   */
+  void inverse(const Complex *in, Complex *out) const;
+
+private:
+  void transform(Complex *out, const Complex *in, size_t stride,
+                 size_t stage) const;
+
+  size_t n_;
+
+  /** @brief Radix and remaining length after each pass. */
+  std::vector<size_t> factors_;
+
+  /** @brief `exp(-2 pi i k / n)` for `k` in `[0, n)`. */
+  std::vector<Complex> twiddles_;
+};
+
+/**
+ * @brief A real-input transform of one even length.
+ *
+ * The real signal is packed into a complex signal of half the length, which is
+ * transformed by an `FftPlan` and then split into the `n / 2 + 1`
+ * non-redundant outputs.
+ */
+class RealFftPlan {
+public:
+  /**
+   * @param n The transform length; must be even.
+   */
+  explicit RealFftPlan(size_t n);
+
+  /**
+   * @brief Returns the shared plan for length `n`, building it on first use.
+   *
+   * @param n The transform length.
+   * @return std::shared_ptr<const RealFftPlan>
+   */
+  static std::shared_ptr<const RealFftPlan> cached(size_t n);
+
+  /** @brief Returns the transform length. */
+  size_t size() const { return n_; }
+
+  /**
+   * @brief Computes the first `n / 2 + 1` outputs of the transform of `in`.
+   *
+   * @param in `n` real input values.
+   * @param out Receives `n / 2 + 1` values.
+   */
+  void forward(const float *in, Complex *out) const;
+
+  /**
+   * @brief Recovers the real signal from its `n / 2 + 1` outputs, including
+   * the `1 / n` scale.
+   *
+   * @param in `n / 2 + 1` values.
+   * @param out Receives `n` real values.
+   */
+  void inverse(const Complex *in, float *out) const;
+
+private:
+  size_t n_;
+  std::shared_ptr<const FftPlan> half_;
+
+  /** @brief `exp(-2 pi i k / n)` for `k` in `[0, n / 2)`. */
+  std::vector<Complex> twiddles_;
+};
+
+} // namespace focus
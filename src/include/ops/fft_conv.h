@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// fft_conv.h
+//
+// Identification: src/include/ops/fft_conv.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "ops/conv1d.h"
+#include "ops/conv2d.h"
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Computes `conv1d` through real FFTs.
+ *
+ * The filter spectra are computed once per call, and the padded input is cut
+ * into overlapping tiles that are transformed, multiplied and transformed
+ * back independently (overlap-save), so long signals need no FFT longer than
+ * a few kernel lengths. Only stride 1 is supported.
+ *
+ * @param input `[N, C_in, L]` input.
+ * @param weight `[C_out, C_in, K]` filter.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output `[N, C_out, OL]` output.
+ * @param params Stride and padding.
+ */
+void fft_conv1d(const FloatTensor &input, const FloatTensor &weight,
+                const FloatTensor *bias, FloatTensor &output,
+                const Conv1dParams &params = Conv1dParams());
+
+/**
+ * @brief Computes `conv2d` through 2-D real FFTs.
+ *
+ * Uses the same overlap-save tiling as `fft_conv1d` over both spatial
+ * dimensions. Only stride 1 and `groups == 1` are supported.
+ *
+ * @param input `[N, C_in, H, W]` input.
+ * @param weight `[C_out, C_in, KH, KW]` filter.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output `[N, C_out, OH, OW]` output.
+ * @param params Stride, padding and groups.
+ */
+void fft_conv2d(const FloatTensor &input, const FloatTensor &weight,
+                const FloatTensor *bias, FloatTensor &output,
+                const Conv2dParams &params = Conv2dParams());
+
+} // namespace focus
@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// loss.h
+//
+// Identification: src/include/ops/loss.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Returns the mean softmax cross-entropy of `logits` against `targets`.
+ *
+ * `logits` is `[N, C]` and `targets` holds `N` class indices. With label
+ * smoothing `eps`, the target distribution is `(1 - eps)` on the target class
+ * plus `eps / C` on every class. Each row is read twice: once for a running
+ * log-sum-exp and once to write the gradient. If `logits.requires_grad_`,
+ * the gradient of the returned loss is added into `logits.grad_` in that
+ * second sweep. Rows are split across the thread pool.
+ *
+ * @param logits The unnormalized scores.
+ * @param targets The class of each row.
+ * @param label_smoothing The smoothing `eps` in `[0, 1]`.
+ * @return float
+ */
+float softmax_cross_entropy(FloatTensor &logits, const size_t *targets,
+                            float label_smoothing = 0);
+
+/**
+ * @brief Returns the mean squared error between `input` and `target`.
+ *
+ * If `input.requires_grad_`, the gradient of the returned loss is added into
+ * `input.grad_` in the same pass.
+ *
+ * @param input The predictions.
+ * @param target The expected values, shaped like `input`.
+ * @return float
+ */
+float mse_loss(FloatTensor &input, const FloatTensor &target);
+
+/**
+ * @brief Returns the mean binary cross-entropy of `sigmoid(logits)` against
+ * `target`.
+ *
+ * Computed directly on the logits as `max(x, 0) - x y + log(1 + exp(-|x|))`,
+ * which cannot overflow. If `logits.requires_grad_`, the gradient of the
+ * returned loss is added into `logits.grad_` in the same pass.
+ *
+ * @param logits The unnormalized scores.
+ * @param target The probabilities in `[0, 1]`, shaped like `logits`.
+ * @return float
+ */
+float binary_cross_entropy_with_logits(FloatTensor &logits,
+                                       const FloatTensor &target);
+
+} // namespace focus
@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// normalization.h
+//
+// Identification: src/include/ops/normalization.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+struct BatchNormParams {
+  /** @brief Added to the variance before taking the square root. */
+  float eps_ = 1e-5f;
+
+  /** @brief Weight of the batch statistics in the running averages. */
+  float momentum_ = 0.1f;
+
+  /** @brief Normalize with batch statistics rather than running ones. */
+  bool training_ = true;
+};
+
+/**
+ * @brief Normalizes every channel of `[N, C, ...]` input over the batch and
+ * spatial positions.
+ *
+ * In training the per-channel mean and variance are computed in one
+ * Welford pass, and the running averages are updated when given (the running
+ * variance is unbiased). Otherwise the running statistics are used. The
+ * normalization and affine transform are then applied in one pass over the
+ * input. Statistics are split across the thread pool by channel and the
+ * output pass by `(n, c)` plane.
+ *
+ * @param input The input tensor.
+ * @param weight Optional `[C]` scale, may be `nullptr`.
+ * @param bias Optional `[C]` shift, may be `nullptr`.
+ * @param running_mean Optional `[C]` running mean, may be `nullptr` in
+ * training.
+ * @param running_var Optional `[C]` running variance, may be `nullptr` in
+ * training.
+ * @param save_mean Optional, receives the `C` means used, for the backward.
+ * @param save_invstd Optional, receives the `C` inverse standard deviations
+ * used, for the backward.
+ * @param output The output tensor, shaped like `input`.
+ * @param params Epsilon, momentum and mode.
+ */
+void batch_norm(const FloatTensor &input, const FloatTensor *weight,
+                const FloatTensor *bias, FloatTensor *running_mean,
+                FloatTensor *running_var, float *save_mean,
+                float *save_invstd, FloatTensor &output,
+                const BatchNormParams &params = BatchNormParams());
+
+/**
+ * @brief Accumulates the gradients of a training-mode `batch_norm`.
+ *
+ * Reads `output.grad_` and adds into `input.grad_`, and into `weight->grad_`
+ * and `bias->grad_` when given.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param save_mean The means saved by the forward.
+ * @param save_invstd The inverse standard deviations saved by the forward.
+ * @param input The forward input, receiving the gradient.
+ * @param weight Optional scale receiving the gradient, may be `nullptr`.
+ * @param bias Optional shift receiving the gradient, may be `nullptr`.
+ */
+void batch_norm_backward(const FloatTensor &output, const float *save_mean,
+                         const float *save_invstd, FloatTensor &input,
+                         FloatTensor *weight, FloatTensor *bias);
+
+/**
+ * @brief Normalizes every row of `input` over its last dimension.
+ *
+ * Each row's mean and variance are computed in one Welford pass and the
+ * normalization and `[D]` affine transform in a second fused pass. Rows are
+ * split across the thread pool.
+ *
+ * @param input The input tensor, `[..., D]`.
+ * @param weight Optional `[D]` scale, may be `nullptr`.
+ * @param bias Optional `[D]` shift, may be `nullptr`.
+ * @param eps Added to the variance before taking the square root.
+ * @param save_mean Optional, receives one mean per row.
+ * @param save_invstd Optional, receives one inverse standard deviation per
+ * row.
+ * @param output The output tensor, shaped like `input`.
+ */
+void layer_norm(const FloatTensor &input, const FloatTensor *weight,
+                const FloatTensor *bias, float eps, float *save_mean,
+                float *save_invstd, FloatTensor &output);
+
+/**
+ * @brief Accumulates the gradients of `layer_norm`.
+ *
+ * Reads `output.grad_` and adds into `input.grad_`, and into `weight->grad_`
+ * and `bias->grad_` when given. The parameter gradients are summed in
+ * per-thread partial buffers and reduced at the end.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param save_mean The means saved by the forward.
+ * @param save_invstd The inverse standard deviations saved by the forward.
+ * @param input The forward input, receiving the gradient.
+ * @param weight Optional scale receiving the gradient, may be `nullptr`.
+ * @param bias Optional shift receiving the gradient, may be `nullptr`.
+ */
+void layer_norm_backward(const FloatTensor &output, const float *save_mean,
+                         const float *save_invstd, FloatTensor &input,
+                         FloatTensor *weight, FloatTensor *bias);
+
+/**
+ * @brief Normalizes `[N, C, ...]` input over groups of `C / groups` channels.
+ *
+ * Each `(n, group)` is a contiguous span, reduced in one Welford pass and
+ * then normalized with the per-channel affine transform in a second fused
+ * pass. Spans are split across the thread pool.
+ *
+ * @param input The input tensor.
+ * @param groups Number of channel groups; must divide `C`.
+ * @param weight Optional `[C]` scale, may be `nullptr`.
+ * @param bias Optional `[C]` shift, may be `nullptr`.
+ * @param eps Added to the variance before taking the square root.
+ * @param save_mean Optional, receives `N * groups` means.
+ * @param save_invstd Optional, receives `N * groups` inverse standard
+ * deviations.
+ * @param output The output tensor, shaped like `input`.
+ */
+void group_norm(const FloatTensor &input, size_t groups,
+                const FloatTensor *weight, const FloatTensor *bias, float eps,
+                float *save_mean, float *save_invstd, FloatTensor &output);
+
+/**
+ * @brief Accumulates the gradients of `group_norm`.
+ *
+ * Reads `output.grad_` and adds into `input.grad_`, and into `weight->grad_`
+ * and `bias->grad_` when given.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param groups Number of channel groups used by the forward.
+ * @param save_mean The means saved by the forward.
+ * @param save_invstd The inverse standard deviations saved by the forward.
+ * @param input The forward input, receiving the gradient.
+ * @param weight Optional scale receiving the gradient, may be `nullptr`.
+ * @param bias Optional shift receiving the gradient, may be `nullptr`.
+ */
+void group_norm_backward(const FloatTensor &output, size_t groups,
+                         const float *save_mean, const float *save_invstd,
+                         FloatTensor &input, FloatTensor *weight,
+                         FloatTensor *bias);
+
+} // namespace focus
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// pooling.h
+//
+// Identification: src/include/ops/pooling.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+struct Pool2dParams {
+  /** @brief Window height and width. */
+  size_t kernel_h_ = 2;
+  size_t kernel_w_ = 2;
+
+  /** @brief Vertical and horizontal stride. */
+  size_t stride_h_ = 2;
+  size_t stride_w_ = 2;
+
+  /** @brief Implicit padding on each side; padded positions are skipped. */
+  size_t pad_h_ = 0;
+  size_t pad_w_ = 0;
+};
+
+/**
+ * @brief Takes the maximum over each window of an NCHW input.
+ *
+ * `input` is `[N, C, H, W]` and `output` must already be shaped
+ * `[N, C, OH, OW]` as given by `conv2d_output_size`. Every kernel tap is
+ * applied to a whole output row at once, so the inner loop runs across
+ * output columns. Planes are split across the thread pool.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ * @param params Window, stride and padding.
+ */
+void max_pool2d(const FloatTensor &input, FloatTensor &output,
+                const Pool2dParams &params = Pool2dParams());
+
+/**
+ * @brief Averages each window of an NCHW input.
+ *
+ * Shaped and parallelized like `max_pool2d`. Padded positions are excluded
+ * from the count each window is divided by.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ * @param params Window, stride and padding.
+ */
+void avg_pool2d(const FloatTensor &input, FloatTensor &output,
+                const Pool2dParams &params = Pool2dParams());
+
+/**
+ * @brief Averages every plane of an NCHW input.
+ *
+ * `input` is `[N, C, H, W]` and `output` must hold `N * C` elements.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ */
+void global_avg_pool2d(const FloatTensor &input, FloatTensor &output);
+
+/**
+ * @brief Takes the maximum of every plane of an NCHW input.
+ *
+ * `input` is `[N, C, H, W]` and `output` must hold `N * C` elements.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ */
+void global_max_pool2d(const FloatTensor &input, FloatTensor &output);
+
+} // namespace focus
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// preprocess.h
+//
+// Identification: src/include/ops/preprocess.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/** @brief Borrowed interleaved (HWC) 8-bit image. */
+struct ImageView {
+  /** @brief First pixel. */
+  const uint8_t *data_;
+
+  /** @brief Extents. */
+  size_t height_;
+  size_t width_;
+  size_t channels_;
+
+  /** @brief Bytes between rows, or 0 for tightly packed rows. */
+  size_t row_stride_ = 0;
+};
+
+enum class CropMode { CENTER, RANDOM };
+
+struct PreprocessParams {
+  /** @brief Crop extents taken from each image, 0 for the whole extent. */
+  size_t crop_h_ = 0;
+  size_t crop_w_ = 0;
+
+  /** @brief Where the crop is taken. */
+  CropMode crop_mode_ = CropMode::CENTER;
+
+  /** @brief Seed for random crops; image `i` uses `seed_ + i`. */
+  uint32_t seed_ = 0;
+
+  /** @brief Factor applied to raw pixel values before normalizing. */
+  float scale_ = 1.0f / 255.0f;
+
+  /** @brief Per-channel mean and standard deviation, empty for 0 and 1. */
+  std::vector<float> mean_;
+  std::vector<float> std_;
+};
+
+/**
+ * @brief Converts a batch of 8-bit HWC images into a normalized NCHW tensor.
+ *
+ * Every image is cropped, bilinearly resized to the spatial extents of
+ * `batch`, converted to float, normalized as
+ * `(pixel * scale - mean[c]) / std[c]` and transposed to CHW in a single pass
+ * that writes straight into `batch`. Output rows are spread over the thread
+ * pool.
+ *
+ * @param images The images, which may differ in size.
+ * @param num_images Number of entries in `images`.
+ * @param params Crop and normalization settings.
+ * @param batch The `[N, C, H, W]` tensor to overwrite.
+ */
+void preprocess_images(const ImageView *images, size_t num_images,
+                       const PreprocessParams &params, FloatTensor &batch);
+
+} // namespace focus
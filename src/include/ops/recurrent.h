@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// recurrent.h
+//
+// Identification: src/include/ops/recurrent.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Runs a single-layer LSTM over a whole sequence.
+ *
+ * `input` is `[T, B, I]`, `w_ih` is `[4H, I]` and `w_hh` is `[4H, H]` with
+ * gates ordered input, forget, cell, output. The input projection of every
+ * timestep is computed up front in one matrix product; each step then runs a
+ * fused kernel that adds the recurrent product and biases, applies the gate
+ * nonlinearities and updates the state. Batch rows are independent and split
+ * across the thread pool.
+ *
+ * @param input The input sequence.
+ * @param w_ih The input-to-hidden weights.
+ * @param w_hh The hidden-to-hidden weights.
+ * @param b_ih Optional `[4H]` input bias, may be `nullptr`.
+ * @param b_hh Optional `[4H]` hidden bias, may be `nullptr`.
+ * @param h `[B, H]` initial hidden state, overwritten with the final one.
+ * @param c `[B, H]` initial cell state, overwritten with the final one.
+ * @param output `[T, B, H]` receives the hidden state of every timestep.
+ */
+void lstm(const FloatTensor &input, const FloatTensor &w_ih,
+          const FloatTensor &w_hh, const FloatTensor *b_ih,
+          const FloatTensor *b_hh, FloatTensor &h, FloatTensor &c,
+          FloatTensor &output);
+
+/**
+ * @brief Runs a single-layer GRU over a whole sequence.
+ *
+ * `input` is `[T, B, I]`, `w_ih` is `[3H, I]` and `w_hh` is `[3H, H]` with
+ * gates ordered reset, update, new. The input projection of every timestep is
+ * computed up front in one matrix product, and each step runs a fused gate
+ * kernel. Batch rows are independent and split across the thread pool.
+ *
+ * @param input The input sequence.
+ * @param w_ih The input-to-hidden weights.
+ * @param w_hh The hidden-to-hidden weights.
+ * @param b_ih Optional `[3H]` input bias, may be `nullptr`.
+ * @param b_hh Optional `[3H]` hidden bias, may be `nullptr`.
+ * @param h `[B, H]` initial hidden state, overwritten with the final one.
+ * @param output `[T, B, H]` receives the hidden state of every timestep.
+ */
+void gru(const FloatTensor &input, const FloatTensor &w_ih,
+         const FloatTensor &w_hh, const FloatTensor *b_ih,
+         const FloatTensor *b_hh, FloatTensor &h, FloatTensor &output);
+
+} // namespace focus
@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// scan.h
+//
+// Identification: src/include/ops/scan.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Writes the inclusive prefix sum of `input` along `dim` into `output`.
+ *
+ * `output` must have the shape of `input` and may alias it. Independent lanes
+ * are split across the thread pool. When there are too few lanes to occupy
+ * it, each long lane is scanned in two passes over blocks: block totals
+ * first, then every block again offset by the totals before it.
+ *
+ * @param input The tensor to scan.
+ * @param dim The dimension to scan along.
+ * @param output The tensor to overwrite.
+ */
+void cumsum(const FloatTensor &input, size_t dim, FloatTensor &output);
+
+/**
+ * @brief Writes the inclusive prefix product of `input` along `dim` into
+ * `output`.
+ *
+ * Parallelized like `cumsum`.
+ *
+ * @param input The tensor to scan.
+ * @param dim The dimension to scan along.
+ * @param output The tensor to overwrite.
+ */
+void cumprod(const FloatTensor &input, size_t dim, FloatTensor &output);
+
+} // namespace focus
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sort.h
+//
+// Identification: src/include/ops/sort.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Sorts `input` along `dim`.
+ *
+ * Equal values keep their original order. Rows of up to 32 elements are
+ * sorted with a branch-free bitonic network; longer rows use `std::sort`,
+ * made stable by breaking ties on the original position. Rows are split
+ * across the thread pool, and a single long row is sorted in parallel chunks
+ * that are then merged pairwise. NaNs are placed after every number, in
+ * their original order, whether sorting ascending or descending.
+ *
+ * @param input The tensor to sort.
+ * @param dim The dimension to sort along.
+ * @param descending Sort largest first.
+ * @param values Receives the sorted values; shaped like `input`.
+ * @param indices Optional, receives the position along `dim` each value came
+ * from, `input.numel_` entries. May be `nullptr`.
+ */
+void sort(const FloatTensor &input, size_t dim, bool descending,
+          FloatTensor &values, size_t *indices);
+
+/**
+ * @brief Writes the positions that would sort `input` along `dim`.
+ *
+ * @param input The tensor to sort.
+ * @param dim The dimension to sort along.
+ * @param descending Sort largest first.
+ * @param indices Receives `input.numel_` positions along `dim`.
+ */
+void argsort(const FloatTensor &input, size_t dim, bool descending,
+             size_t *indices);
+
+/**
+ * @brief Selects the `k` largest or smallest elements along `dim`, in sorted
+ * order.
+ *
+ * Each row is reduced with partial selection rather than a full sort. A long
+ * single row is split into chunks whose local top `k` are selected in
+ * parallel and then merged. NaNs rank after every number, so they are only
+ * selected once the numbers run out, and then come last.
+ *
+ * @param input The tensor to select from.
+ * @param dim The dimension to select along.
+ * @param k Number of elements to keep, at most `input.size_[dim]`.
+ * @param largest Keep the largest elements rather than the smallest.
+ * @param values Receives the selected values; shaped like `input` with
+ * `size_[dim] == k`.
+ * @param indices Optional, receives the positions along `dim` of the selected
+ * values, `values.numel_` entries. May be `nullptr`.
+ */
+void topk(const FloatTensor &input, size_t dim, size_t k, bool largest,
+          FloatTensor &values, size_t *indices);
+
+} // namespace focus
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sparse_ops.h
+//
+// Identification: src/include/ops/sparse_ops.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "type/float_tensor.h"
+#include "type/sparse_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Computes the sparse matrix-vector product `y = a * x`.
+ *
+ * Rows are split across the thread pool in ranges of roughly equal non-zero
+ * count.
+ *
+ * @param a The `[M, K]` sparse matrix.
+ * @param x The `[K]` dense vector.
+ * @param y The `[M]` dense vector to overwrite.
+ */
+void spmv(const CsrTensor &a, const FloatTensor &x, FloatTensor &y);
+
+/**
+ * @brief Computes the sparse-times-dense matrix product `c = a * b`.
+ *
+ * Each non-zero of `a` scales a contiguous row of `b` into a row of `c`, so
+ * the inner loop is a vectorizable AXPY over the `N` columns.
+ *
+ * @param a The `[M, K]` sparse matrix.
+ * @param b The `[K, N]` dense matrix.
+ * @param c The `[M, N]` dense matrix to overwrite.
+ */
+void spmm(const CsrTensor &a, const FloatTensor &b, FloatTensor &c);
+
+/**
+ * @brief Adds `alpha * sparse` to `dense`.
+ *
+ * This method will perform addition as an in-place operation on `dense`.
+ *
+ * @param dense The `[M, N]` tensor to add to.
+ * @param sparse The `[M, N]` sparse matrix to add.
+ * @param alpha The scale applied to `sparse`.
+ */
+void add_sparse_(FloatTensor &dense, const CsrTensor &sparse,
+                 float alpha = 1.0f);
+
+/**
+ * @brief Multiplies every stored entry of `sparse` by the matching element of
+ * `dense`.
+ *
+ * This method will perform multiplication as an in-place operation on
+ * `sparse`, so the sparsity pattern is preserved.
+ *
+ * @param sparse The `[M, N]` sparse matrix to multiply.
+ * @param dense The `[M, N]` tensor to multiply by.
+ */
+void mul_dense_(CsrTensor &sparse, const FloatTensor &dense);
+
+} // namespace focus
@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// stream.h
+//
+// Identification: src/include/runtime/stream.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "type/float_tensor.h"
+
+namespace focus {
+
+class Scheduler;
+
+/**
+ * @brief Handle to an enqueued op.
+ *
+ * Copies share the same op. A default-constructed event is always ready.
+ */
+class Event {
+public:
+  Event() = default;
+
+  /**
+   * @brief Blocks until the op has finished.
+   *
+   * Rethrows the exception thrown by the op, or by an op it depended on.
+   */
+  void wait() const;
+
+  /**
+   * @brief Returns `true` if the op has finished, `false` otherwise.
+   *
+   * @return bool
+   */
+  bool ready() const;
+
+private:
+  friend class Scheduler;
+
+  struct Node {
+    std::function<void()> fn_;
+    size_t remaining_ = 0;
+    bool finished_ = false;
+    std::vector<std::shared_ptr<Node>> successors_;
+    std::exception_ptr error_;
+    std::vector<const void *> buffers_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_ = false;
+  };
+
+  explicit Event(std::shared_ptr<Node> node) : node_(node) {}
+
+  std::shared_ptr<Node> node_;
+};
+
+/**
+ * @brief Runs enqueued ops on a thread pool as soon as their inputs are ready.
+ *
+ * Every op declares the buffers it reads and writes. An op waits for the last
+ * writer of everything it touches, and a writer also waits for every reader
+ * since that write, so conflicting ops keep their enqueue order while
+ * independent ones run concurrently. Buffers are identified by their base
+ * pointer; overlapping views of one allocation are not detected.
+ *
+ * Kernels running inside an op execute their own `parallel_for` serially, so
+ * the pool is spent on inter-op rather than intra-op parallelism.
+ */
+class Scheduler {
+public:
+  explicit Scheduler(ThreadPool &pool = ThreadPool::global());
+  ~Scheduler();
+
+  Scheduler(const Scheduler &) = delete;
+  Scheduler &operator=(const Scheduler &) = delete;
+
+  /**
+   * @brief Enqueues input `fn`, ordered after `after` and after every
+   * conflicting op enqueued before it.
+   *
+   * @param reads Buffers `fn` reads.
+   * @param writes Buffers `fn` writes.
+   * @param after An extra dependency, e.g. the previous op of a stream.
+   * @param fn The op to run.
+   * @return An event that completes when `fn` has run.
+   */
+  Event enqueue(const std::vector<const void *> &reads,
+                const std::vector<const void *> &writes, const Event &after,
+                std::function<void()> fn);
+
+  /**
+   * @brief Blocks until every enqueued op has finished.
+   */
+  void synchronize();
+
+  /**
+   * @brief Returns the number of buffers still tracked for ordering.
+   *
+   * A buffer is forgotten once every op touching it has finished, unless its
+   * last writer failed and must still poison later readers.
+   *
+   * @return size_t
+   */
+  size_t tracked_buffers();
+
+private:
+  typedef std::shared_ptr<Event::Node> NodePtr;
+
+  struct BufferState {
+    NodePtr last_writer_;
+    std::vector<NodePtr> readers_;
+  };
+
+  void add_dependency(const NodePtr &node, const NodePtr &on);
+  void launch(const NodePtr &node);
+  void complete(const NodePtr &node);
+  void forget_buffers(const NodePtr &node);
+
+  ThreadPool &pool_;
+  std::mutex mutex_;
+  std::condition_variable idle_cv_;
+  std::map<const void *, BufferState> buffers_;
+  size_t outstanding_;
+};
+
+/**
+ * @brief In-order queue of ops on a `Scheduler`.
+ *
+ * Ops on one stream run one after another; ops on different streams only wait
+ * for each other when they touch the same buffers. A stream is fed from one
+ * thread at a time.
+ */
+class Stream {
+public:
+  explicit Stream(Scheduler &scheduler);
+
+  /**
+   * @brief Enqueues input `fn`, which reads the data of `reads` and writes the
+   * data of `writes`.
+   *
+   * All tensors are borrowed and must stay alive until the op has finished.
+   *
+   * @param reads Tensors `fn` reads.
+   * @param writes Tensors `fn` writes.
+   * @param fn The op to run.
+   * @return Event
+   */
+  Event enqueue(const std::vector<const FloatTensor *> &reads,
+                const std::vector<FloatTensor *> &writes,
+                std::function<void()> fn);
+
+  /**
+   * @brief Enqueues `self.add_(other)`.
+   *
+   * @return Event
+   */
+  Event add_(FloatTensor &self, FloatTensor &other);
+
+  /**
+   * @brief Enqueues `self.sub_(other)`.
+   *
+   * @return Event
+   */
+  Event sub_(FloatTensor &self, FloatTensor &other);
+
+  /**
+   * @brief Enqueues `self.mul_(value)`.
+   *
+   * @return Event
+   */
+  Event mul_(FloatTensor &self, float value);
+
+  /**
+   * @brief Enqueues `*out = self.sum_()`.
+   *
+   * @return Event
+   */
+  Event sum_(FloatTensor &self, float *out);
+
+  /**
+   * @brief Blocks until every op enqueued on this stream has finished.
+   *
+   * Rethrows the error of a failed op, after which the stream starts a new
+   * chain, so later ops no longer inherit the failure. A buffer the failed op
+   * wrote stays poisoned until `Scheduler::synchronize`.
+   */
+  void synchronize();
+
+private:
+  Scheduler &scheduler_;
+  Event last_;
+};
+
+} // namespace focus
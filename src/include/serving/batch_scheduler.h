@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// batch_scheduler.h
+//
+// Identification: src/include/serving/batch_scheduler.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/mpmc_queue.h"
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Runs one batched forward pass.
+ *
+ * `input` has shape `[n, ...sample shape]` and `output` has shape
+ * `[n, ...output sample shape]`, where `n` is the size of the coalesced batch.
+ */
+using BatchForwardFn = std::function<void(FloatTensor &input,
+                                          FloatTensor &output)>;
+
+struct BatchSchedulerOptions {
+  /** @brief Largest batch handed to the forward function. */
+  size_t max_batch_size_ = 32;
+
+  /** @brief Longest a request may wait for its batch to fill up. */
+  std::chrono::microseconds max_latency_ = std::chrono::microseconds(1000);
+
+  /** @brief Number of requests the submission queue can hold. */
+  size_t queue_capacity_ = 1024;
+};
+
+struct BatchSchedulerStats {
+  /** @brief Number of completed requests. */
+  size_t num_requests_ = 0;
+
+  /** @brief Number of forward passes run. */
+  size_t num_batches_ = 0;
+
+  /** @brief Completed requests per second since the first submission. */
+  double throughput_ = 0;
+
+  /** @brief Queueing latency percentiles in microseconds. */
+  double p50_latency_us_ = 0;
+  double p90_latency_us_ = 0;
+  double p99_latency_us_ = 0;
+};
+
+class BatchScheduler {
+public:
+  BatchScheduler(BatchForwardFn forward, size_t *input_size, size_t input_ndim,
+                 size_t *output_size, size_t output_ndim,
+                 BatchSchedulerOptions options = BatchSchedulerOptions());
+  ~BatchScheduler();
+
+  BatchScheduler(const BatchScheduler &) = delete;
+  BatchScheduler &operator=(const BatchScheduler &) = delete;
+
+  /**
+   * @brief Queues a single sample for the next batched forward pass.
+   *
+   * Both tensors are borrowed and must stay alive until the returned future is
+   * ready. Safe to call from any number of threads.
+   *
+   * @param input The sample to run, shaped like the configured input sample.
+   * @param output Receives the result, shaped like the configured output
+   * sample.
+   * @return A future that becomes ready once `output` has been written.
+   */
+  std::future<void> submit(FloatTensor &input, FloatTensor &output);
+
+  /**
+   * @brief Returns throughput and queueing latency statistics.
+   *
+   * @return BatchSchedulerStats
+   */
+  BatchSchedulerStats stats();
+
+private:
+  struct Request {
+    FloatTensor *input_;
+    FloatTensor *output_;
+    std::promise<void> promise_;
+    std::chrono::steady_clock::time_point enqueue_time_;
+  };
+
+  void run();
+  void wait_for_work(std::chrono::steady_clock::duration timeout);
+  void run_batch(std::vector<Request *> &batch);
+
+  BatchForwardFn forward_;
+  BatchSchedulerOptions options_;
+
+  std::vector<size_t> input_size_;
+  std::vector<size_t> output_size_;
+  size_t input_numel_;
+  size_t output_numel_;
+  std::vector<float> input_buffer_;
+  std::vector<float> output_buffer_;
+
+  MpmcQueue<Request *> queue_;
+  std::atomic<size_t> pending_;
+  std::atomic<bool> sleeping_;
+  std::atomic<bool> stopping_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+
+  std::mutex stats_mutex_;
+  std::vector<double> latencies_us_;
+  size_t latency_cursor_;
+  size_t num_requests_;
+  size_t num_batches_;
+  bool started_;
+  std::chrono::steady_clock::time_point first_enqueue_;
+  std::chrono::steady_clock::time_point last_completion_;
+
+  std::thread worker_;
+};
+
+} // namespace focus
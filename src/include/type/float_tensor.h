@@ -12,14 +12,42 @@
 
 #include <cstddef>
 
+#include "common/placement.h"
+
 namespace focus {
 
 class FloatTensor {
 public:
   FloatTensor(float *data, size_t *size, size_t ndim,
               bool requires_grad = false, bool requires_allocation = false);
+
+  /**
+   * @brief Allocates the data, and the gradient when `requires_grad` is
+   * `true`, with `placed_alloc`.
+   *
+   * The data is copied from input `data`, or zeroed when it is `nullptr`.
+   *
+   * @param data Optional initial values, may be `nullptr`.
+   * @param size The extent of each dimension.
+   * @param ndim Number of dimensions.
+   * @param placement NUMA node and page-size policies.
+   * @param requires_grad `true` to allocate a gradient.
+   */
+  FloatTensor(const float *data, size_t *size, size_t ndim,
+              const PlacementOptions &placement, bool requires_grad = false);
+
   ~FloatTensor();
 
+  /**
+   * @brief Makes the stored data read-only.
+   *
+   * The in-place methods, and every op given the tensor as an output, throw
+   * `std::logic_error` afterwards, and storage from `placed_alloc` is also
+   * write-protected in hardware. Freezing cannot be undone. A frozen tensor
+   * can be read by any number of threads without locks.
+   */
+  void freeze_();
+
   /**
    * @brief Zeros every element in the stored gradient.
    */
@@ -32,7 +60,7 @@ public:
    *
    * @param other The tensor to add by.
    */
-  void add_(FloatTensor &other);
+  void add_(const FloatTensor &other);
 
   /**
    * @brief Adds input `value` to each element of the stored data.
@@ -59,7 +87,7 @@ public:
    *
    * @param other The tensor to subtract by.
    */
-  void sub_(FloatTensor &other);
+  void sub_(const FloatTensor &other);
 
   /**
    * @brief Subtracts input `value` from each element of the stored data.
@@ -120,7 +148,7 @@ public:
    *
    * @return float
    */
-  float sum_();
+  float sum_() const;
 
   /** @brief Input data. */
   float *data_;
@@ -136,6 +164,12 @@ public:
    */
   bool requires_allocation_;
 
+  /** @brief `true` if the storage came from `placed_alloc`. */
+  bool placed_;
+
+  /** @brief `true` once `freeze_` has been called. */
+  bool frozen_;
+
   /** @brief Size. */
   size_t *size_;
 
@@ -146,4 +180,15 @@ public:
   size_t numel_;
 };
 
+/**
+ * @brief Throws `std::logic_error` if `tensor` is frozen.
+ *
+ * Every op calls this on the tensors whose data it overwrites or updates, so
+ * a frozen tensor cannot be passed as an output.
+ *
+ * @param op The caller's name, used in the message.
+ * @param tensor The tensor about to be written.
+ */
+void check_mutable(const char *op, const FloatTensor &tensor);
+
 } // namespace focus
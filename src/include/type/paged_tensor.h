@@ -0,0 +1,227 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// paged_tensor.h
+//
+// Identification: src/include/type/paged_tensor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace focus {
+
+struct PagedTensorOptions {
+  /** @brief Floats per chunk, the unit of eviction and I/O. */
+  size_t chunk_numel_ = 1 << 20;
+
+  /**
+   * @brief Bytes of chunk data kept in memory. At least one chunk is always
+   * allowed.
+   */
+  size_t memory_budget_ = size_t(256) << 20;
+
+  /**
+   * @brief Directory of the scratch file; `TMPDIR`, or `/tmp`, when empty.
+   */
+  std::string scratch_dir_;
+
+  /** @brief Chunks read ahead during sequential iteration. */
+  size_t prefetch_depth_ = 2;
+};
+
+struct PagedTensorStats {
+  /** @brief Chunks read back from the scratch file. */
+  size_t faults_ = 0;
+
+  /** @brief Chunks dropped from memory. */
+  size_t evictions_ = 0;
+
+  /** @brief Dirty chunks written to the scratch file. */
+  size_t writebacks_ = 0;
+
+  /** @brief Chunks loaded by the prefetch thread. */
+  size_t prefetches_ = 0;
+};
+
+/**
+ * @brief A zero-initialized tensor whose data lives in fixed-size chunks,
+ * only some of which are held in memory.
+ *
+ * When the memory budget is full, the least recently used unpinned chunk is
+ * evicted, and it is written to an unlinked scratch file first if it is
+ * dirty. A chunk that is not in memory is read back when it is pinned again.
+ * Chunks that were never written are not stored anywhere. If every chunk in
+ * memory is pinned, the budget is exceeded instead of blocking. Chunk-wise
+ * iteration asks a background thread to read the next chunks ahead, so disk
+ * reads overlap with compute.
+ *
+ * All methods are thread-safe. A pinned chunk must only be written by one
+ * thread at a time.
+ */
+class PagedTensor {
+public:
+  /**
+   * @param size The extent of each dimension.
+   * @param ndim Number of dimensions.
+   * @param options Chunking, budget and scratch options.
+   */
+  PagedTensor(const size_t *size, size_t ndim,
+              PagedTensorOptions options = PagedTensorOptions());
+  ~PagedTensor();
+
+  PagedTensor(const PagedTensor &) = delete;
+  PagedTensor &operator=(const PagedTensor &) = delete;
+
+  /** @brief Returns the number of chunks. */
+  size_t num_chunks() const { return chunks_.size(); }
+
+  /**
+   * @brief Returns the number of floats in chunk `chunk`, which is less than
+   * `chunk_numel_` only for the last chunk.
+   */
+  size_t chunk_size(size_t chunk) const;
+
+  /**
+   * @brief Makes chunk `chunk` resident and keeps it from being evicted until
+   * the matching `unpin`.
+   *
+   * @param chunk The chunk index.
+   * @param write `true` if the caller will modify the chunk.
+   * @return The first float of the chunk.
+   */
+  float *pin(size_t chunk, bool write);
+
+  /**
+   * @brief Releases a pin taken by `pin`.
+   *
+   * @param chunk The chunk index.
+   */
+  void unpin(size_t chunk);
+
+  /**
+   * @brief Asks the background thread to load chunk `chunk`.
+   *
+   * @param chunk The chunk index.
+   */
+  void prefetch(size_t chunk);
+
+  /**
+   * @brief Runs `fn(offset, data, count)` over every chunk in order, where
+   * `offset` is the index of `data[0]` in the tensor. The next chunks are
+   * prefetched while `fn` runs.
+   *
+   * @param write `true` if `fn` modifies the chunks.
+   * @param fn The function to run on each chunk.
+   */
+  void for_each_chunk(bool write,
+                      const std::function<void(size_t, float *, size_t)> &fn);
+
+  /**
+   * @brief Sets every element to input `value`.
+   *
+   * @param value The value to fill with.
+   */
+  void fill_(float value);
+
+  /**
+   * @brief Adds input `value` to each element.
+   *
+   * @param value The value to add by.
+   */
+  void add_(float value);
+
+  /**
+   * @brief Adds input `other`, which must have the same number of elements.
+   *
+   * @param other The tensor to add by.
+   */
+  void add_(PagedTensor &other);
+
+  /**
+   * @brief Multiplies each element by input `value`.
+   *
+   * @param value The value to multiply by.
+   */
+  void mul_(float value);
+
+  /**
+   * @brief Returns the sum of all the elements.
+   *
+   * @return float
+   */
+  float sum_();
+
+  /**
+   * @brief Copies `numel_` floats from `src` into the tensor.
+   *
+   * @param src The source values.
+   */
+  void copy_from(const float *src);
+
+  /**
+   * @brief Copies the tensor into `numel_` floats at `dst`.
+   *
+   * @param dst The destination.
+   */
+  void copy_to(float *dst);
+
+  /** @brief Returns the number of chunks held in memory. */
+  size_t resident_chunks();
+
+  /** @brief Returns the paging counters. */
+  PagedTensorStats stats();
+
+  /** @brief Size. */
+  std::vector<size_t> size_;
+
+  /** @brief Number of dimensions. */
+  size_t ndim_;
+
+  /** @brief Total number of elements. */
+  size_t numel_;
+
+private:
+  enum class ChunkState { ABSENT, LOADING, RESIDENT, WRITING };
+
+  struct Chunk {
+    ChunkState state_ = ChunkState::ABSENT;
+    std::vector<float> data_;
+    size_t pins_ = 0;
+    bool dirty_ = false;
+    bool on_disk_ = false;
+    bool queued_ = false;
+    size_t last_use_ = 0;
+  };
+
+  void load(size_t chunk, std::unique_lock<std::mutex> &lock, bool prefetch);
+  void make_room(size_t loading, std::unique_lock<std::mutex> &lock);
+  void run();
+
+  PagedTensorOptions options_;
+  size_t max_resident_;
+  int fd_;
+  std::vector<Chunk> chunks_;
+  std::vector<std::vector<float>> free_buffers_;
+  size_t in_memory_;
+  size_t clock_;
+  PagedTensorStats stats_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<size_t> prefetch_queue_;
+  bool stopping_;
+  std::thread worker_;
+};
+
+} // namespace focus
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sparse_tensor.h
+//
+// Identification: src/include/type/sparse_tensor.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type/float_tensor.h"
+
+namespace focus {
+
+/**
+ * @brief Sparse matrix in coordinate (COO) format.
+ *
+ * Convenient to build incrementally; convert to `CsrTensor` for compute.
+ */
+class CooTensor {
+public:
+  CooTensor(size_t rows, size_t cols);
+
+  /**
+   * @brief Builds a COO matrix from the non-zero elements of a 2-D tensor.
+   *
+   * @param dense The tensor to compress.
+   */
+  explicit CooTensor(const FloatTensor &dense);
+
+  /**
+   * @brief Appends input `value` at position (`row`, `col`).
+   *
+   * Entries may be appended in any order; duplicates are summed when
+   * converting.
+   *
+   * @param row The row index.
+   * @param col The column index.
+   * @param value The value to store.
+   */
+  void push_back(size_t row, size_t col, float value);
+
+  /**
+   * @brief Writes the matrix into input `dense`, which must be 2-D and of
+   * matching shape.
+   *
+   * @param dense The tensor to overwrite.
+   */
+  void to_dense(FloatTensor &dense) const;
+
+  /** @brief Returns the number of stored entries. */
+  size_t nnz() const { return values_.size(); }
+
+  /** @brief Number of rows. */
+  size_t rows_;
+
+  /** @brief Number of columns. */
+  size_t cols_;
+
+  /** @brief Row index of every stored entry. */
+  std::vector<uint32_t> row_indices_;
+
+  /** @brief Column index of every stored entry. */
+  std::vector<uint32_t> col_indices_;
+
+  /** @brief Value of every stored entry. */
+  std::vector<float> values_;
+};
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) format.
+ *
+ * Row `r` owns entries `[row_ptr_[r], row_ptr_[r + 1])` of `col_indices_` and
+ * `values_`, sorted by column.
+ */
+class CsrTensor {
+public:
+  CsrTensor(size_t rows, size_t cols);
+
+  /**
+   * @brief Builds a CSR matrix from the non-zero elements of a 2-D tensor.
+   *
+   * @param dense The tensor to compress.
+   */
+  explicit CsrTensor(const FloatTensor &dense);
+
+  /**
+   * @brief Builds a CSR matrix from a COO matrix, summing duplicates.
+   *
+   * @param coo The matrix to convert.
+   */
+  explicit CsrTensor(const CooTensor &coo);
+
+  /**
+   * @brief Returns the matrix in COO format.
+   *
+   * @return CooTensor
+   */
+  CooTensor to_coo() const;
+
+  /**
+   * @brief Writes the matrix into input `dense`, which must be 2-D and of
+   * matching shape.
+   *
+   * @param dense The tensor to overwrite.
+   */
+  void to_dense(FloatTensor &dense) const;
+
+  /** @brief Returns the number of stored entries. */
+  size_t nnz() const { return values_.size(); }
+
+  /** @brief Number of rows. */
+  size_t rows_;
+
+  /** @brief Number of columns. */
+  size_t cols_;
+
+  /** @brief Offset of the first entry of every row, plus the total count. */
+  std::vector<size_t> row_ptr_;
+
+  /** @brief Column index of every stored entry. */
+  std::vector<uint32_t> col_indices_;
+
+  /** @brief Value of every stored entry. */
+  std::vector<float> values_;
+};
+
+} // namespace focus
@@ -0,0 +1,202 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// shared_memory.cpp
+//
+// Identification: src/ipc/shared_memory.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ipc/shared_memory.h"
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace focus {
+
+namespace {
+
+const uint64_t kArenaMagic = 0x464f435553415231ULL; // "FOCUSAR1"
+
+// Cache-line alignment for headers and tensor data.
+const size_t kAlignment = 64;
+
+size_t align_up(size_t n) {
+  return (n + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+std::string normalize_name(const std::string &name) {
+  return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+std::system_error os_error(const std::string &what) {
+  return std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace
+
+SharedMemorySegment::SharedMemorySegment(const std::string &name, size_t bytes)
+    : name_(normalize_name(name)), data_(nullptr), size_(bytes), owner_(true) {
+  int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw os_error("shm_open " + name_);
+  }
+  if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    std::system_error error = os_error("ftruncate " + name_);
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw error;
+  }
+  data_ = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    std::system_error error = os_error("mmap " + name_);
+    shm_unlink(name_.c_str());
+    throw error;
+  }
+}
+
+SharedMemorySegment::SharedMemorySegment(const std::string &name)
+    : name_(normalize_name(name)), data_(nullptr), size_(0), owner_(false) {
+  int fd = shm_open(name_.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    throw os_error("shm_open " + name_);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    std::system_error error = os_error("fstat " + name_);
+    close(fd);
+    throw error;
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    throw os_error("mmap " + name_);
+  }
+}
+
+SharedMemorySegment::~SharedMemorySegment() {
+  munmap(data_, size_);
+  if (owner_) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+struct SharedTensorArena::Header {
+  uint64_t magic_;
+  uint64_t capacity_;
+  std::atomic<uint64_t> next_;
+};
+
+struct SharedTensorArena::Record {
+  uint64_t ndim_;
+  size_t size_[kSharedMaxDims];
+};
+
+SharedTensorArena::SharedTensorArena(const std::string &name, size_t bytes)
+    : segment_(name, align_up(sizeof(Header)) + bytes) {
+  Header *h = new (segment_.data()) Header();
+  h->capacity_ = segment_.size();
+  h->next_.store(align_up(sizeof(Header)));
+  h->magic_ = kArenaMagic;
+}
+
+SharedTensorArena::SharedTensorArena(const std::string &name)
+    : segment_(name) {
+  if (segment_.size() < sizeof(Header) || header()->magic_ != kArenaMagic) {
+    throw std::runtime_error("SharedTensorArena: " + segment_.name() +
+                             " is not an arena");
+  }
+}
+
+/**
+ * @brief Allocates a zero-filled tensor of the given shape.
+ *
+ * Safe to call from several processes at once.
+ *
+ * @param size The extent of every dimension.
+ * @param ndim Number of dimensions, at most `kSharedMaxDims`.
+ * @return SharedTensorHandle
+ */
+SharedTensorHandle SharedTensorArena::allocate(const size_t *size,
+                                               size_t ndim) {
+  if (ndim > kSharedMaxDims) {
+    throw std::invalid_argument("SharedTensorArena: too many dimensions");
+  }
+  const size_t limit = std::numeric_limits<size_t>::max();
+  size_t numel = 1;
+  for (size_t dim = 0; dim < ndim; ++dim) {
+    if (size[dim] != 0 && numel > limit / size[dim]) {
+      throw std::bad_alloc();
+    }
+    numel *= size[dim];
+  }
+  if (numel > (limit - 2 * kAlignment - sizeof(Record)) / sizeof(float)) {
+    throw std::bad_alloc();
+  }
+  const size_t bytes =
+      align_up(sizeof(Record)) + align_up(numel * sizeof(float));
+
+  // Only advance the bump pointer when the record fits, so a failed request
+  // does not waste space that later, smaller requests could use.
+  const uint64_t capacity = header()->capacity_;
+  uint64_t offset = header()->next_.load();
+  do {
+    if (offset > capacity || bytes > capacity - offset) {
+      throw std::bad_alloc();
+    }
+  } while (!header()->next_.compare_exchange_weak(offset, offset + bytes));
+
+  Record *r = reinterpret_cast<Record *>(
+      static_cast<char *>(segment_.data()) + offset);
+  r->ndim_ = ndim;
+  for (size_t dim = 0; dim < ndim; ++dim) {
+    r->size_[dim] = size[dim];
+  }
+  SharedTensorHandle handle;
+  handle.offset_ = offset;
+  return handle;
+}
+
+/** @brief Returns the elements of the tensor behind input `handle`. */
+float *SharedTensorArena::data(SharedTensorHandle handle) const {
+  return reinterpret_cast<float *>(reinterpret_cast<char *>(record(handle)) +
+                                   align_up(sizeof(Record)));
+}
+
+/** @brief Returns the shape of the tensor behind input `handle`. */
+size_t *SharedTensorArena::size(SharedTensorHandle handle) const {
+  return record(handle)->size_;
+}
+
+/** @brief Returns the rank of the tensor behind input `handle`. */
+size_t SharedTensorArena::ndim(SharedTensorHandle handle) const {
+  return record(handle)->ndim_;
+}
+
+SharedTensorArena::Header *SharedTensorArena::header() const {
+  return static_cast<Header *>(segment_.data());
+}
+
+SharedTensorArena::Record *
+SharedTensorArena::record(SharedTensorHandle handle) const {
+  if (handle.offset_ < align_up(sizeof(Header)) ||
+      handle.offset_ + sizeof(Record) > segment_.size()) {
+    throw std::out_of_range("SharedTensorArena: invalid handle");
+  }
+  return reinterpret_cast<Record *>(static_cast<char *>(segment_.data()) +
+                                    handle.offset_);
+}
+
+} // namespace focus
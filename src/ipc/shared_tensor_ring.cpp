@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// shared_tensor_ring.cpp
+//
+// Identification: src/ipc/shared_tensor_ring.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ipc/shared_tensor_ring.h"
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+
+namespace focus {
+
+namespace {
+
+const uint64_t kRingMagic = 0x464f435553524731ULL; // "FOCUSRG1"
+
+const size_t kAlignment = 64;
+
+size_t align_up(size_t n) {
+  return (n + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+size_t round_up_pow2(size_t n) {
+  size_t out = 1;
+  while (out < n) {
+    out <<= 1;
+  }
+  return out;
+}
+
+} // namespace
+
+#if ATOMIC_LLONG_LOCK_FREE != 2
+#error "SharedTensorRing needs lock-free 64-bit atomics"
+#endif
+
+struct SharedTensorRing::Header {
+  uint64_t magic_;
+  uint64_t mask_;
+  uint64_t slot_stride_;
+  uint64_t slot_numel_;
+  alignas(64) std::atomic<uint64_t> enqueue_pos_;
+  alignas(64) std::atomic<uint64_t> dequeue_pos_;
+};
+
+struct SharedTensorRing::SlotHeader {
+  std::atomic<uint64_t> sequence_;
+  size_t ndim_;
+  size_t size_[kSharedMaxDims];
+};
+
+SharedTensorRing::SharedTensorRing(const std::string &name, size_t num_slots,
+                                   size_t slot_numel)
+    : segment_(name, align_up(sizeof(Header)) +
+                         round_up_pow2(num_slots) *
+                             (align_up(sizeof(SlotHeader)) +
+                              align_up(slot_numel * sizeof(float)))) {
+  Header *h = new (segment_.data()) Header();
+  h->mask_ = round_up_pow2(num_slots) - 1;
+  h->slot_stride_ =
+      align_up(sizeof(SlotHeader)) + align_up(slot_numel * sizeof(float));
+  h->slot_numel_ = slot_numel;
+  h->enqueue_pos_.store(0);
+  h->dequeue_pos_.store(0);
+  for (uint64_t i = 0; i <= h->mask_; ++i) {
+    SlotHeader *slot = new (slot_header(i)) SlotHeader();
+    slot->sequence_.store(i);
+  }
+  h->magic_ = kRingMagic;
+}
+
+SharedTensorRing::SharedTensorRing(const std::string &name) : segment_(name) {
+  if (segment_.size() < sizeof(Header) || header()->magic_ != kRingMagic) {
+    throw std::runtime_error("SharedTensorRing: " + segment_.name() +
+                             " is not a ring");
+  }
+}
+
+/**
+ * @brief Claims a free slot for writing.
+ *
+ * @param slot Receives the slot.
+ * @return `false` if every slot is in use, `true` otherwise.
+ */
+bool SharedTensorRing::try_acquire_write(SharedTensorSlot &slot) {
+  Header *h = header();
+  uint64_t pos = h->enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    uint64_t seq = slot_header(pos)->sequence_.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if (diff == 0) {
+      if (h->enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+        fill_slot(pos, slot);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = h->enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Publishes a slot claimed with `try_acquire_write`.
+ *
+ * @param slot The slot to publish.
+ */
+void SharedTensorRing::commit(const SharedTensorSlot &slot) {
+  slot_header(slot.position_)
+      ->sequence_.store(slot.position_ + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Claims the oldest published slot for reading.
+ *
+ * @param slot Receives the slot.
+ * @return `false` if no slot is published, `true` otherwise.
+ */
+bool SharedTensorRing::try_acquire_read(SharedTensorSlot &slot) {
+  Header *h = header();
+  uint64_t pos = h->dequeue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    uint64_t seq = slot_header(pos)->sequence_.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+    if (diff == 0) {
+      if (h->dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+        fill_slot(pos, slot);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = h->dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Returns a slot claimed with `try_acquire_read` to the producers.
+ *
+ * @param slot The slot to release.
+ */
+void SharedTensorRing::release(const SharedTensorSlot &slot) {
+  slot_header(slot.position_)
+      ->sequence_.store(slot.position_ + header()->mask_ + 1,
+                        std::memory_order_release);
+}
+
+/** @brief Returns the number of slots. */
+size_t SharedTensorRing::num_slots() const { return header()->mask_ + 1; }
+
+/** @brief Returns the number of floats each slot can hold. */
+size_t SharedTensorRing::slot_numel() const { return header()->slot_numel_; }
+
+SharedTensorRing::Header *SharedTensorRing::header() const {
+  return static_cast<Header *>(segment_.data());
+}
+
+SharedTensorRing::SlotHeader *
+SharedTensorRing::slot_header(uint64_t position) const {
+  Header *h = header();
+  char *base = static_cast<char *>(segment_.data()) + align_up(sizeof(Header));
+  return reinterpret_cast<SlotHeader *>(
+      base + (position & h->mask_) * h->slot_stride_);
+}
+
+void SharedTensorRing::fill_slot(uint64_t position,
+                                 SharedTensorSlot &slot) const {
+  SlotHeader *s = slot_header(position);
+  slot.position_ = position;
+  slot.data_ = reinterpret_cast<float *>(reinterpret_cast<char *>(s) +
+                                         align_up(sizeof(SlotHeader)));
+  slot.size_ = s->size_;
+  slot.ndim_ = &s->ndim_;
+  slot.capacity_ = header()->slot_numel_;
+}
+
+} // namespace focus
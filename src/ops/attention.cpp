@@ -0,0 +1,178 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// attention.cpp
+//
+// Identification: src/ops/attention.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/attention.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Queries per tile; one tile is the unit of parallel work.
+const size_t kQueryTile = 32;
+
+// Keys per tile; the key and value rows of a tile are reused by every query
+// in the query tile while they are still in cache.
+const size_t kKeyTile = 64;
+
+inline float dot(const float *a, const float *b, size_t n) {
+  float sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+} // namespace
+
+/**
+ * @brief Computes `softmax(Q K^T * scale) V` without materializing the score
+ * matrix.
+ *
+ * `query` is `[B, H, Lq, D]`, `key` is `[B, H, Lk, D]`, `value` is
+ * `[B, H, Lk, Dv]` and `output` must already be shaped `[B, H, Lq, Dv]`.
+ * Queries and keys are processed in tiles with a running maximum and sum per
+ * query, so memory is linear in the sequence length. Work is split across the
+ * thread pool over batch, heads and query tiles.
+ *
+ * With `causal_`, query `i` sees keys `j <= i + Lk - Lq`. Queries that see no
+ * key produce zeros.
+ *
+ * @param query The query tensor.
+ * @param key The key tensor.
+ * @param value The value tensor.
+ * @param key_lengths Optional `[B]` count of valid keys per batch entry; keys
+ * past it are padding. May be `nullptr`.
+ * @param output The output tensor.
+ * @param params Masking and scale.
+ */
+void scaled_dot_product_attention(const FloatTensor &query,
+                                  const FloatTensor &key,
+                                  const FloatTensor &value,
+                                  const size_t *key_lengths,
+                                  FloatTensor &output,
+                                  const AttentionParams &params) {
+  if (query.ndim_ != 4 || key.ndim_ != 4 || value.ndim_ != 4 ||
+      output.ndim_ != 4) {
+    throw std::invalid_argument("attention: expected 4-D tensors");
+  }
+  const size_t batch = query.size_[0];
+  const size_t heads = query.size_[1];
+  const size_t lq = query.size_[2];
+  const size_t d = query.size_[3];
+  const size_t lk = key.size_[2];
+  const size_t dv = value.size_[3];
+  if (key.size_[0] != batch || key.size_[1] != heads || key.size_[3] != d ||
+      value.size_[0] != batch || value.size_[1] != heads ||
+      value.size_[2] != lk) {
+    throw std::invalid_argument("attention: key/value shape mismatch");
+  }
+  if (output.size_[0] != batch || output.size_[1] != heads ||
+      output.size_[2] != lq || output.size_[3] != dv) {
+    throw std::invalid_argument("attention: output shape mismatch");
+  }
+  check_mutable("attention", output);
+
+  const float scale =
+      params.scale_ != 0 ? params.scale_ : 1.0f / std::sqrt(float(d ? d : 1));
+  const float neg_inf = -std::numeric_limits<float>::infinity();
+  // Query `i` sees keys before `i + shift`.
+  const std::ptrdiff_t shift =
+      static_cast<std::ptrdiff_t>(lk) - static_cast<std::ptrdiff_t>(lq) + 1;
+  const size_t q_tiles = (lq + kQueryTile - 1) / kQueryTile;
+
+  parallel_for(0, batch * heads * q_tiles, [&](size_t lo, size_t hi) {
+    WorkspaceScope workspace;
+    float *scores = workspace.alloc<float>(kKeyTile);
+    float *row_max = workspace.alloc<float>(kQueryTile);
+    float *row_sum = workspace.alloc<float>(kQueryTile);
+    float *acc = workspace.alloc<float>(kQueryTile * dv);
+
+    for (size_t task = lo; task < hi; ++task) {
+      const size_t bh = task / q_tiles;
+      const size_t q0 = (task % q_tiles) * kQueryTile;
+      const size_t rows = std::min(kQueryTile, lq - q0);
+      const size_t valid =
+          key_lengths ? std::min(key_lengths[bh / heads], lk) : lk;
+
+      const float *q = query.data_ + (bh * lq + q0) * d;
+      const float *k = key.data_ + bh * lk * d;
+      const float *v = value.data_ + bh * lk * dv;
+      float *out = output.data_ + (bh * lq + q0) * dv;
+
+      // Exclusive end of the keys visible to query `q0 + r`.
+      auto key_end = [&](size_t r) -> size_t {
+        if (!params.causal_) {
+          return valid;
+        }
+        std::ptrdiff_t end = static_cast<std::ptrdiff_t>(q0 + r) + shift;
+        return end <= 0 ? 0 : std::min(valid, static_cast<size_t>(end));
+      };
+
+      std::fill(row_max, row_max + rows, neg_inf);
+      std::fill(row_sum, row_sum + rows, 0.0f);
+      std::fill(acc, acc + rows * dv, 0.0f);
+
+      const size_t tile_end = key_end(rows - 1);
+      for (size_t k0 = 0; k0 < tile_end; k0 += kKeyTile) {
+        for (size_t r = 0; r < rows; ++r) {
+          const size_t end = key_end(r);
+          if (end <= k0) {
+            continue;
+          }
+          const size_t cols = std::min(kKeyTile, end - k0);
+          const float *qr = q + r * d;
+
+          float tile_max = neg_inf;
+          for (size_t c = 0; c < cols; ++c) {
+            scores[c] = dot(qr, k + (k0 + c) * d, d) * scale;
+            tile_max = std::max(tile_max, scores[c]);
+          }
+
+          // Rescale what has been accumulated so far to the new maximum.
+          const float new_max = std::max(row_max[r], tile_max);
+          const float correction = std::exp(row_max[r] - new_max);
+          float *acc_r = acc + r * dv;
+          float sum = row_sum[r] * correction;
+          for (size_t j = 0; j < dv; ++j) {
+            acc_r[j] *= correction;
+          }
+          for (size_t c = 0; c < cols; ++c) {
+            const float p = std::exp(scores[c] - new_max);
+            const float *vc = v + (k0 + c) * dv;
+            sum += p;
+            for (size_t j = 0; j < dv; ++j) {
+              acc_r[j] += p * vc[j];
+            }
+          }
+          row_max[r] = new_max;
+          row_sum[r] = sum;
+        }
+      }
+
+      for (size_t r = 0; r < rows; ++r) {
+        const float inv = row_sum[r] > 0 ? 1.0f / row_sum[r] : 0.0f;
+        for (size_t j = 0; j < dv; ++j) {
+          out[r * dv + j] = acc[r * dv + j] * inv;
+        }
+      }
+    }
+  });
+}
+
+} // namespace focus
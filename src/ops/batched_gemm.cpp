@@ -0,0 +1,255 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// batched_gemm.cpp
+//
+// Identification: src/ops/batched_gemm.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/batched_gemm.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "common/thread_pool.h"
+
+namespace focus {
+
+namespace {
+
+// Matrices interleaved per group by the small-shape kernels.
+const size_t kLanes = 8;
+
+// Groups of matrices handed to a worker at a time.
+const size_t kGroupsPerTask = 16;
+
+struct GemmShape {
+  size_t batch_;
+  size_t m_;
+  size_t n_;
+  size_t k_;
+
+  // Distance between consecutive matrices, 0 when broadcast.
+  size_t stride_a_;
+  size_t stride_b_;
+};
+
+/*
+ * Computes one product with runtime extents, accumulating each row of `c`
+ * along `n` so the inner loop is contiguous.
+ */
+void generic_kernel(const GemmShape &s, const float *a, const float *b,
+                    float *c) {
+  std::fill(c, c + s.m_ * s.n_, 0.0f);
+  for (size_t i = 0; i < s.m_; ++i) {
+    float *ci = c + i * s.n_;
+    for (size_t p = 0; p < s.k_; ++p) {
+      const float aip = a[i * s.k_ + p];
+      const float *bp = b + p * s.n_;
+      for (size_t j = 0; j < s.n_; ++j) {
+        ci[j] += aip * bp[j];
+      }
+    }
+  }
+}
+
+/*
+ * Computes one product with compile-time extents, so every loop is unrolled
+ * and the accumulator lives in registers or on the stack.
+ */
+template <size_t M, size_t N, size_t K>
+void fixed_kernel(const float *a, const float *b, float *c) {
+  float acc[M * N] = {};
+  for (size_t i = 0; i < M; ++i) {
+    for (size_t p = 0; p < K; ++p) {
+      const float aip = a[i * K + p];
+      for (size_t j = 0; j < N; ++j) {
+        acc[i * N + j] += aip * b[p * N + j];
+      }
+    }
+  }
+  std::copy(acc, acc + M * N, c);
+}
+
+/*
+ * Computes `kLanes` products at once. The operands are repacked so element
+ * `(i, j)` of every matrix in the group sits in adjacent lanes; the
+ * innermost loop then runs across matrices and maps onto SIMD registers
+ * however small the matrices are.
+ */
+template <size_t M, size_t N, size_t K>
+void interleaved_kernel(const GemmShape &s, const float *a, const float *b,
+                        float *c) {
+  float pa[M * K * kLanes];
+  float pb[K * N * kLanes];
+  float pc[M * N * kLanes] = {};
+  for (size_t l = 0; l < kLanes; ++l) {
+    for (size_t x = 0; x < M * K; ++x) {
+      pa[x * kLanes + l] = a[l * s.stride_a_ + x];
+    }
+    for (size_t x = 0; x < K * N; ++x) {
+      pb[x * kLanes + l] = b[l * s.stride_b_ + x];
+    }
+  }
+  for (size_t i = 0; i < M; ++i) {
+    for (size_t p = 0; p < K; ++p) {
+      const float *ap = pa + (i * K + p) * kLanes;
+      for (size_t j = 0; j < N; ++j) {
+        const float *bp = pb + (p * N + j) * kLanes;
+        float *cp = pc + (i * N + j) * kLanes;
+        for (size_t l = 0; l < kLanes; ++l) {
+          cp[l] += ap[l] * bp[l];
+        }
+      }
+    }
+  }
+  for (size_t l = 0; l < kLanes; ++l) {
+    for (size_t x = 0; x < M * N; ++x) {
+      c[l * M * N + x] = pc[x * kLanes + l];
+    }
+  }
+}
+
+/*
+ * Runs the matrices of groups `[lo, hi)`. Full groups go through `group`;
+ * the matrices past the last full group go through `single`.
+ */
+template <typename Group, typename Single>
+void run_groups(const GemmShape &s, const float *a, const float *b, float *c,
+                size_t lo, size_t hi, Group group, Single single) {
+  const size_t mn = s.m_ * s.n_;
+  for (size_t g = lo; g < hi; ++g) {
+    const size_t first = g * kLanes;
+    const size_t last = std::min(s.batch_, first + kLanes);
+    if (last - first == kLanes) {
+      group(a + first * s.stride_a_, b + first * s.stride_b_, c + first * mn);
+      continue;
+    }
+    for (size_t i = first; i < last; ++i) {
+      single(a + i * s.stride_a_, b + i * s.stride_b_, c + i * mn);
+    }
+  }
+}
+
+template <size_t M, size_t N, size_t K>
+void run_interleaved(const GemmShape &s, const float *a, const float *b,
+                     float *c, size_t lo, size_t hi) {
+  run_groups(
+      s, a, b, c, lo, hi,
+      [&s](const float *ga, const float *gb, float *gc) {
+        interleaved_kernel<M, N, K>(s, ga, gb, gc);
+      },
+      fixed_kernel<M, N, K>);
+}
+
+template <size_t M, size_t N, size_t K>
+void run_fixed(const GemmShape &s, const float *a, const float *b, float *c,
+               size_t lo, size_t hi) {
+  auto single = fixed_kernel<M, N, K>;
+  run_groups(
+      s, a, b, c, lo, hi,
+      [&](const float *ga, const float *gb, float *gc) {
+        for (size_t l = 0; l < kLanes; ++l) {
+          single(ga + l * s.stride_a_, gb + l * s.stride_b_, gc + l * M * N);
+        }
+      },
+      single);
+}
+
+void run_generic(const GemmShape &s, const float *a, const float *b, float *c,
+                 size_t lo, size_t hi) {
+  auto single = [&s](const float *ma, const float *mb, float *mc) {
+    generic_kernel(s, ma, mb, mc);
+  };
+  run_groups(
+      s, a, b, c, lo, hi,
+      [&](const float *ga, const float *gb, float *gc) {
+        for (size_t l = 0; l < kLanes; ++l) {
+          single(ga + l * s.stride_a_, gb + l * s.stride_b_,
+                 gc + l * s.m_ * s.n_);
+        }
+      },
+      single);
+}
+
+// Returns the runner specialized for the shape, or the generic one.
+using Runner = void (*)(const GemmShape &, const float *, const float *,
+                        float *, size_t, size_t);
+
+Runner select_runner(const GemmShape &s) {
+  struct Entry {
+    size_t m_, n_, k_;
+    Runner run_;
+  };
+  static const Entry kSpecialized[] = {
+      {2, 2, 2, run_interleaved<2, 2, 2>},
+      {3, 3, 3, run_interleaved<3, 3, 3>},
+      {4, 4, 4, run_interleaved<4, 4, 4>},
+      {8, 8, 8, run_interleaved<8, 8, 8>},
+      // Matrix-vector products of 3-D and homogeneous transforms.
+      {3, 1, 3, run_interleaved<3, 1, 3>},
+      {4, 1, 4, run_interleaved<4, 1, 4>},
+      {16, 16, 16, run_fixed<16, 16, 16>},
+      {32, 32, 32, run_fixed<32, 32, 32>},
+  };
+  for (const Entry &e : kSpecialized) {
+    if (e.m_ == s.m_ && e.n_ == s.n_ && e.k_ == s.k_) {
+      return e.run_;
+    }
+  }
+  return run_generic;
+}
+
+} // namespace
+
+/**
+ * @brief Computes `c[i] = a[i] b[i]` for every matrix in a batch of small
+ * matrices.
+ *
+ * `a` is `[B, M, K]`, `b` is `[B, K, N]` and `c` must already be shaped
+ * `[B, M, N]`. Either `a` or `b` may have a batch of 1, in which case that
+ * matrix is shared by the whole batch. The three tensors are addressed in
+ * place by batch stride, so no per-matrix tensors are built.
+ *
+ * Common shapes run on kernels specialized at compile time: up to 8x8 the
+ * matrices are interleaved in groups of 8 so the arithmetic vectorizes across
+ * matrices, and 16x16 and 32x32 use fully unrolled per-matrix kernels. The
+ * batch is split across the thread pool.
+ *
+ * @param a The left matrices.
+ * @param b The right matrices.
+ * @param c The output matrices.
+ */
+void batched_gemm(const FloatTensor &a, const FloatTensor &b, FloatTensor &c) {
+  if (a.ndim_ != 3 || b.ndim_ != 3 || c.ndim_ != 3) {
+    throw std::invalid_argument("batched_gemm: expected 3-D tensors");
+  }
+  GemmShape s;
+  s.batch_ = c.size_[0];
+  s.m_ = a.size_[1];
+  s.k_ = a.size_[2];
+  s.n_ = b.size_[2];
+  if (b.size_[1] != s.k_) {
+    throw std::invalid_argument("batched_gemm: inner dimension mismatch");
+  }
+  if (c.size_[1] != s.m_ || c.size_[2] != s.n_ ||
+      (a.size_[0] != s.batch_ && a.size_[0] != 1) ||
+      (b.size_[0] != s.batch_ && b.size_[0] != 1)) {
+    throw std::invalid_argument("batched_gemm: output shape mismatch");
+  }
+  check_mutable("batched_gemm", c);
+  s.stride_a_ = a.size_[0] == 1 ? 0 : s.m_ * s.k_;
+  s.stride_b_ = b.size_[0] == 1 ? 0 : s.k_ * s.n_;
+
+  Runner run = select_runner(s);
+  const size_t groups = (s.batch_ + kLanes - 1) / kLanes;
+  const size_t tasks = (groups + kGroupsPerTask - 1) / kGroupsPerTask;
+  parallel_for(0, tasks, [&](size_t lo, size_t hi) {
+    run(s, a.data_, b.data_, c.data_, lo * kGroupsPerTask,
+        std::min(groups, hi * kGroupsPerTask));
+  });
+}
+
+} // namespace focus
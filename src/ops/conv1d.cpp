@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// conv1d.cpp
+//
+// Identification: src/ops/conv1d.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/conv1d.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "common/autotuner.h"
+#include "common/thread_pool.h"
+#include "ops/conv2d.h"
+#include "ops/fft_conv.h"
+
+namespace focus {
+
+namespace {
+
+// Shortest kernel worth timing the FFT path for.
+const size_t kFftMinTaps = 32;
+
+/**
+ * Direct loop, parallel over output planes. For every tap the output range
+ * whose input `t * stride + k - pad` stays inside the signal is clipped up
+ * front, so the inner loop has no padding branch.
+ */
+void direct(const FloatTensor &input, const FloatTensor &weight,
+            const FloatTensor *bias, FloatTensor &output,
+            const Conv1dParams &params) {
+  const size_t c_in = input.size_[1];
+  const size_t l = input.size_[2];
+  const size_t c_out = weight.size_[0];
+  const size_t k_n = weight.size_[2];
+  const size_t ol = output.size_[2];
+  const size_t stride = params.stride_;
+  const size_t pad = params.pad_;
+
+  parallel_for(0, input.size_[0] * c_out, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const size_t b = i / c_out;
+      const size_t oc = i % c_out;
+      float *out = output.data_ + i * ol;
+      std::fill(out, out + ol, bias ? bias->data_[oc] : 0.0f);
+      for (size_t ic = 0; ic < c_in; ++ic) {
+        const float *in = input.data_ + (b * c_in + ic) * l;
+        const float *w = weight.data_ + (oc * c_in + ic) * k_n;
+        for (size_t k = 0; k < k_n; ++k) {
+          size_t t_lo = k < pad ? (pad - k + stride - 1) / stride : 0;
+          size_t t_hi = l + pad > k ? (l + pad - k - 1) / stride + 1 : 0;
+          t_hi = std::min(t_hi, ol);
+          const float wv = w[k];
+          for (size_t t = t_lo; t < t_hi; ++t) {
+            out[t] += wv * in[t * stride + k - pad];
+          }
+        }
+      }
+    }
+  });
+}
+
+} // namespace
+
+/**
+ * @brief Computes a 1-D convolution over an NCL input.
+ *
+ * `input` is `[N, C_in, L]`, `weight` is `[C_out, C_in, K]` and `output` must
+ * already be shaped `[N, C_out, OL]`. At stride 1 with long kernels the op
+ * runs through `fft_conv1d` when the autotuner finds it faster than the
+ * direct loop for the shape.
+ *
+ * @param input The input tensor.
+ * @param weight The filter tensor.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output The output tensor.
+ * @param params Stride and padding.
+ */
+void conv1d(const FloatTensor &input, const FloatTensor &weight,
+            const FloatTensor *bias, FloatTensor &output,
+            const Conv1dParams &params) {
+  if (input.ndim_ != 3 || weight.ndim_ != 3 || output.ndim_ != 3) {
+    throw std::invalid_argument("conv1d: expected 3-D tensors");
+  }
+  if (params.stride_ == 0) {
+    throw std::invalid_argument("conv1d: stride must be > 0");
+  }
+  const size_t k = weight.size_[2];
+  const size_t ol =
+      conv2d_output_size(input.size_[2], k, params.stride_, params.pad_);
+  if (weight.size_[1] != input.size_[1] || output.size_[0] != input.size_[0] ||
+      output.size_[1] != weight.size_[0] || output.size_[2] != ol) {
+    throw std::invalid_argument("conv1d: shape mismatch");
+  }
+  if (bias != nullptr && bias->numel_ != weight.size_[0]) {
+    throw std::invalid_argument("conv1d: bias shape mismatch");
+  }
+  check_mutable("conv1d", output);
+
+  if (params.stride_ != 1 || k < kFftMinTaps) {
+    direct(input, weight, bias, output, params);
+    return;
+  }
+
+  // Both candidates overwrite the whole output, so a tuning pass leaves a
+  // valid result behind.
+  auto run = [&](size_t choice) {
+    if (choice == 0) {
+      direct(input, weight, bias, output, params);
+    } else {
+      fft_conv1d(input, weight, bias, output, params);
+    }
+  };
+  const std::string signature =
+      "n=" + std::to_string(input.size_[0]) +
+      ",c=" + std::to_string(input.size_[1]) +
+      ",o=" + std::to_string(weight.size_[0]) +
+      ",l=" + std::to_string(input.size_[2]) + ",k=" + std::to_string(k) +
+      ",p=" + std::to_string(params.pad_);
+  Autotuner &tuner = Autotuner::global();
+  size_t choice;
+  if (tuner.lookup("conv1d", signature, choice) && choice < 2) {
+    run(choice);
+  } else {
+    tuner.select("conv1d", signature, 2, run);
+  }
+}
+
+} // namespace focus
@@ -0,0 +1,484 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// conv2d.cpp
+//
+// Identification: src/ops/conv2d.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/conv2d.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "common/autotuner.h"
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+#include "ops/fft_conv.h"
+
+namespace focus {
+
+namespace {
+
+// Smallest filter height and width worth timing the FFT path for.
+const size_t kFftMinKernel = 7;
+
+struct PlaneShape {
+  size_t h_;
+  size_t w_;
+  size_t oh_;
+  size_t ow_;
+  size_t kh_;
+  size_t kw_;
+  size_t sh_;
+  size_t sw_;
+  size_t pad_h_;
+  size_t pad_w_;
+};
+
+struct ConvShape {
+  size_t n_;
+  size_t c_in_;
+  size_t c_out_;
+  size_t c_in_group_;
+  size_t c_out_group_;
+  size_t in_plane_;
+  size_t out_plane_;
+  size_t k_plane_;
+  PlaneShape plane_;
+};
+
+/**
+ * Validates the shapes of a convolution from `x` (`[N, C_in, H, W]`) to `y`
+ * (`[N, C_out, OH, OW]`) through `weight` and resolves its extents.
+ */
+ConvShape resolve_shape(const char *op, const FloatTensor &x,
+                        const FloatTensor &weight, const FloatTensor &y,
+                        const Conv2dParams &params) {
+  if (x.ndim_ != 4 || weight.ndim_ != 4 || y.ndim_ != 4) {
+    throw std::invalid_argument(std::string(op) + ": expected 4-D tensors");
+  }
+  if (params.groups_ == 0 || params.stride_h_ == 0 || params.stride_w_ == 0) {
+    throw std::invalid_argument(std::string(op) +
+                                ": groups and strides must be > 0");
+  }
+
+  ConvShape s;
+  s.n_ = x.size_[0];
+  s.c_in_ = x.size_[1];
+  s.c_out_ = weight.size_[0];
+  if (s.c_in_ % params.groups_ != 0 || s.c_out_ % params.groups_ != 0 ||
+      weight.size_[1] != s.c_in_ / params.groups_) {
+    throw std::invalid_argument(std::string(op) +
+                                ": channels do not match groups");
+  }
+  s.c_in_group_ = s.c_in_ / params.groups_;
+  s.c_out_group_ = s.c_out_ / params.groups_;
+
+  PlaneShape &p = s.plane_;
+  p.h_ = x.size_[2];
+  p.w_ = x.size_[3];
+  p.kh_ = weight.size_[2];
+  p.kw_ = weight.size_[3];
+  p.sh_ = params.stride_h_;
+  p.sw_ = params.stride_w_;
+  p.pad_h_ = params.pad_h_;
+  p.pad_w_ = params.pad_w_;
+  p.oh_ = conv2d_output_size(p.h_, p.kh_, p.sh_, p.pad_h_);
+  p.ow_ = conv2d_output_size(p.w_, p.kw_, p.sw_, p.pad_w_);
+  if (y.size_[0] != s.n_ || y.size_[1] != s.c_out_ || y.size_[2] != p.oh_ ||
+      y.size_[3] != p.ow_) {
+    throw std::invalid_argument(std::string(op) + ": output shape mismatch");
+  }
+
+  s.in_plane_ = p.h_ * p.w_;
+  s.out_plane_ = p.oh_ * p.ow_;
+  s.k_plane_ = p.kh_ * p.kw_;
+  return s;
+}
+
+/**
+ * Visits every (output row, kernel row, kernel column) triple of one plane
+ * pair, passing the clipped output column range `[lo, lo + count)` whose input
+ * columns `ow * sw + kw - pad_w` fall inside the row. Zero padding is handled
+ * by the clipping instead of a branch per element.
+ *
+ * When `KH`, `KW`, `SH` and `SW` are non-zero they override the runtime shape
+ * so the kernel loops unroll.
+ */
+template <size_t KH, size_t KW, size_t SH, size_t SW, typename Visitor>
+void for_each_tap(const PlaneShape &s, Visitor &visit) {
+  const size_t kh_n = KH ? KH : s.kh_;
+  const size_t kw_n = KW ? KW : s.kw_;
+  const size_t sh = SH ? SH : s.sh_;
+  const size_t sw = SW ? SW : s.sw_;
+
+  for (size_t oh = 0; oh < s.oh_; ++oh) {
+    for (size_t kh = 0; kh < kh_n; ++kh) {
+      size_t ih = oh * sh + kh;
+      if (ih < s.pad_h_ || ih - s.pad_h_ >= s.h_) {
+        continue;
+      }
+      for (size_t kw = 0; kw < kw_n; ++kw) {
+        size_t lo = kw < s.pad_w_ ? (s.pad_w_ - kw + sw - 1) / sw : 0;
+        size_t hi =
+            s.w_ + s.pad_w_ > kw ? (s.w_ + s.pad_w_ - kw - 1) / sw + 1 : 0;
+        hi = std::min(hi, s.ow_);
+        if (lo >= hi) {
+          continue;
+        }
+        visit(oh, ih - s.pad_h_, kh * kw_n + kw, lo, lo * sw + kw - s.pad_w_,
+              hi - lo, sw);
+      }
+    }
+  }
+}
+
+/**
+ * Forward: accumulates the correlation of an input plane with a filter plane
+ * into an output plane. The inner loop walks an output row with one broadcast
+ * weight, so it stays in L1 and vectorizes across width.
+ */
+struct ForwardPlane {
+  const float *in_;
+  const float *w_;
+  float *out_;
+  const PlaneShape &s_;
+
+  void operator()(size_t oh, size_t ih, size_t k, size_t ow, size_t iw,
+                  size_t count, size_t sw) {
+    const float wv = w_[k];
+    const float *src = in_ + ih * s_.w_ + iw;
+    float *dst = out_ + oh * s_.ow_ + ow;
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] += wv * src[i * sw];
+    }
+  }
+};
+
+/**
+ * Backward data: scatters an output-gradient plane back through a filter
+ * plane into an input-gradient plane. This is the transposed convolution.
+ */
+struct BackwardDataPlane {
+  const float *gout_;
+  const float *w_;
+  float *gin_;
+  const PlaneShape &s_;
+
+  void operator()(size_t oh, size_t ih, size_t k, size_t ow, size_t iw,
+                  size_t count, size_t sw) {
+    const float wv = w_[k];
+    const float *src = gout_ + oh * s_.ow_ + ow;
+    float *dst = gin_ + ih * s_.w_ + iw;
+    for (size_t i = 0; i < count; ++i) {
+      dst[i * sw] += wv * src[i];
+    }
+  }
+};
+
+/**
+ * Backward weight: accumulates the correlation of an input plane with an
+ * output-gradient plane into a filter-gradient plane.
+ */
+struct BackwardWeightPlane {
+  const float *in_;
+  const float *gout_;
+  float *gw_;
+  const PlaneShape &s_;
+
+  void operator()(size_t oh, size_t ih, size_t k, size_t ow, size_t iw,
+                  size_t count, size_t sw) {
+    const float *src = in_ + ih * s_.w_ + iw;
+    const float *g = gout_ + oh * s_.ow_ + ow;
+    float acc = 0;
+    for (size_t i = 0; i < count; ++i) {
+      acc += g[i] * src[i * sw];
+    }
+    gw_[k] += acc;
+  }
+};
+
+/**
+ * Runs `visit` on the specialized tap loop for depthwise-friendly 3x3 and 5x5
+ * kernels at stride 1 and 2, and for 1x1 kernels, or on the generic loop.
+ */
+template <typename Visitor>
+void dispatch_plane(const PlaneShape &s, Visitor visit) {
+  if (s.kh_ == 3 && s.kw_ == 3 && s.sh_ == 1 && s.sw_ == 1) {
+    for_each_tap<3, 3, 1, 1>(s, visit);
+  } else if (s.kh_ == 3 && s.kw_ == 3 && s.sh_ == 2 && s.sw_ == 2) {
+    for_each_tap<3, 3, 2, 2>(s, visit);
+  } else if (s.kh_ == 5 && s.kw_ == 5 && s.sh_ == 1 && s.sw_ == 1) {
+    for_each_tap<5, 5, 1, 1>(s, visit);
+  } else if (s.kh_ == 5 && s.kw_ == 5 && s.sh_ == 2 && s.sw_ == 2) {
+    for_each_tap<5, 5, 2, 2>(s, visit);
+  } else if (s.kh_ == 1 && s.kw_ == 1) {
+    for_each_tap<1, 1, 0, 0>(s, visit);
+  } else {
+    for_each_tap<0, 0, 0, 0>(s, visit);
+  }
+}
+
+/**
+ * Accumulates the transposed convolution of `gout` (`[N, C_out, OH, OW]`)
+ * into `gin` (`[N, C_in, H, W]`). Every input-gradient plane is owned by one
+ * task, so the parallel loop needs no synchronization.
+ */
+void backward_data(const float *gout, const float *weight, float *gin,
+                   const ConvShape &s) {
+  parallel_for(0, s.n_ * s.c_in_, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const size_t b = i / s.c_in_;
+      const size_t ic = i % s.c_in_;
+      const size_t g = ic / s.c_in_group_;
+      const size_t icg = ic % s.c_in_group_;
+      float *dst = gin + i * s.in_plane_;
+      for (size_t ocg = 0; ocg < s.c_out_group_; ++ocg) {
+        const size_t oc = g * s.c_out_group_ + ocg;
+        BackwardDataPlane visit = {
+            gout + (b * s.c_out_ + oc) * s.out_plane_,
+            weight + (oc * s.c_in_group_ + icg) * s.k_plane_, dst, s.plane_};
+        dispatch_plane(s.plane_, visit);
+      }
+    }
+  });
+}
+
+/**
+ * Direct forward pass, parallel over output planes.
+ */
+void forward(const FloatTensor &input, const FloatTensor &weight,
+             const FloatTensor *bias, FloatTensor &output, const ConvShape &s) {
+  parallel_for(0, s.n_ * s.c_out_, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      const size_t b = i / s.c_out_;
+      const size_t oc = i % s.c_out_;
+      float *out = output.data_ + i * s.out_plane_;
+      std::fill(out, out + s.out_plane_, bias ? bias->data_[oc] : 0.0f);
+
+      // Depthwise layers reduce over a single input channel; grouped layers
+      // walk the input channels of their group straight out of `input`.
+      const size_t g = oc / s.c_out_group_;
+      const float *in =
+          input.data_ + (b * s.c_in_ + g * s.c_in_group_) * s.in_plane_;
+      const float *w = weight.data_ + oc * s.c_in_group_ * s.k_plane_;
+      for (size_t ic = 0; ic < s.c_in_group_; ++ic) {
+        ForwardPlane visit = {in + ic * s.in_plane_, w + ic * s.k_plane_, out,
+                              s.plane_};
+        dispatch_plane(s.plane_, visit);
+      }
+    }
+  });
+}
+
+} // namespace
+
+/**
+ * @brief Returns the spatial extent of a convolution output.
+ *
+ * @param in Input extent.
+ * @param kernel Kernel extent.
+ * @param stride Stride.
+ * @param pad Zero padding on each side.
+ * @return size_t
+ */
+size_t conv2d_output_size(size_t in, size_t kernel, size_t stride,
+                          size_t pad) {
+  if (in + 2 * pad < kernel) {
+    return 0;
+  }
+  return (in + 2 * pad - kernel) / stride + 1;
+}
+
+/**
+ * @brief Computes a 2-D convolution over an NCHW input.
+ *
+ * `input` is `[N, C_in, H, W]`, `weight` is `[C_out, C_in / groups, KH, KW]`
+ * and `output` must already be shaped `[N, C_out, OH, OW]`. Groups are
+ * addressed in place, so no per-group copies are made. Depthwise layers
+ * (`groups == C_in == C_out`) with 3x3 or 5x5 kernels and stride 1 or 2 run on
+ * specialized kernels. Ungrouped stride-1 layers with 7x7 or larger filters
+ * run through `fft_conv2d` when the autotuner finds it faster for the shape.
+ *
+ * @param input The input tensor.
+ * @param weight The filter tensor.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output The output tensor.
+ * @param params Stride, padding and groups.
+ */
+void conv2d(const FloatTensor &input, const FloatTensor &weight,
+            const FloatTensor *bias, FloatTensor &output,
+            const Conv2dParams &params) {
+  ConvShape s = resolve_shape("conv2d", input, weight, output, params);
+  if (bias != nullptr && bias->numel_ != s.c_out_) {
+    throw std::invalid_argument("conv2d: bias shape mismatch");
+  }
+  check_mutable("conv2d", output);
+
+  const PlaneShape &p = s.plane_;
+  if (params.groups_ != 1 || p.sh_ != 1 || p.sw_ != 1 ||
+      p.kh_ < kFftMinKernel || p.kw_ < kFftMinKernel) {
+    forward(input, weight, bias, output, s);
+    return;
+  }
+
+  // Both candidates overwrite the whole output, so a tuning pass leaves a
+  // valid result behind.
+  auto run = [&](size_t choice) {
+    if (choice == 0) {
+      forward(input, weight, bias, output, s);
+    } else {
+      fft_conv2d(input, weight, bias, output, params);
+    }
+  };
+  const std::string signature =
+      "n=" + std::to_string(s.n_) + ",c=" + std::to_string(s.c_in_) +
+      ",o=" + std::to_string(s.c_out_) + ",h=" + std::to_string(p.h_) +
+      ",w=" + std::to_string(p.w_) + ",kh=" + std::to_string(p.kh_) +
+      ",kw=" + std::to_string(p.kw_) + ",ph=" + std::to_string(p.pad_h_) +
+      ",pw=" + std::to_string(p.pad_w_);
+  Autotuner &tuner = Autotuner::global();
+  size_t choice;
+  if (tuner.lookup("conv2d", signature, choice) && choice < 2) {
+    run(choice);
+  } else {
+    tuner.select("conv2d", signature, 2, run);
+  }
+}
+
+/**
+ * @brief Accumulates the gradient with respect to the input of `conv2d`.
+ *
+ * Reads `output.grad_` and adds the transposed convolution of it with
+ * `weight` into `input.grad_`.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param weight The filter tensor.
+ * @param input The forward input, receiving the gradient.
+ * @param params Stride, padding and groups.
+ */
+void conv2d_backward_data(const FloatTensor &output, const FloatTensor &weight,
+                          FloatTensor &input, const Conv2dParams &params) {
+  ConvShape s =
+      resolve_shape("conv2d_backward_data", input, weight, output, params);
+  if (!output.requires_grad_ || !input.requires_grad_) {
+    throw std::invalid_argument(
+        "conv2d_backward_data: input and output must require grad");
+  }
+  backward_data(output.grad_, weight.data_, input.grad_, s);
+}
+
+/**
+ * @brief Accumulates the gradients with respect to the filter and bias of
+ * `conv2d`.
+ *
+ * The batch is split across the thread pool. Each worker accumulates into its
+ * own partial filter and bias buffers, which are summed into `weight.grad_`
+ * and `bias->grad_` at the end, so no atomics are needed.
+ *
+ * @param input The forward input.
+ * @param output The forward output, holding the incoming gradient.
+ * @param weight The filter tensor, receiving the gradient.
+ * @param bias Optional bias tensor receiving the gradient, may be `nullptr`.
+ * @param params Stride, padding and groups.
+ */
+void conv2d_backward_weight(const FloatTensor &input, const FloatTensor &output,
+                            FloatTensor &weight, FloatTensor *bias,
+                            const Conv2dParams &params) {
+  ConvShape s =
+      resolve_shape("conv2d_backward_weight", input, weight, output, params);
+  if (!output.requires_grad_ || !weight.requires_grad_ ||
+      (bias != nullptr && !bias->requires_grad_)) {
+    throw std::invalid_argument(
+        "conv2d_backward_weight: output, weight and bias must require grad");
+  }
+  if (bias != nullptr && bias->numel_ != s.c_out_) {
+    throw std::invalid_argument("conv2d_backward_weight: bias shape mismatch");
+  }
+
+  const size_t w_numel = weight.numel_;
+  const size_t partial_numel = w_numel + s.c_out_;
+  const size_t parts =
+      std::max<size_t>(1, std::min(s.n_, ThreadPool::global().num_threads()));
+  WorkspaceScope workspace;
+  float *partials = workspace.alloc<float>(parts * partial_numel);
+  std::fill(partials, partials + parts * partial_numel, 0.0f);
+
+  parallel_for(0, parts, [&](size_t part_lo, size_t part_hi) {
+    for (size_t part = part_lo; part < part_hi; ++part) {
+      float *gw = partials + part * partial_numel;
+      float *gb = gw + w_numel;
+      for (size_t b = s.n_ * part / parts; b < s.n_ * (part + 1) / parts; ++b) {
+        for (size_t oc = 0; oc < s.c_out_; ++oc) {
+          const float *gout = output.grad_ + (b * s.c_out_ + oc) * s.out_plane_;
+          const size_t g = oc / s.c_out_group_;
+          for (size_t icg = 0; icg < s.c_in_group_; ++icg) {
+            const size_t ic = g * s.c_in_group_ + icg;
+            BackwardWeightPlane visit = {
+                input.data_ + (b * s.c_in_ + ic) * s.in_plane_, gout,
+                gw + (oc * s.c_in_group_ + icg) * s.k_plane_, s.plane_};
+            dispatch_plane(s.plane_, visit);
+          }
+          float acc = 0;
+          for (size_t i = 0; i < s.out_plane_; ++i) {
+            acc += gout[i];
+          }
+          gb[oc] += acc;
+        }
+      }
+    }
+  });
+
+  // Reduce the per-thread partials.
+  parallel_for(0, partial_numel, [&](size_t lo, size_t hi) {
+    for (size_t part = 0; part < parts; ++part) {
+      const float *src = partials + part * partial_numel;
+      for (size_t i = lo; i < hi; ++i) {
+        if (i < w_numel) {
+          weight.grad_[i] += src[i];
+        } else if (bias != nullptr) {
+          bias->grad_[i - w_numel] += src[i];
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Computes a 2-D transposed convolution over an NCHW input.
+ *
+ * `input` is `[N, C_in, H, W]`, `weight` is `[C_in, C_out / groups, KH, KW]`
+ * and `output` must already be shaped `[N, C_out, OH, OW]` such that a
+ * `conv2d` with the same parameters maps `OH x OW` back to `H x W`. Extra rows
+ * and columns allowed by that rule play the role of output padding.
+ *
+ * @param input The input tensor.
+ * @param weight The filter tensor.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output The output tensor.
+ * @param params Stride, padding and groups.
+ */
+void conv_transpose2d(const FloatTensor &input, const FloatTensor &weight,
+                      const FloatTensor *bias, FloatTensor &output,
+                      const Conv2dParams &params) {
+  // A transposed convolution is the data gradient of the convolution that
+  // maps `output` back to `input`.
+  ConvShape s =
+      resolve_shape("conv_transpose2d", output, weight, input, params);
+  if (bias != nullptr && bias->numel_ != s.c_in_) {
+    throw std::invalid_argument("conv_transpose2d: bias shape mismatch");
+  }
+  check_mutable("conv_transpose2d", output);
+
+  for (size_t i = 0; i < s.n_ * s.c_in_; ++i) {
+    float *out = output.data_ + i * s.in_plane_;
+    std::fill(out, out + s.in_plane_, bias ? bias->data_[i % s.c_in_] : 0.0f);
+  }
+  backward_data(input.data_, weight.data_, output.data_, s);
+}
+
+} // namespace focus
@@ -0,0 +1,375 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// embedding.cpp
+//
+// Identification: src/ops/embedding.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/embedding.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Rows ahead of the current one to prefetch while pooling a bag.
+const size_t kPrefetchDistance = 4;
+
+// Floats per 64-byte cache line.
+const size_t kLineFloats = 16;
+
+inline void prefetch_row(const float *row, size_t width) {
+#if defined(__GNUC__) || defined(__clang__)
+  for (size_t j = 0; j < width; j += kLineFloats) {
+    __builtin_prefetch(row + j, 0, 1);
+  }
+#else
+  (void)row;
+  (void)width;
+#endif
+}
+
+// Number of elements per leading-dimension row.
+size_t row_width(const FloatTensor &t) {
+  if (t.ndim_ == 0 || t.size_[0] == 0) {
+    return 0;
+  }
+  return t.numel_ / t.size_[0];
+}
+
+void check_table(const char *op, const FloatTensor &table) {
+  if (table.ndim_ == 0) {
+    throw std::invalid_argument(std::string(op) +
+                                ": expected a table with rows");
+  }
+}
+
+void check_indices(const char *op, const size_t *indices, size_t num_indices,
+                   size_t bound) {
+  for (size_t i = 0; i < num_indices; ++i) {
+    if (indices[i] >= bound) {
+      throw std::out_of_range(std::string(op) + ": index out of range");
+    }
+  }
+}
+
+/**
+ * Adds `scales[i] * src[src_rows[i]]` into `dst[indices[i]]` for every `i`.
+ * A null `src_rows` means row `i`, a null `scales` means 1.
+ *
+ * Positions are sorted by destination row and split into one segment per
+ * distinct row. Segments are distributed over the thread pool, so every
+ * destination row is written by exactly one thread.
+ */
+void segmented_add(float *dst, size_t width, const size_t *indices,
+                   size_t num_indices, const float *src,
+                   const size_t *src_rows, const float *scales) {
+  WorkspaceScope workspace;
+  size_t *order = workspace.alloc<size_t>(num_indices);
+  for (size_t i = 0; i < num_indices; ++i) {
+    order[i] = i;
+  }
+  std::sort(order, order + num_indices, [indices](size_t a, size_t b) {
+    return indices[a] < indices[b] || (indices[a] == indices[b] && a < b);
+  });
+
+  // Start of every run of equal rows, then `num_indices`.
+  size_t *segments = workspace.alloc<size_t>(num_indices + 1);
+  size_t num_segments = 0;
+  for (size_t k = 0; k < num_indices; ++k) {
+    if (k == 0 || indices[order[k]] != indices[order[k - 1]]) {
+      segments[num_segments++] = k;
+    }
+  }
+  segments[num_segments] = num_indices;
+
+  parallel_for(0, num_segments, [&](size_t lo, size_t hi) {
+    for (size_t seg = lo; seg < hi; ++seg) {
+      float *d = dst + indices[order[segments[seg]]] * width;
+      for (size_t k = segments[seg]; k < segments[seg + 1]; ++k) {
+        const size_t i = order[k];
+        const float *s = src + (src_rows ? src_rows[i] : i) * width;
+        const float a = scales ? scales[i] : 1.0f;
+        for (size_t j = 0; j < width; ++j) {
+          d[j] += a * s[j];
+        }
+      }
+    }
+  });
+}
+
+size_t bag_end(const size_t *offsets, size_t num_bags, size_t num_indices,
+               size_t b) {
+  return b + 1 < num_bags ? offsets[b + 1] : num_indices;
+}
+
+void check_offsets(const char *op, const size_t *offsets, size_t num_bags,
+                   size_t num_indices) {
+  for (size_t b = 0; b < num_bags; ++b) {
+    if (offsets[b] > bag_end(offsets, num_bags, num_indices, b)) {
+      throw std::invalid_argument(std::string(op) + ": offsets not sorted");
+    }
+  }
+  if (num_bags == 0 && num_indices > 0) {
+    throw std::invalid_argument(std::string(op) +
+                                ": indices given without any bag");
+  }
+  if (num_bags > 0 && offsets[0] != 0) {
+    throw std::invalid_argument(std::string(op) + ": offsets must start at 0");
+  }
+}
+
+} // namespace
+
+/**
+ * @brief Copies rows `indices[i]` of `table` into row `i` of `out`.
+ *
+ * `table` is `[R, ...]` and `out` must hold `num_indices` rows of the same
+ * width.
+ *
+ * @param table The tensor to read rows from.
+ * @param indices The row numbers to select.
+ * @param num_indices Number of entries in `indices`.
+ * @param out The tensor to overwrite.
+ */
+void index_select(const FloatTensor &table, const size_t *indices,
+                  size_t num_indices, FloatTensor &out) {
+  check_table("index_select", table);
+  const size_t width = row_width(table);
+  if (out.numel_ != num_indices * width) {
+    throw std::invalid_argument("index_select: output shape mismatch");
+  }
+  check_indices("index_select", indices, num_indices, table.size_[0]);
+  check_mutable("index_select", out);
+  parallel_for(0, num_indices, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      if (i + kPrefetchDistance < hi) {
+        prefetch_row(table.data_ + indices[i + kPrefetchDistance] * width,
+                     width);
+      }
+      const float *src = table.data_ + indices[i] * width;
+      std::copy(src, src + width, out.data_ + i * width);
+    }
+  });
+}
+
+/**
+ * @brief Adds row `i` of `src` into row `indices[i]` of `table`.
+ *
+ * Repeated indices accumulate. The indices are sorted once so each
+ * destination row is owned by a single thread, which lets the update run in
+ * parallel without atomics.
+ *
+ * This method will perform addition as an in-place operation on `table`.
+ *
+ * @param table The tensor to add into.
+ * @param indices The destination row numbers.
+ * @param num_indices Number of entries in `indices`.
+ * @param src The rows to add, `num_indices` rows of the same width.
+ */
+void index_add_(FloatTensor &table, const size_t *indices, size_t num_indices,
+                const FloatTensor &src) {
+  check_table("index_add_", table);
+  const size_t width = row_width(table);
+  if (src.numel_ != num_indices * width) {
+    throw std::invalid_argument("index_add_: source shape mismatch");
+  }
+  check_indices("index_add_", indices, num_indices, table.size_[0]);
+  check_mutable("index_add_", table);
+  segmented_add(table.data_, width, indices, num_indices, src.data_, nullptr,
+                nullptr);
+}
+
+/**
+ * @brief Gathers along the last dimension: `out[..., j] =
+ * input[..., index[..., j]]`.
+ *
+ * `index` holds `out.numel_` entries and `out` matches `input` in every
+ * dimension but the last.
+ *
+ * @param input The tensor to read from.
+ * @param index The positions to read within each row.
+ * @param out The tensor to overwrite.
+ */
+void gather(const FloatTensor &input, const size_t *index, FloatTensor &out) {
+  if (input.ndim_ == 0 || out.ndim_ != input.ndim_) {
+    throw std::invalid_argument("gather: rank mismatch");
+  }
+  const size_t in_width = input.size_[input.ndim_ - 1];
+  const size_t out_width = out.size_[out.ndim_ - 1];
+  const size_t rows = in_width ? input.numel_ / in_width : 0;
+  if (out.numel_ != rows * out_width) {
+    throw std::invalid_argument("gather: output shape mismatch");
+  }
+  check_indices("gather", index, out.numel_, in_width);
+  check_mutable("gather", out);
+  parallel_for(0, rows, [&](size_t lo, size_t hi) {
+    for (size_t r = lo; r < hi; ++r) {
+      const float *src = input.data_ + r * in_width;
+      const size_t *idx = index + r * out_width;
+      float *dst = out.data_ + r * out_width;
+      for (size_t j = 0; j < out_width; ++j) {
+        dst[j] = src[idx[j]];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Scatters along the last dimension: `out[..., index[..., j]] +=
+ * src[..., j]`.
+ *
+ * This method will perform addition as an in-place operation on `out`.
+ *
+ * @param out The tensor to add into.
+ * @param index The positions to write within each row, `src.numel_` entries.
+ * @param src The values to add.
+ */
+void scatter_add_(FloatTensor &out, const size_t *index,
+                  const FloatTensor &src) {
+  if (out.ndim_ == 0 || out.ndim_ != src.ndim_) {
+    throw std::invalid_argument("scatter_add_: rank mismatch");
+  }
+  const size_t out_width = out.size_[out.ndim_ - 1];
+  const size_t src_width = src.size_[src.ndim_ - 1];
+  const size_t rows = out_width ? out.numel_ / out_width : 0;
+  if (src.numel_ != rows * src_width) {
+    throw std::invalid_argument("scatter_add_: source shape mismatch");
+  }
+  check_indices("scatter_add_", index, src.numel_, out_width);
+  check_mutable("scatter_add_", out);
+
+  // Rows are independent, so splitting over them never races.
+  parallel_for(0, rows, [&](size_t lo, size_t hi) {
+    for (size_t r = lo; r < hi; ++r) {
+      float *dst = out.data_ + r * out_width;
+      const size_t *idx = index + r * src_width;
+      const float *s = src.data_ + r * src_width;
+      for (size_t j = 0; j < src_width; ++j) {
+        dst[idx[j]] += s[j];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Pools variable-length bags of `table` rows.
+ *
+ * Bag `b` covers `indices[offsets[b]]` up to `indices[offsets[b + 1]]` (or
+ * `num_indices` for the last bag). Rows are summed or averaged into row `b`
+ * of `out`, which must be `[num_bags, D]`. Bags are spread over the thread
+ * pool and upcoming rows are prefetched while the current one is added.
+ *
+ * @param table The `[R, D]` embedding table.
+ * @param indices The row numbers of every bag, back to back.
+ * @param num_indices Number of entries in `indices`.
+ * @param offsets Start of every bag within `indices`.
+ * @param num_bags Number of entries in `offsets`.
+ * @param mode How rows within a bag are pooled.
+ * @param out The tensor to overwrite.
+ */
+void embedding_bag(const FloatTensor &table, const size_t *indices,
+                   size_t num_indices, const size_t *offsets, size_t num_bags,
+                   EmbeddingBagMode mode, FloatTensor &out) {
+  if (table.ndim_ != 2) {
+    throw std::invalid_argument("embedding_bag: expected a 2-D table");
+  }
+  const size_t width = table.size_[1];
+  if (out.numel_ != num_bags * width) {
+    throw std::invalid_argument("embedding_bag: output shape mismatch");
+  }
+  check_indices("embedding_bag", indices, num_indices, table.size_[0]);
+  check_offsets("embedding_bag", offsets, num_bags, num_indices);
+  check_mutable("embedding_bag", out);
+
+  parallel_for(0, num_bags, [&](size_t lo, size_t hi) {
+    // Prefetch across bag boundaries too, bags are often only a few rows.
+    const size_t stop = bag_end(offsets, num_bags, num_indices, hi - 1);
+    for (size_t b = lo; b < hi; ++b) {
+      const size_t begin = offsets[b];
+      const size_t end = bag_end(offsets, num_bags, num_indices, b);
+      float *dst = out.data_ + b * width;
+      std::fill(dst, dst + width, 0.0f);
+      for (size_t i = begin; i < end; ++i) {
+        if (i + kPrefetchDistance < stop) {
+          prefetch_row(table.data_ + indices[i + kPrefetchDistance] * width,
+                       width);
+        }
+        const float *src = table.data_ + indices[i] * width;
+        for (size_t j = 0; j < width; ++j) {
+          dst[j] += src[j];
+        }
+      }
+      if (mode == EmbeddingBagMode::MEAN && end > begin) {
+        const float scale = 1.0f / static_cast<float>(end - begin);
+        for (size_t j = 0; j < width; ++j) {
+          dst[j] *= scale;
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Accumulates the gradient of `embedding_bag` into `table.grad_`.
+ *
+ * Reads `out.grad_`. Uses the same sorted-index segmentation as `index_add_`,
+ * so rows shared by many bags are updated without conflicts.
+ *
+ * @param out The forward output, holding the incoming gradient.
+ * @param indices The row numbers of every bag, back to back.
+ * @param num_indices Number of entries in `indices`.
+ * @param offsets Start of every bag within `indices`.
+ * @param num_bags Number of entries in `offsets`.
+ * @param mode How rows within a bag were pooled.
+ * @param table The `[R, D]` embedding table, receiving the gradient.
+ */
+void embedding_bag_backward(const FloatTensor &out, const size_t *indices,
+                            size_t num_indices, const size_t *offsets,
+                            size_t num_bags, EmbeddingBagMode mode,
+                            FloatTensor &table) {
+  if (table.ndim_ != 2) {
+    throw std::invalid_argument("embedding_bag_backward: expected a 2-D table");
+  }
+  if (!out.requires_grad_ || !table.requires_grad_) {
+    throw std::invalid_argument(
+        "embedding_bag_backward: output and table must require grad");
+  }
+  const size_t width = table.size_[1];
+  if (out.numel_ != num_bags * width) {
+    throw std::invalid_argument("embedding_bag_backward: shape mismatch");
+  }
+  check_indices("embedding_bag_backward", indices, num_indices,
+                table.size_[0]);
+  check_offsets("embedding_bag_backward", offsets, num_bags, num_indices);
+
+  // Every looked-up row receives the gradient of its bag, scaled for means.
+  // The offsets start at 0 and are sorted, so the bags cover every index.
+  WorkspaceScope workspace;
+  size_t *bag_of = workspace.alloc<size_t>(num_indices);
+  float *scales = workspace.alloc<float>(num_indices);
+  for (size_t b = 0; b < num_bags; ++b) {
+    const size_t begin = offsets[b];
+    const size_t end = bag_end(offsets, num_bags, num_indices, b);
+    const float scale = mode == EmbeddingBagMode::MEAN && end > begin
+                            ? 1.0f / static_cast<float>(end - begin)
+                            : 1.0f;
+    for (size_t i = begin; i < end; ++i) {
+      bag_of[i] = b;
+      scales[i] = scale;
+    }
+  }
+  segmented_add(table.grad_, width, indices, num_indices, out.grad_,
+                bag_of, scales);
+}
+
+} // namespace focus
@@ -0,0 +1,305 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// fft.cpp
+//
+// Identification: src/ops/fft.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/fft.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Largest radix whose butterfly scratch lives on the stack.
+const size_t kMaxStackRadix = 8;
+
+Complex unit_root(size_t k, size_t n) {
+  double phase = -2 * kPi * static_cast<double>(k) / static_cast<double>(n);
+  return Complex(static_cast<float>(std::cos(phase)),
+                 static_cast<float>(std::sin(phase)));
+}
+
+// Plan caches keyed by length; plans are never evicted.
+template <typename Plan>
+std::shared_ptr<const Plan> cached_plan(size_t n) {
+  static std::mutex mutex;
+  static std::map<size_t, std::shared_ptr<const Plan>> plans;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<const Plan> &plan = plans[n];
+  if (!plan) {
+    plan = std::make_shared<const Plan>(n);
+  }
+  return plan;
+}
+
+} // namespace
+
+/**
+ * @param n The transform length, at least 1.
+ */
+FftPlan::FftPlan(size_t n) : n_(n) {
+  if (n == 0) {
+    throw std::invalid_argument("FftPlan: length must be positive");
+  }
+  // Radix-4 passes first since they do the most work per twiddle, then the
+  // small primes, then whatever prime factors are left.
+  size_t rest = n;
+  const size_t preferred[] = {4, 2, 3, 5};
+  for (size_t radix : preferred) {
+    while (rest % radix == 0) {
+      rest /= radix;
+      factors_.push_back(radix);
+      factors_.push_back(rest);
+    }
+  }
+  for (size_t p = 7; rest > 1; p += 2) {
+    while (rest % p == 0) {
+      rest /= p;
+      factors_.push_back(p);
+      factors_.push_back(rest);
+    }
+  }
+  if (factors_.empty()) {
+    factors_.push_back(1);
+    factors_.push_back(1);
+  }
+
+  twiddles_.resize(n);
+  for (size_t k = 0; k < n; ++k) {
+    twiddles_[k] = unit_root(k, n);
+  }
+}
+
+/**
+ * @brief Returns the shared plan for length `n`, building it on first use.
+ *
+ * @param n The transform length.
+ * @return std::shared_ptr<const FftPlan>
+ */
+std::shared_ptr<const FftPlan> FftPlan::cached(size_t n) {
+  return cached_plan<FftPlan>(n);
+}
+
+/**
+ * @brief Returns the smallest length `>= n` whose only prime factors are 2, 3
+ * and 5, the lengths the specialized passes cover.
+ *
+ * @param n The minimum length.
+ * @return size_t
+ */
+size_t FftPlan::good_size(size_t n) {
+  for (size_t candidate = std::max<size_t>(n, 1);; ++candidate) {
+    size_t rest = candidate;
+    for (size_t p : {2, 3, 5}) {
+      while (rest % p == 0) {
+        rest /= p;
+      }
+    }
+    if (rest == 1) {
+      return candidate;
+    }
+  }
+}
+
+/**
+ * @brief Computes `out[k] = sum_j in[j] exp(-2 pi i j k / n)`.
+ *
+ * @param in `n` input values.
+ * @param out Receives `n` values; must not alias `in`.
+ */
+void FftPlan::forward(const Complex *in, Complex *out) const {
+  transform(out, in, 1, 0);
+}
+
+/**
+ * @brief Computes the inverse transform, including the `1 / n` scale.
+ *
+ * @param in `n` input values.
+ * @param out Receives `n` values; must not alias `in`.
+ */
+void FftPlan::inverse(const Complex *in, Complex *out) const {
+  // ifft(x) = conj(fft(conj(x))) / n.
+  WorkspaceScope workspace;
+  Complex *conjugated = workspace.alloc<Complex>(n_);
+  for (size_t i = 0; i < n_; ++i) {
+    conjugated[i] = std::conj(in[i]);
+  }
+  transform(out, conjugated, 1, 0);
+  const float scale = 1.0f / n_;
+  for (size_t i = 0; i < n_; ++i) {
+    out[i] = std::conj(out[i]) * scale;
+  }
+}
+
+/*
+ * Mixed-radix decimation in time. Writes into `out` the transform of
+ * `in[0], in[stride], in[2 stride], ...`, of length `p * m` where `p` and `m`
+ * are the radix and remaining length of `stage`. Each of the `p` decimated
+ * subsequences is transformed into its own block of `out`, and the blocks are
+ * combined in place with radix-`p` butterflies.
+ */
+void FftPlan::transform(Complex *out, const Complex *in, size_t stride,
+                        size_t stage) const {
+  const size_t p = factors_[2 * stage];
+  const size_t m = factors_[2 * stage + 1];
+  if (m == 1) {
+    for (size_t q = 0; q < p; ++q) {
+      out[q] = in[q * stride];
+    }
+  } else {
+    for (size_t q = 0; q < p; ++q) {
+      transform(out + q * m, in + q * stride, stride * p, stage + 1);
+    }
+  }
+
+  const Complex *tw = twiddles_.data();
+  switch (p) {
+  case 1:
+    return;
+  case 2:
+    for (size_t k = 0; k < m; ++k) {
+      const Complex t = out[k + m] * tw[k * stride];
+      out[k + m] = out[k] - t;
+      out[k] += t;
+    }
+    return;
+  case 4:
+    for (size_t k = 0; k < m; ++k) {
+      const Complex a0 = out[k];
+      const Complex a1 = out[k + m] * tw[k * stride];
+      const Complex a2 = out[k + 2 * m] * tw[2 * k * stride];
+      const Complex a3 = out[k + 3 * m] * tw[3 * k * stride];
+      const Complex b0 = a0 + a2;
+      const Complex b1 = a0 - a2;
+      const Complex b2 = a1 + a3;
+      // (a1 - a3) * -i.
+      const Complex d = a1 - a3;
+      const Complex b3(d.imag(), -d.real());
+      out[k] = b0 + b2;
+      out[k + m] = b1 + b3;
+      out[k + 2 * m] = b0 - b2;
+      out[k + 3 * m] = b1 - b3;
+    }
+    return;
+  default:
+    break;
+  }
+
+  // Generic radix: a direct `p`-point transform per butterfly. The `p`-th
+  // roots of unity are every `n / p`-th twiddle.
+  Complex stack_scratch[kMaxStackRadix];
+  WorkspaceScope workspace;
+  Complex *scratch = stack_scratch;
+  if (p > kMaxStackRadix) {
+    scratch = workspace.alloc<Complex>(p);
+  }
+  const size_t root_step = stride * m;
+  for (size_t k = 0; k < m; ++k) {
+    for (size_t q = 0; q < p; ++q) {
+      scratch[q] = out[k + q * m] * tw[q * k * stride];
+    }
+    for (size_t u = 0; u < p; ++u) {
+      Complex sum = scratch[0];
+      for (size_t q = 1; q < p; ++q) {
+        sum += scratch[q] * tw[(q * u % p) * root_step];
+      }
+      out[k + u * m] = sum;
+    }
+  }
+}
+
+/**
+ * @param n The transform length; must be even.
+ */
+RealFftPlan::RealFftPlan(size_t n) : n_(n) {
+  if (n == 0 || n % 2 != 0) {
+    throw std::invalid_argument("RealFftPlan: length must be even");
+  }
+  half_ = FftPlan::cached(n / 2);
+  twiddles_.resize(n / 2);
+  for (size_t k = 0; k < n / 2; ++k) {
+    twiddles_[k] = unit_root(k, n);
+  }
+}
+
+/**
+ * @brief Returns the shared plan for length `n`, building it on first use.
+ *
+ * @param n The transform length.
+ * @return std::shared_ptr<const RealFftPlan>
+ */
+std::shared_ptr<const RealFftPlan> RealFftPlan::cached(size_t n) {
+  return cached_plan<RealFftPlan>(n);
+}
+
+/**
+ * @brief Computes the first `n / 2 + 1` outputs of the transform of `in`.
+ *
+ * @param in `n` real input values.
+ * @param out Receives `n / 2 + 1` values.
+ */
+void RealFftPlan::forward(const float *in, Complex *out) const {
+  const size_t h = n_ / 2;
+  WorkspaceScope workspace;
+  Complex *packed = workspace.alloc<Complex>(h);
+  Complex *spectrum = workspace.alloc<Complex>(h);
+  // Even samples in the real part, odd samples in the imaginary part.
+  for (size_t k = 0; k < h; ++k) {
+    packed[k] = Complex(in[2 * k], in[2 * k + 1]);
+  }
+  half_->forward(packed, spectrum);
+
+  out[0] = Complex(spectrum[0].real() + spectrum[0].imag(), 0);
+  out[h] = Complex(spectrum[0].real() - spectrum[0].imag(), 0);
+  for (size_t k = 1; k < h; ++k) {
+    const Complex z = spectrum[k];
+    const Complex zc = std::conj(spectrum[h - k]);
+    // Transforms of the even and odd samples.
+    const Complex even = (z + zc) * 0.5f;
+    const Complex diff = (z - zc) * 0.5f;
+    const Complex odd(diff.imag(), -diff.real());
+    out[k] = even + twiddles_[k] * odd;
+  }
+}
+
+/**
+ * @brief Recovers the real signal from its `n / 2 + 1` outputs, including the
+ * `1 / n` scale.
+ *
+ * @param in `n / 2 + 1` values.
+ * @param out Receives `n` real values.
+ */
+void RealFftPlan::inverse(const Complex *in, float *out) const {
+  const size_t h = n_ / 2;
+  WorkspaceScope workspace;
+  Complex *spectrum = workspace.alloc<Complex>(h);
+  Complex *packed = workspace.alloc<Complex>(h);
+  for (size_t k = 0; k < h; ++k) {
+    const Complex x = in[k];
+    const Complex xc = std::conj(in[h - k]);
+    const Complex even = (x + xc) * 0.5f;
+    const Complex odd = (x - xc) * std::conj(twiddles_[k]) * 0.5f;
+    // even + i * odd.
+    spectrum[k] = Complex(even.real() - odd.imag(), even.imag() + odd.real());
+  }
+  half_->inverse(spectrum, packed);
+  for (size_t k = 0; k < h; ++k) {
+    out[2 * k] = packed[k].real();
+    out[2 * k + 1] = packed[k].imag();
+  }
+}
+
+} // namespace focus
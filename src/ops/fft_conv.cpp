@@ -0,0 +1,322 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// fft_conv.cpp
+//
+// Identification: src/ops/fft_conv.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/fft_conv.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+#include "ops/fft.h"
+
+namespace focus {
+
+namespace {
+
+// Smallest FFT length along a dimension, so short kernels still get tiles
+// long enough to amortize the transforms.
+const size_t kMinTile1d = 1024;
+const size_t kMinTile2d = 32;
+
+// Upper bound on the filter spectra held at once; larger layers are processed
+// in blocks of output channels.
+const size_t kSpectrumBudget = size_t(64) << 20;
+
+/**
+ * The extents of a stride-1 correlation, with 1-D problems expressed as
+ * `H = KH = OH = 1`.
+ */
+struct FftShape {
+  size_t n_;
+  size_t c_in_;
+  size_t c_out_;
+  size_t h_;
+  size_t w_;
+  size_t kh_;
+  size_t kw_;
+  size_t pad_h_;
+  size_t pad_w_;
+  size_t oh_;
+  size_t ow_;
+};
+
+/**
+ * FFT length covering `out` outputs of a `k`-tap filter, or at least
+ * `max(4 k, min_tile)` of them when the output is longer.
+ */
+size_t tile_length(size_t out, size_t k, size_t min_tile, bool even) {
+  size_t length = std::min(out + k - 1, std::max(4 * k, min_tile));
+  if (even) {
+    return 2 * FftPlan::good_size((length + 1) / 2);
+  }
+  return FftPlan::good_size(length);
+}
+
+/**
+ * A 2-D real transform of an `fh x fw` block: real transforms along the rows,
+ * then complex transforms down the `fw / 2 + 1` retained columns.
+ */
+class Rfft2d {
+public:
+  Rfft2d(size_t fh, size_t fw)
+      : fh_(fh), fw_(fw), wc_(fw / 2 + 1), rows_(RealFftPlan::cached(fw)),
+        cols_(FftPlan::cached(fh)) {}
+
+  size_t spectrum_size() const { return fh_ * wc_; }
+
+  void forward(const float *in, Complex *out) const {
+    for (size_t r = 0; r < fh_; ++r) {
+      rows_->forward(in + r * fw_, out + r * wc_);
+    }
+    if (fh_ > 1) {
+      columns(out, false);
+    }
+  }
+
+  // Overwrites `in`.
+  void inverse(Complex *in, float *out) const {
+    if (fh_ > 1) {
+      columns(in, true);
+    }
+    for (size_t r = 0; r < fh_; ++r) {
+      rows_->inverse(in + r * wc_, out + r * fw_);
+    }
+  }
+
+private:
+  void columns(Complex *data, bool inverse) const {
+    WorkspaceScope workspace;
+    Complex *column = workspace.alloc<Complex>(fh_);
+    Complex *transformed = workspace.alloc<Complex>(fh_);
+    for (size_t c = 0; c < wc_; ++c) {
+      for (size_t r = 0; r < fh_; ++r) {
+        column[r] = data[r * wc_ + c];
+      }
+      if (inverse) {
+        cols_->inverse(column, transformed);
+      } else {
+        cols_->forward(column, transformed);
+      }
+      for (size_t r = 0; r < fh_; ++r) {
+        data[r * wc_ + c] = transformed[r];
+      }
+    }
+  }
+
+  size_t fh_;
+  size_t fw_;
+  size_t wc_;
+  std::shared_ptr<const RealFftPlan> rows_;
+  std::shared_ptr<const FftPlan> cols_;
+};
+
+/**
+ * Overlap-save correlation. Each task owns one `(batch, tile)` pair: it
+ * transforms the padded input block under the tile once per input channel,
+ * and for every output channel sums the products with the filter spectra and
+ * transforms back. Circular wrap-around only reaches the first `K - 1` rows
+ * and columns of the block, which are discarded, so output tiles are disjoint
+ * and need no synchronization.
+ */
+void correlate(const float *input, const float *weight, const float *bias,
+               float *output, const FftShape &s, size_t min_tile_h,
+               size_t min_tile_w) {
+  const size_t fh = tile_length(s.oh_, s.kh_, min_tile_h, false);
+  const size_t fw = tile_length(s.ow_, s.kw_, min_tile_w, true);
+  const size_t tile_h = fh - s.kh_ + 1;
+  const size_t tile_w = fw - s.kw_ + 1;
+  const size_t tiles_h = (s.oh_ + tile_h - 1) / tile_h;
+  const size_t tiles_w = (s.ow_ + tile_w - 1) / tile_w;
+  const Rfft2d fft(fh, fw);
+  const size_t spec = fft.spectrum_size();
+  const size_t block = fh * fw;
+  const size_t k_plane = s.kh_ * s.kw_;
+  const size_t in_plane = s.h_ * s.w_;
+  const size_t out_plane = s.oh_ * s.ow_;
+
+  const size_t pair_bytes =
+      std::max<size_t>(1, s.c_in_ * spec * sizeof(Complex));
+  const size_t oc_block =
+      std::max<size_t>(1, std::min(s.c_out_, kSpectrumBudget / pair_bytes));
+  WorkspaceScope workspace;
+  Complex *filters = workspace.alloc<Complex>(oc_block * s.c_in_ * spec);
+
+  for (size_t oc0 = 0; oc0 < s.c_out_; oc0 += oc_block) {
+    const size_t oc_n = std::min(oc_block, s.c_out_ - oc0);
+
+    // Spectra of the flipped filters, which turn the circular convolution
+    // into a correlation.
+    parallel_for(0, oc_n * s.c_in_, [&](size_t lo, size_t hi) {
+      WorkspaceScope scratch;
+      float *padded = scratch.alloc<float>(block);
+      for (size_t i = lo; i < hi; ++i) {
+        const float *w = weight + (oc0 * s.c_in_ + i) * k_plane;
+        std::fill(padded, padded + block, 0.0f);
+        for (size_t a = 0; a < s.kh_; ++a) {
+          for (size_t b = 0; b < s.kw_; ++b) {
+            padded[a * fw + b] = w[(s.kh_ - 1 - a) * s.kw_ + (s.kw_ - 1 - b)];
+          }
+        }
+        fft.forward(padded, filters + i * spec);
+      }
+    });
+
+    parallel_for(0, s.n_ * tiles_h * tiles_w, [&](size_t lo, size_t hi) {
+      WorkspaceScope scratch;
+      float *padded = scratch.alloc<float>(block);
+      Complex *inputs = scratch.alloc<Complex>(s.c_in_ * spec);
+      Complex *acc = scratch.alloc<Complex>(spec);
+      for (size_t task = lo; task < hi; ++task) {
+        const size_t b = task / (tiles_h * tiles_w);
+        const size_t h0 = task / tiles_w % tiles_h * tile_h;
+        const size_t w0 = task % tiles_w * tile_w;
+
+        // Block columns `[col_lo, col_hi)` fall inside the input rows.
+        const size_t col_lo = std::min(fw, s.pad_w_ > w0 ? s.pad_w_ - w0 : 0);
+        const size_t col_hi =
+            std::min(fw, s.w_ + s.pad_w_ > w0 ? s.w_ + s.pad_w_ - w0 : 0);
+        for (size_t ic = 0; ic < s.c_in_; ++ic) {
+          const float *plane = input + (b * s.c_in_ + ic) * in_plane;
+          std::fill(padded, padded + block, 0.0f);
+          for (size_t a = 0; a < fh; ++a) {
+            const size_t r = h0 + a;
+            if (r < s.pad_h_ || r - s.pad_h_ >= s.h_ || col_lo >= col_hi) {
+              continue;
+            }
+            const float *src =
+                plane + (r - s.pad_h_) * s.w_ + (w0 + col_lo - s.pad_w_);
+            std::copy(src, src + (col_hi - col_lo), padded + a * fw + col_lo);
+          }
+          fft.forward(padded, inputs + ic * spec);
+        }
+
+        const size_t rows = std::min(tile_h, s.oh_ - h0);
+        const size_t cols = std::min(tile_w, s.ow_ - w0);
+        for (size_t j = 0; j < oc_n; ++j) {
+          const size_t oc = oc0 + j;
+          const Complex *f = filters + j * s.c_in_ * spec;
+          std::fill(acc, acc + spec, Complex(0, 0));
+          for (size_t ic = 0; ic < s.c_in_; ++ic) {
+            const Complex *x = inputs + ic * spec;
+            const Complex *y = f + ic * spec;
+            for (size_t i = 0; i < spec; ++i) {
+              acc[i] += x[i] * y[i];
+            }
+          }
+          fft.inverse(acc, padded);
+
+          const float shift = bias ? bias[oc] : 0.0f;
+          float *out = output + (b * s.c_out_ + oc) * out_plane;
+          for (size_t i = 0; i < rows; ++i) {
+            const float *src = padded + (i + s.kh_ - 1) * fw + s.kw_ - 1;
+            float *dst = out + (h0 + i) * s.ow_ + w0;
+            for (size_t c = 0; c < cols; ++c) {
+              dst[c] = src[c] + shift;
+            }
+          }
+        }
+      }
+    });
+  }
+}
+
+void check_bias(const char *op, const FloatTensor *bias, size_t c_out) {
+  if (bias != nullptr && bias->numel_ != c_out) {
+    throw std::invalid_argument(std::string(op) + ": bias shape mismatch");
+  }
+}
+
+} // namespace
+
+/**
+ * @brief Computes `conv1d` through real FFTs.
+ *
+ * The filter spectra are computed once per call, and the padded input is cut
+ * into overlapping tiles that are transformed, multiplied and transformed
+ * back independently (overlap-save), so long signals need no FFT longer than
+ * a few kernel lengths. Only stride 1 is supported.
+ *
+ * @param input `[N, C_in, L]` input.
+ * @param weight `[C_out, C_in, K]` filter.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output `[N, C_out, OL]` output.
+ * @param params Stride and padding.
+ */
+void fft_conv1d(const FloatTensor &input, const FloatTensor &weight,
+                const FloatTensor *bias, FloatTensor &output,
+                const Conv1dParams &params) {
+  if (input.ndim_ != 3 || weight.ndim_ != 3 || output.ndim_ != 3) {
+    throw std::invalid_argument("fft_conv1d: expected 3-D tensors");
+  }
+  if (params.stride_ != 1) {
+    throw std::invalid_argument("fft_conv1d: only stride 1 is supported");
+  }
+  FftShape s = {input.size_[0], input.size_[1], weight.size_[0], 1,
+                input.size_[2], 1, weight.size_[2], 0, params.pad_, 1, 0};
+  s.ow_ = conv2d_output_size(s.w_, s.kw_, 1, s.pad_w_);
+  if (weight.size_[1] != s.c_in_ || output.size_[0] != s.n_ ||
+      output.size_[1] != s.c_out_ || output.size_[2] != s.ow_) {
+    throw std::invalid_argument("fft_conv1d: shape mismatch");
+  }
+  check_bias("fft_conv1d", bias, s.c_out_);
+  check_mutable("fft_conv1d", output);
+  if (s.ow_ == 0 || s.n_ == 0 || s.c_out_ == 0) {
+    return;
+  }
+  correlate(input.data_, weight.data_, bias ? bias->data_ : nullptr,
+            output.data_, s, 1, kMinTile1d);
+}
+
+/**
+ * @brief Computes `conv2d` through 2-D real FFTs.
+ *
+ * Uses the same overlap-save tiling as `fft_conv1d` over both spatial
+ * dimensions. Only stride 1 and `groups == 1` are supported.
+ *
+ * @param input `[N, C_in, H, W]` input.
+ * @param weight `[C_out, C_in, KH, KW]` filter.
+ * @param bias Optional `[C_out]` bias, may be `nullptr`.
+ * @param output `[N, C_out, OH, OW]` output.
+ * @param params Stride, padding and groups.
+ */
+void fft_conv2d(const FloatTensor &input, const FloatTensor &weight,
+                const FloatTensor *bias, FloatTensor &output,
+                const Conv2dParams &params) {
+  if (input.ndim_ != 4 || weight.ndim_ != 4 || output.ndim_ != 4) {
+    throw std::invalid_argument("fft_conv2d: expected 4-D tensors");
+  }
+  if (params.stride_h_ != 1 || params.stride_w_ != 1 || params.groups_ != 1) {
+    throw std::invalid_argument(
+        "fft_conv2d: only stride 1 and groups 1 are supported");
+  }
+  FftShape s = {input.size_[0],  input.size_[1],  weight.size_[0],
+                input.size_[2],  input.size_[3],  weight.size_[2],
+                weight.size_[3], params.pad_h_,   params.pad_w_,
+                0,               0};
+  s.oh_ = conv2d_output_size(s.h_, s.kh_, 1, s.pad_h_);
+  s.ow_ = conv2d_output_size(s.w_, s.kw_, 1, s.pad_w_);
+  if (weight.size_[1] != s.c_in_ || output.size_[0] != s.n_ ||
+      output.size_[1] != s.c_out_ || output.size_[2] != s.oh_ ||
+      output.size_[3] != s.ow_) {
+    throw std::invalid_argument("fft_conv2d: shape mismatch");
+  }
+  check_bias("fft_conv2d", bias, s.c_out_);
+  check_mutable("fft_conv2d", output);
+  if (s.oh_ == 0 || s.ow_ == 0 || s.n_ == 0 || s.c_out_ == 0) {
+    return;
+  }
+  correlate(input.data_, weight.data_, bias ? bias->data_ : nullptr,
+            output.data_, s, kMinTile2d, kMinTile2d);
+}
+
+} // namespace focus
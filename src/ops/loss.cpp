@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// loss.cpp
+//
+// Identification: src/ops/loss.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/loss.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Elements per partial sum of the element-wise losses. Fixed so the result
+// does not depend on the number of threads.
+const size_t kLossBlock = 4096;
+
+void check_same_shape(const char *op, const FloatTensor &a,
+                      const FloatTensor &b) {
+  if (a.ndim_ != b.ndim_ ||
+      !std::equal(a.size_, a.size_ + a.ndim_, b.size_)) {
+    throw std::invalid_argument(std::string(op) + ": shape mismatch");
+  }
+}
+
+/*
+ * Runs `fn(i) -> loss` over every element of `input`, optionally writing the
+ * gradient inside `fn`, and returns the mean loss.
+ */
+template <typename Fn>
+float elementwise_mean(const FloatTensor &input, Fn fn) {
+  const size_t n = input.numel_;
+  if (n == 0) {
+    return 0;
+  }
+  const size_t blocks = (n + kLossBlock - 1) / kLossBlock;
+  WorkspaceScope workspace;
+  double *partials = workspace.alloc<double>(blocks);
+  parallel_for(0, blocks, [&](size_t lo, size_t hi) {
+    for (size_t b = lo; b < hi; ++b) {
+      double sum = 0;
+      for (size_t i = b * kLossBlock; i < std::min(n, (b + 1) * kLossBlock);
+           ++i) {
+        sum += fn(i);
+      }
+      partials[b] = sum;
+    }
+  });
+  double total = 0;
+  for (size_t b = 0; b < blocks; ++b) {
+    total += partials[b];
+  }
+  return static_cast<float>(total / n);
+}
+
+} // namespace
+
+/**
+ * @brief Returns the mean softmax cross-entropy of `logits` against `targets`.
+ *
+ * `logits` is `[N, C]` and `targets` holds `N` class indices. With label
+ * smoothing `eps`, the target distribution is `(1 - eps)` on the target class
+ * plus `eps / C` on every class. Each row is read twice: once for a running
+ * log-sum-exp and once to write the gradient. If `logits.requires_grad_`, the
+ * gradient of the returned loss is added into `logits.grad_` in that second
+ * sweep. Rows are split across the thread pool.
+ *
+ * @param logits The unnormalized scores.
+ * @param targets The class of each row.
+ * @param label_smoothing The smoothing `eps` in `[0, 1]`.
+ * @return float
+ */
+float softmax_cross_entropy(FloatTensor &logits, const size_t *targets,
+                            float label_smoothing) {
+  if (logits.ndim_ != 2) {
+    throw std::invalid_argument("softmax_cross_entropy: expected [N, C]");
+  }
+  if (label_smoothing < 0 || label_smoothing > 1) {
+    throw std::invalid_argument(
+        "softmax_cross_entropy: label smoothing must be in [0, 1]");
+  }
+  const size_t rows = logits.size_[0];
+  const size_t classes = logits.size_[1];
+  for (size_t r = 0; r < rows; ++r) {
+    if (targets[r] >= classes) {
+      throw std::out_of_range("softmax_cross_entropy: target out of range");
+    }
+  }
+  if (rows == 0) {
+    return 0;
+  }
+
+  const float on_target = 1 - label_smoothing;
+  const float uniform = label_smoothing / classes;
+  const float grad_scale = 1.0f / rows;
+  const bool with_grad = logits.requires_grad_;
+  WorkspaceScope workspace;
+  double *row_loss = workspace.alloc<double>(rows);
+  parallel_for(0, rows, [&](size_t lo, size_t hi) {
+    for (size_t r = lo; r < hi; ++r) {
+      const float *z = logits.data_ + r * classes;
+
+      // Online log-sum-exp: the running sum is rescaled whenever the running
+      // maximum grows, so one sweep suffices.
+      float max = -std::numeric_limits<float>::infinity();
+      float sum = 0;
+      float total = 0;
+      for (size_t j = 0; j < classes; ++j) {
+        if (z[j] > max) {
+          sum = sum * std::exp(max - z[j]) + 1;
+          max = z[j];
+        } else {
+          sum += std::exp(z[j] - max);
+        }
+        total += z[j];
+      }
+      const float lse = max + std::log(sum);
+      row_loss[r] = lse - on_target * z[targets[r]] - uniform * total;
+
+      if (with_grad) {
+        float *g = logits.grad_ + r * classes;
+        for (size_t j = 0; j < classes; ++j) {
+          g[j] += (std::exp(z[j] - lse) - uniform) * grad_scale;
+        }
+        g[targets[r]] -= on_target * grad_scale;
+      }
+    }
+  });
+
+  double loss = 0;
+  for (size_t r = 0; r < rows; ++r) {
+    loss += row_loss[r];
+  }
+  return static_cast<float>(loss / rows);
+}
+
+/**
+ * @brief Returns the mean squared error between `input` and `target`.
+ *
+ * If `input.requires_grad_`, the gradient of the returned loss is added into
+ * `input.grad_` in the same pass.
+ *
+ * @param input The predictions.
+ * @param target The expected values, shaped like `input`.
+ * @return float
+ */
+float mse_loss(FloatTensor &input, const FloatTensor &target) {
+  check_same_shape("mse_loss", input, target);
+  const float grad_scale = 2.0f / std::max<size_t>(1, input.numel_);
+  const float *x = input.data_;
+  const float *y = target.data_;
+  float *g = input.requires_grad_ ? input.grad_ : nullptr;
+  return elementwise_mean(input, [&](size_t i) {
+    const float diff = x[i] - y[i];
+    if (g) {
+      g[i] += diff * grad_scale;
+    }
+    return static_cast<double>(diff) * diff;
+  });
+}
+
+/**
+ * @brief Returns the mean binary cross-entropy of `sigmoid(logits)` against
+ * `target`.
+ *
+ * Computed directly on the logits as `max(x, 0) - x y + log(1 + exp(-|x|))`,
+ * which cannot overflow. If `logits.requires_grad_`, the gradient of the
+ * returned loss is added into `logits.grad_` in the same pass.
+ *
+ * @param logits The unnormalized scores.
+ * @param target The probabilities in `[0, 1]`, shaped like `logits`.
+ * @return float
+ */
+float binary_cross_entropy_with_logits(FloatTensor &logits,
+                                       const FloatTensor &target) {
+  check_same_shape("binary_cross_entropy_with_logits", logits, target);
+  const float grad_scale = 1.0f / std::max<size_t>(1, logits.numel_);
+  const float *x = logits.data_;
+  const float *y = target.data_;
+  float *g = logits.requires_grad_ ? logits.grad_ : nullptr;
+  return elementwise_mean(logits, [&](size_t i) {
+    // exp(-|x|) is shared by the loss and by a sigmoid that stays in range
+    // for either sign of x.
+    const float e = std::exp(-std::fabs(x[i]));
+    if (g) {
+      const float sigmoid = x[i] >= 0 ? 1 / (1 + e) : e / (1 + e);
+      g[i] += (sigmoid - y[i]) * grad_scale;
+    }
+    return static_cast<double>(std::max(x[i], 0.0f) - x[i] * y[i] +
+                               std::log1p(e));
+  });
+}
+
+} // namespace focus
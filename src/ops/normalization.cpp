@@ -0,0 +1,584 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// normalization.cpp
+//
+// Identification: src/ops/normalization.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/normalization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Independent Welford accumulators per span; interleaving them removes the
+// loop-carried dependency so the update vectorizes.
+const size_t kLanes = 8;
+
+/*
+ * Count, mean and sum of squared deviations of a stream of values. Spans are
+ * folded in with per-lane Welford updates and the lanes are combined with
+ * the pairwise formula of Chan et al., so a single pass is numerically stable.
+ */
+struct Moments {
+  double count_ = 0;
+  double mean_ = 0;
+  double m2_ = 0;
+
+  void merge(double count, double mean, double m2) {
+    if (count == 0) {
+      return;
+    }
+    const double total = count_ + count;
+    const double delta = mean - mean_;
+    mean_ += delta * count / total;
+    m2_ += m2 + delta * delta * count_ * count / total;
+    count_ = total;
+  }
+
+  void add(const float *x, size_t n) {
+    float mean[kLanes] = {};
+    float m2[kLanes] = {};
+    const size_t blocks = n / kLanes;
+    for (size_t b = 0; b < blocks; ++b) {
+      const float inv = 1.0f / (b + 1);
+      const float *xb = x + b * kLanes;
+      for (size_t l = 0; l < kLanes; ++l) {
+        const float delta = xb[l] - mean[l];
+        mean[l] += delta * inv;
+        m2[l] += delta * (xb[l] - mean[l]);
+      }
+    }
+    for (size_t l = 0; l < kLanes; ++l) {
+      merge(blocks, mean[l], m2[l]);
+    }
+    for (size_t i = blocks * kLanes; i < n; ++i) {
+      merge(1, x[i], 0);
+    }
+  }
+
+  // Biased variance.
+  double variance() const { return count_ > 0 ? m2_ / count_ : 0; }
+};
+
+void check_same_shape(const char *op, const FloatTensor &a,
+                      const FloatTensor &b) {
+  if (a.ndim_ != b.ndim_ ||
+      !std::equal(a.size_, a.size_ + a.ndim_, b.size_)) {
+    throw std::invalid_argument(std::string(op) + ": shape mismatch");
+  }
+}
+
+void check_numel(const char *op, const FloatTensor *t, size_t numel) {
+  if (t != nullptr && t->numel_ != numel) {
+    throw std::invalid_argument(std::string(op) +
+                                ": parameter shape mismatch");
+  }
+}
+
+void check_backward(const char *op, const FloatTensor &output,
+                    const FloatTensor &input, const FloatTensor *weight,
+                    const FloatTensor *bias, const float *save_mean,
+                    const float *save_invstd) {
+  check_same_shape(op, input, output);
+  if (!output.requires_grad_ || !input.requires_grad_ ||
+      (weight != nullptr && !weight->requires_grad_) ||
+      (bias != nullptr && !bias->requires_grad_)) {
+    throw std::invalid_argument(std::string(op) +
+                                ": output, input and parameters must "
+                                "require grad");
+  }
+  if (save_mean == nullptr || save_invstd == nullptr) {
+    throw std::invalid_argument(std::string(op) +
+                                ": saved statistics are required");
+  }
+}
+
+inline float weight_at(const FloatTensor *t, size_t i) {
+  return t != nullptr ? t->data_[i] : 1.0f;
+}
+
+inline float bias_at(const FloatTensor *t, size_t i) {
+  return t != nullptr ? t->data_[i] : 0.0f;
+}
+
+// `[N, C, S]` view of channel-first input.
+struct ChannelShape {
+  size_t n_;
+  size_t c_;
+  size_t s_;
+};
+
+ChannelShape resolve_channels(const char *op, const FloatTensor &input) {
+  if (input.ndim_ < 2) {
+    throw std::invalid_argument(std::string(op) + ": expected [N, C, ...]");
+  }
+  ChannelShape s = {input.size_[0], input.size_[1], 1};
+  for (size_t d = 2; d < input.ndim_; ++d) {
+    s.s_ *= input.size_[d];
+  }
+  return s;
+}
+
+} // namespace
+
+/**
+ * @brief Normalizes every channel of `[N, C, ...]` input over the batch and
+ * spatial positions.
+ *
+ * In training the per-channel mean and variance are computed in one Welford
+ * pass, and the running averages are updated when given (the running variance
+ * is unbiased). Otherwise the running statistics are used. The normalization
+ * and affine transform are then applied in one pass over the input.
+ * Statistics are split across the thread pool by channel and the output pass
+ * by `(n, c)` plane.
+ *
+ * @param input The input tensor.
+ * @param weight Optional `[C]` scale, may be `nullptr`.
+ * @param bias Optional `[C]` shift, may be `nullptr`.
+ * @param running_mean Optional `[C]` running mean, may be `nullptr` in
+ * training.
+ * @param running_var Optional `[C]` running variance, may be `nullptr` in
+ * training.
+ * @param save_mean Optional, receives the `C` means used, for the backward.
+ * @param save_invstd Optional, receives the `C` inverse standard deviations
+ * used, for the backward.
+ * @param output The output tensor, shaped like `input`.
+ * @param params Epsilon, momentum and mode.
+ */
+void batch_norm(const FloatTensor &input, const FloatTensor *weight,
+                const FloatTensor *bias, FloatTensor *running_mean,
+                FloatTensor *running_var, float *save_mean,
+                float *save_invstd, FloatTensor &output,
+                const BatchNormParams &params) {
+  ChannelShape s = resolve_channels("batch_norm", input);
+  check_same_shape("batch_norm", input, output);
+  check_mutable("batch_norm", output);
+  check_numel("batch_norm", weight, s.c_);
+  check_numel("batch_norm", bias, s.c_);
+  check_numel("batch_norm", running_mean, s.c_);
+  check_numel("batch_norm", running_var, s.c_);
+  if (!params.training_ && (!running_mean || !running_var)) {
+    throw std::invalid_argument(
+        "batch_norm: running statistics are required in evaluation");
+  }
+  // Training updates the running statistics in place.
+  if (params.training_ && running_mean != nullptr) {
+    check_mutable("batch_norm", *running_mean);
+  }
+  if (params.training_ && running_var != nullptr) {
+    check_mutable("batch_norm", *running_var);
+  }
+
+  WorkspaceScope workspace;
+  float *mean = workspace.alloc<float>(s.c_);
+  float *invstd = workspace.alloc<float>(s.c_);
+  const double count = static_cast<double>(s.n_) * s.s_;
+  parallel_for(0, s.c_, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c < hi; ++c) {
+      if (!params.training_) {
+        mean[c] = running_mean->data_[c];
+        invstd[c] = 1.0f / std::sqrt(running_var->data_[c] + params.eps_);
+        continue;
+      }
+      Moments m;
+      for (size_t n = 0; n < s.n_; ++n) {
+        m.add(input.data_ + (n * s.c_ + c) * s.s_, s.s_);
+      }
+      mean[c] = static_cast<float>(m.mean_);
+      invstd[c] =
+          static_cast<float>(1.0 / std::sqrt(m.variance() + params.eps_));
+      if (running_mean != nullptr) {
+        float &rm = running_mean->data_[c];
+        rm = (1 - params.momentum_) * rm + params.momentum_ * mean[c];
+      }
+      if (running_var != nullptr) {
+        const double unbiased =
+            count > 1 ? m.m2_ / (count - 1) : m.variance();
+        float &rv = running_var->data_[c];
+        rv = static_cast<float>((1 - params.momentum_) * rv +
+                                params.momentum_ * unbiased);
+      }
+    }
+  });
+  if (save_mean != nullptr) {
+    std::copy(mean, mean + s.c_, save_mean);
+  }
+  if (save_invstd != nullptr) {
+    std::copy(invstd, invstd + s.c_, save_invstd);
+  }
+
+  parallel_for(0, s.n_ * s.c_, [&](size_t lo, size_t hi) {
+    for (size_t p = lo; p < hi; ++p) {
+      const size_t c = p % s.c_;
+      const float scale = weight_at(weight, c) * invstd[c];
+      const float shift = bias_at(bias, c) - mean[c] * scale;
+      const float *x = input.data_ + p * s.s_;
+      float *y = output.data_ + p * s.s_;
+      for (size_t i = 0; i < s.s_; ++i) {
+        y[i] = x[i] * scale + shift;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Accumulates the gradients of a training-mode `batch_norm`.
+ *
+ * Reads `output.grad_` and adds into `input.grad_`, and into `weight->grad_`
+ * and `bias->grad_` when given.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param save_mean The means saved by the forward.
+ * @param save_invstd The inverse standard deviations saved by the forward.
+ * @param input The forward input, receiving the gradient.
+ * @param weight Optional scale receiving the gradient, may be `nullptr`.
+ * @param bias Optional shift receiving the gradient, may be `nullptr`.
+ */
+void batch_norm_backward(const FloatTensor &output, const float *save_mean,
+                         const float *save_invstd, FloatTensor &input,
+                         FloatTensor *weight, FloatTensor *bias) {
+  ChannelShape s = resolve_channels("batch_norm_backward", input);
+  check_backward("batch_norm_backward", output, input, weight, bias,
+                 save_mean, save_invstd);
+  check_numel("batch_norm_backward", weight, s.c_);
+  check_numel("batch_norm_backward", bias, s.c_);
+
+  // Per channel: sum(dy) and sum(dy * xhat).
+  WorkspaceScope workspace;
+  float *sum_dy = workspace.alloc<float>(s.c_);
+  float *sum_dy_xhat = workspace.alloc<float>(s.c_);
+  parallel_for(0, s.c_, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c < hi; ++c) {
+      double a = 0;
+      double b = 0;
+      for (size_t n = 0; n < s.n_; ++n) {
+        const float *x = input.data_ + (n * s.c_ + c) * s.s_;
+        const float *dy = output.grad_ + (n * s.c_ + c) * s.s_;
+        float pa = 0;
+        float pb = 0;
+        for (size_t i = 0; i < s.s_; ++i) {
+          pa += dy[i];
+          pb += dy[i] * (x[i] - save_mean[c]);
+        }
+        a += pa;
+        b += pb;
+      }
+      sum_dy[c] = static_cast<float>(a);
+      sum_dy_xhat[c] = static_cast<float>(b * save_invstd[c]);
+      if (weight != nullptr) {
+        weight->grad_[c] += sum_dy_xhat[c];
+      }
+      if (bias != nullptr) {
+        bias->grad_[c] += sum_dy[c];
+      }
+    }
+  });
+
+  const float inv_count = 1.0f / std::max<size_t>(1, s.n_ * s.s_);
+  parallel_for(0, s.n_ * s.c_, [&](size_t lo, size_t hi) {
+    for (size_t p = lo; p < hi; ++p) {
+      const size_t c = p % s.c_;
+      const float k = weight_at(weight, c) * save_invstd[c];
+      const float mean_dy = sum_dy[c] * inv_count;
+      const float mean_dy_xhat = sum_dy_xhat[c] * inv_count;
+      const float *x = input.data_ + p * s.s_;
+      const float *dy = output.grad_ + p * s.s_;
+      float *dx = input.grad_ + p * s.s_;
+      for (size_t i = 0; i < s.s_; ++i) {
+        const float xhat = (x[i] - save_mean[c]) * save_invstd[c];
+        dx[i] += k * (dy[i] - mean_dy - xhat * mean_dy_xhat);
+      }
+    }
+  });
+}
+
+/**
+ * @brief Normalizes every row of `input` over its last dimension.
+ *
+ * Each row's mean and variance are computed in one Welford pass and the
+ * normalization and `[D]` affine transform in a second fused pass. Rows are
+ * split across the thread pool.
+ *
+ * @param input The input tensor, `[..., D]`.
+ * @param weight Optional `[D]` scale, may be `nullptr`.
+ * @param bias Optional `[D]` shift, may be `nullptr`.
+ * @param eps Added to the variance before taking the square root.
+ * @param save_mean Optional, receives one mean per row.
+ * @param save_invstd Optional, receives one inverse standard deviation per
+ * row.
+ * @param output The output tensor, shaped like `input`.
+ */
+void layer_norm(const FloatTensor &input, const FloatTensor *weight,
+                const FloatTensor *bias, float eps, float *save_mean,
+                float *save_invstd, FloatTensor &output) {
+  if (input.ndim_ == 0) {
+    throw std::invalid_argument("layer_norm: expected at least 1-D input");
+  }
+  check_same_shape("layer_norm", input, output);
+  check_mutable("layer_norm", output);
+  const size_t d = input.size_[input.ndim_ - 1];
+  check_numel("layer_norm", weight, d);
+  check_numel("layer_norm", bias, d);
+  const size_t rows = d ? input.numel_ / d : 0;
+
+  parallel_for(0, rows, [&](size_t lo, size_t hi) {
+    for (size_t r = lo; r < hi; ++r) {
+      const float *x = input.data_ + r * d;
+      float *y = output.data_ + r * d;
+      Moments m;
+      m.add(x, d);
+      const float mean = static_cast<float>(m.mean_);
+      const float invstd =
+          static_cast<float>(1.0 / std::sqrt(m.variance() + eps));
+      for (size_t j = 0; j < d; ++j) {
+        y[j] = (x[j] - mean) * invstd * weight_at(weight, j) +
+               bias_at(bias, j);
+      }
+      if (save_mean != nullptr) {
+        save_mean[r] = mean;
+      }
+      if (save_invstd != nullptr) {
+        save_invstd[r] = invstd;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Accumulates the gradients of `layer_norm`.
+ *
+ * Reads `output.grad_` and adds into `input.grad_`, and into `weight->grad_`
+ * and `bias->grad_` when given. The parameter gradients are summed in
+ * per-thread partial buffers and reduced at the end.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param save_mean The means saved by the forward.
+ * @param save_invstd The inverse standard deviations saved by the forward.
+ * @param input The forward input, receiving the gradient.
+ * @param weight Optional scale receiving the gradient, may be `nullptr`.
+ * @param bias Optional shift receiving the gradient, may be `nullptr`.
+ */
+void layer_norm_backward(const FloatTensor &output, const float *save_mean,
+                         const float *save_invstd, FloatTensor &input,
+                         FloatTensor *weight, FloatTensor *bias) {
+  if (input.ndim_ == 0) {
+    throw std::invalid_argument(
+        "layer_norm_backward: expected at least 1-D input");
+  }
+  check_backward("layer_norm_backward", output, input, weight, bias,
+                 save_mean, save_invstd);
+  const size_t d = input.size_[input.ndim_ - 1];
+  check_numel("layer_norm_backward", weight, d);
+  check_numel("layer_norm_backward", bias, d);
+  const size_t rows = d ? input.numel_ / d : 0;
+
+  const size_t parts =
+      std::max<size_t>(1, std::min(rows, ThreadPool::global().num_threads()));
+  WorkspaceScope workspace;
+  float *partials = workspace.alloc<float>(parts * 2 * d);
+  std::fill(partials, partials + parts * 2 * d, 0.0f);
+
+  parallel_for(0, parts, [&](size_t part_lo, size_t part_hi) {
+    WorkspaceScope scratch;
+    float *g = scratch.alloc<float>(d);
+    for (size_t part = part_lo; part < part_hi; ++part) {
+      float *gw = partials + part * 2 * d;
+      float *gb = gw + d;
+      for (size_t r = rows * part / parts; r < rows * (part + 1) / parts;
+           ++r) {
+        const float *x = input.data_ + r * d;
+        const float *dy = output.grad_ + r * d;
+        float *dx = input.grad_ + r * d;
+        const float mean = save_mean[r];
+        const float invstd = save_invstd[r];
+
+        float sum_g = 0;
+        float sum_g_xhat = 0;
+        for (size_t j = 0; j < d; ++j) {
+          const float xhat = (x[j] - mean) * invstd;
+          g[j] = dy[j] * weight_at(weight, j);
+          sum_g += g[j];
+          sum_g_xhat += g[j] * xhat;
+          gw[j] += dy[j] * xhat;
+          gb[j] += dy[j];
+        }
+        const float mean_g = sum_g / d;
+        const float mean_g_xhat = sum_g_xhat / d;
+        for (size_t j = 0; j < d; ++j) {
+          const float xhat = (x[j] - mean) * invstd;
+          dx[j] += invstd * (g[j] - mean_g - xhat * mean_g_xhat);
+        }
+      }
+    }
+  });
+
+  // Reduce the per-thread partials.
+  for (size_t part = 0; part < parts; ++part) {
+    const float *gw = partials + part * 2 * d;
+    for (size_t j = 0; j < d; ++j) {
+      if (weight != nullptr) {
+        weight->grad_[j] += gw[j];
+      }
+      if (bias != nullptr) {
+        bias->grad_[j] += gw[d + j];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Normalizes `[N, C, ...]` input over groups of `C / groups` channels.
+ *
+ * Each `(n, group)` is a contiguous span, reduced in one Welford pass and then
+ * normalized with the per-channel affine transform in a second fused pass.
+ * Spans are split across the thread pool.
+ *
+ * @param input The input tensor.
+ * @param groups Number of channel groups; must divide `C`.
+ * @param weight Optional `[C]` scale, may be `nullptr`.
+ * @param bias Optional `[C]` shift, may be `nullptr`.
+ * @param eps Added to the variance before taking the square root.
+ * @param save_mean Optional, receives `N * groups` means.
+ * @param save_invstd Optional, receives `N * groups` inverse standard
+ * deviations.
+ * @param output The output tensor, shaped like `input`.
+ */
+void group_norm(const FloatTensor &input, size_t groups,
+                const FloatTensor *weight, const FloatTensor *bias, float eps,
+                float *save_mean, float *save_invstd, FloatTensor &output) {
+  ChannelShape s = resolve_channels("group_norm", input);
+  check_same_shape("group_norm", input, output);
+  check_mutable("group_norm", output);
+  if (groups == 0 || s.c_ % groups != 0) {
+    throw std::invalid_argument("group_norm: groups must divide channels");
+  }
+  check_numel("group_norm", weight, s.c_);
+  check_numel("group_norm", bias, s.c_);
+  const size_t cg = s.c_ / groups;
+
+  parallel_for(0, s.n_ * groups, [&](size_t lo, size_t hi) {
+    for (size_t p = lo; p < hi; ++p) {
+      const float *x = input.data_ + p * cg * s.s_;
+      float *y = output.data_ + p * cg * s.s_;
+      Moments m;
+      m.add(x, cg * s.s_);
+      const float mean = static_cast<float>(m.mean_);
+      const float invstd =
+          static_cast<float>(1.0 / std::sqrt(m.variance() + eps));
+      for (size_t i = 0; i < cg; ++i) {
+        const size_t c = (p % groups) * cg + i;
+        const float scale = weight_at(weight, c) * invstd;
+        const float shift = bias_at(bias, c) - mean * scale;
+        for (size_t j = i * s.s_; j < (i + 1) * s.s_; ++j) {
+          y[j] = x[j] * scale + shift;
+        }
+      }
+      if (save_mean != nullptr) {
+        save_mean[p] = mean;
+      }
+      if (save_invstd != nullptr) {
+        save_invstd[p] = invstd;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Accumulates the gradients of `group_norm`.
+ *
+ * Reads `output.grad_` and adds into `input.grad_`, and into `weight->grad_`
+ * and `bias->grad_` when given.
+ *
+ * @param output The forward output, holding the incoming gradient.
+ * @param groups Number of channel groups used by the forward.
+ * @param save_mean The means saved by the forward.
+ * @param save_invstd The inverse standard deviations saved by the forward.
+ * @param input The forward input, receiving the gradient.
+ * @param weight Optional scale receiving the gradient, may be `nullptr`.
+ * @param bias Optional shift receiving the gradient, may be `nullptr`.
+ */
+void group_norm_backward(const FloatTensor &output, size_t groups,
+                         const float *save_mean, const float *save_invstd,
+                         FloatTensor &input, FloatTensor *weight,
+                         FloatTensor *bias) {
+  ChannelShape s = resolve_channels("group_norm_backward", input);
+  check_backward("group_norm_backward", output, input, weight, bias,
+                 save_mean, save_invstd);
+  if (groups == 0 || s.c_ % groups != 0) {
+    throw std::invalid_argument(
+        "group_norm_backward: groups must divide channels");
+  }
+  check_numel("group_norm_backward", weight, s.c_);
+  check_numel("group_norm_backward", bias, s.c_);
+  const size_t cg = s.c_ / groups;
+  const size_t span = cg * s.s_;
+
+  parallel_for(0, s.n_ * groups, [&](size_t lo, size_t hi) {
+    for (size_t p = lo; p < hi; ++p) {
+      const float *x = input.data_ + p * span;
+      const float *dy = output.grad_ + p * span;
+      float *dx = input.grad_ + p * span;
+      const float mean = save_mean[p];
+      const float invstd = save_invstd[p];
+
+      float sum_g = 0;
+      float sum_g_xhat = 0;
+      for (size_t i = 0; i < cg; ++i) {
+        const float w = weight_at(weight, (p % groups) * cg + i);
+        for (size_t j = i * s.s_; j < (i + 1) * s.s_; ++j) {
+          const float g = dy[j] * w;
+          sum_g += g;
+          sum_g_xhat += g * (x[j] - mean) * invstd;
+        }
+      }
+      const float mean_g = span ? sum_g / span : 0.0f;
+      const float mean_g_xhat = span ? sum_g_xhat / span : 0.0f;
+      for (size_t i = 0; i < cg; ++i) {
+        const float w = weight_at(weight, (p % groups) * cg + i);
+        for (size_t j = i * s.s_; j < (i + 1) * s.s_; ++j) {
+          const float xhat = (x[j] - mean) * invstd;
+          dx[j] += invstd * (dy[j] * w - mean_g - xhat * mean_g_xhat);
+        }
+      }
+    }
+  });
+
+  if (weight == nullptr && bias == nullptr) {
+    return;
+  }
+  parallel_for(0, s.c_, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c < hi; ++c) {
+      float gw = 0;
+      float gb = 0;
+      for (size_t n = 0; n < s.n_; ++n) {
+        const size_t p = n * groups + c / cg;
+        const float *x = input.data_ + (n * s.c_ + c) * s.s_;
+        const float *dy = output.grad_ + (n * s.c_ + c) * s.s_;
+        for (size_t j = 0; j < s.s_; ++j) {
+          gw += dy[j] * (x[j] - save_mean[p]) * save_invstd[p];
+          gb += dy[j];
+        }
+      }
+      if (weight != nullptr) {
+        weight->grad_[c] += gw;
+      }
+      if (bias != nullptr) {
+        bias->grad_[c] += gb;
+      }
+    }
+  });
+}
+
+} // namespace focus
@@ -0,0 +1,282 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// pooling.cpp
+//
+// Identification: src/ops/pooling.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/pooling.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+#include "ops/conv2d.h"
+
+namespace focus {
+
+namespace {
+
+// Floats per lane of the global reductions; independent accumulators let the
+// compiler keep several vector registers in flight.
+const size_t kReduceLanes = 8;
+
+struct PoolShape {
+  size_t planes_;
+  size_t h_;
+  size_t w_;
+  size_t oh_;
+  size_t ow_;
+};
+
+PoolShape resolve_shape(const char *op, const FloatTensor &input,
+                        const FloatTensor &output,
+                        const Pool2dParams &params) {
+  if (input.ndim_ != 4 || output.ndim_ != 4) {
+    throw std::invalid_argument(std::string(op) + ": expected NCHW tensors");
+  }
+  if (params.kernel_h_ == 0 || params.kernel_w_ == 0 ||
+      params.stride_h_ == 0 || params.stride_w_ == 0 ||
+      params.pad_h_ >= params.kernel_h_ || params.pad_w_ >= params.kernel_w_) {
+    throw std::invalid_argument(std::string(op) + ": invalid window");
+  }
+  PoolShape s;
+  s.planes_ = input.size_[0] * input.size_[1];
+  s.h_ = input.size_[2];
+  s.w_ = input.size_[3];
+  s.oh_ = conv2d_output_size(s.h_, params.kernel_h_, params.stride_h_,
+                             params.pad_h_);
+  s.ow_ = conv2d_output_size(s.w_, params.kernel_w_, params.stride_w_,
+                             params.pad_w_);
+  if (output.size_[0] != input.size_[0] || output.size_[1] != input.size_[1] ||
+      output.size_[2] != s.oh_ || output.size_[3] != s.ow_) {
+    throw std::invalid_argument(std::string(op) + ": output shape mismatch");
+  }
+  check_mutable(op, output);
+  return s;
+}
+
+/*
+ * Visits every window of every plane row by row. For each output row and
+ * each kernel tap, `tap(first, lo, hi, stride)` is called with the range of
+ * output columns `[lo, hi)` whose input column is in bounds and a pointer to
+ * the input under column `lo`, so `tap` can apply the tap to the whole range
+ * in one loop. `begin_row` and `end_row` bracket each output row. Each
+ * worker gets its own copy of `visitor`, whose row buffers `reserve` takes
+ * from that worker's workspace.
+ */
+template <typename Visitor>
+void pool_rows(const FloatTensor &input, FloatTensor &output,
+               const PoolShape &s, const Pool2dParams &params,
+               Visitor visitor) {
+  parallel_for(0, s.planes_ * s.oh_, [&](size_t lo, size_t hi) {
+    WorkspaceScope scratch;
+    Visitor v = visitor;
+    v.reserve(scratch, s.ow_);
+    for (size_t task = lo; task < hi; ++task) {
+      const size_t plane = task / s.oh_;
+      const size_t oh = task % s.oh_;
+      const float *in = input.data_ + plane * s.h_ * s.w_;
+      float *out = output.data_ + (plane * s.oh_ + oh) * s.ow_;
+      v.begin_row(s.ow_);
+      for (size_t kh = 0; kh < params.kernel_h_; ++kh) {
+        const size_t ih = oh * params.stride_h_ + kh;
+        if (ih < params.pad_h_ || ih - params.pad_h_ >= s.h_) {
+          continue;
+        }
+        const float *row = in + (ih - params.pad_h_) * s.w_;
+        for (size_t kw = 0; kw < params.kernel_w_; ++kw) {
+          // Output columns with `pad_w <= ow * stride + kw < pad_w + W`.
+          size_t ow_lo = 0;
+          if (kw < params.pad_w_) {
+            ow_lo = (params.pad_w_ - kw + params.stride_w_ - 1) /
+                    params.stride_w_;
+          }
+          size_t ow_hi = 0;
+          if (s.w_ + params.pad_w_ > kw) {
+            ow_hi = std::min(
+                s.ow_, (s.w_ + params.pad_w_ - kw - 1) / params.stride_w_ + 1);
+          }
+          if (ow_lo < ow_hi) {
+            v.tap(row + ow_lo * params.stride_w_ + kw - params.pad_w_, ow_lo,
+                  ow_hi, params.stride_w_);
+          }
+        }
+      }
+      v.end_row(out, s.ow_);
+    }
+  });
+}
+
+struct MaxVisitor {
+  float *acc_;
+
+  void reserve(WorkspaceScope &scratch, size_t ow) {
+    acc_ = scratch.alloc<float>(ow);
+  }
+
+  void begin_row(size_t ow) {
+    std::fill(acc_, acc_ + ow, -std::numeric_limits<float>::infinity());
+  }
+
+  void tap(const float *first, size_t lo, size_t hi, size_t stride) {
+    for (size_t ow = lo; ow < hi; ++ow) {
+      acc_[ow] = std::max(acc_[ow], first[(ow - lo) * stride]);
+    }
+  }
+
+  void end_row(float *out, size_t ow) {
+    std::copy(acc_, acc_ + ow, out);
+  }
+};
+
+struct AvgVisitor {
+  float *acc_;
+  float *count_;
+
+  void reserve(WorkspaceScope &scratch, size_t ow) {
+    acc_ = scratch.alloc<float>(ow);
+    count_ = scratch.alloc<float>(ow);
+  }
+
+  void begin_row(size_t ow) {
+    std::fill(acc_, acc_ + ow, 0.0f);
+    std::fill(count_, count_ + ow, 0.0f);
+  }
+
+  void tap(const float *first, size_t lo, size_t hi, size_t stride) {
+    for (size_t ow = lo; ow < hi; ++ow) {
+      acc_[ow] += first[(ow - lo) * stride];
+      count_[ow] += 1;
+    }
+  }
+
+  void end_row(float *out, size_t ow) {
+    for (size_t i = 0; i < ow; ++i) {
+      out[i] = count_[i] > 0 ? acc_[i] / count_[i] : 0.0f;
+    }
+  }
+};
+
+void check_global(const char *op, const FloatTensor &input,
+                  const FloatTensor &output) {
+  if (input.ndim_ != 4) {
+    throw std::invalid_argument(std::string(op) + ": expected NCHW input");
+  }
+  if (output.numel_ != input.size_[0] * input.size_[1]) {
+    throw std::invalid_argument(std::string(op) + ": output shape mismatch");
+  }
+  check_mutable(op, output);
+}
+
+} // namespace
+
+/**
+ * @brief Takes the maximum over each window of an NCHW input.
+ *
+ * `input` is `[N, C, H, W]` and `output` must already be shaped
+ * `[N, C, OH, OW]` as given by `conv2d_output_size`. Every kernel tap is
+ * applied to a whole output row at once, so the inner loop runs across output
+ * columns. Planes are split across the thread pool.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ * @param params Window, stride and padding.
+ */
+void max_pool2d(const FloatTensor &input, FloatTensor &output,
+                const Pool2dParams &params) {
+  PoolShape s = resolve_shape("max_pool2d", input, output, params);
+  pool_rows(input, output, s, params, MaxVisitor());
+}
+
+/**
+ * @brief Averages each window of an NCHW input.
+ *
+ * Shaped and parallelized like `max_pool2d`. Padded positions are excluded
+ * from the count each window is divided by.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ * @param params Window, stride and padding.
+ */
+void avg_pool2d(const FloatTensor &input, FloatTensor &output,
+                const Pool2dParams &params) {
+  PoolShape s = resolve_shape("avg_pool2d", input, output, params);
+  pool_rows(input, output, s, params, AvgVisitor());
+}
+
+/**
+ * @brief Averages every plane of an NCHW input.
+ *
+ * `input` is `[N, C, H, W]` and `output` must hold `N * C` elements.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ */
+void global_avg_pool2d(const FloatTensor &input, FloatTensor &output) {
+  check_global("global_avg_pool2d", input, output);
+  const size_t plane = input.size_[2] * input.size_[3];
+  parallel_for(0, output.numel_, [&](size_t lo, size_t hi) {
+    for (size_t p = lo; p < hi; ++p) {
+      const float *in = input.data_ + p * plane;
+      float acc[kReduceLanes] = {};
+      size_t i = 0;
+      for (; i + kReduceLanes <= plane; i += kReduceLanes) {
+        for (size_t l = 0; l < kReduceLanes; ++l) {
+          acc[l] += in[i + l];
+        }
+      }
+      float sum = 0;
+      for (; i < plane; ++i) {
+        sum += in[i];
+      }
+      for (size_t l = 0; l < kReduceLanes; ++l) {
+        sum += acc[l];
+      }
+      output.data_[p] = plane ? sum / plane : 0.0f;
+    }
+  });
+}
+
+/**
+ * @brief Takes the maximum of every plane of an NCHW input.
+ *
+ * `input` is `[N, C, H, W]` and `output` must hold `N * C` elements.
+ *
+ * @param input The input tensor.
+ * @param output The output tensor.
+ */
+void global_max_pool2d(const FloatTensor &input, FloatTensor &output) {
+  check_global("global_max_pool2d", input, output);
+  const size_t plane = input.size_[2] * input.size_[3];
+  const float lowest = -std::numeric_limits<float>::infinity();
+  parallel_for(0, output.numel_, [&](size_t lo, size_t hi) {
+    for (size_t p = lo; p < hi; ++p) {
+      const float *in = input.data_ + p * plane;
+      float acc[kReduceLanes];
+      std::fill(acc, acc + kReduceLanes, lowest);
+      size_t i = 0;
+      for (; i + kReduceLanes <= plane; i += kReduceLanes) {
+        for (size_t l = 0; l < kReduceLanes; ++l) {
+          acc[l] = std::max(acc[l], in[i + l]);
+        }
+      }
+      float best = lowest;
+      for (; i < plane; ++i) {
+        best = std::max(best, in[i]);
+      }
+      for (size_t l = 0; l < kReduceLanes; ++l) {
+        best = std::max(best, acc[l]);
+      }
+      output.data_[p] = best;
+    }
+  });
+}
+
+} // namespace focus
@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// preprocess.cpp
+//
+// Identification: src/ops/preprocess.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/preprocess.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+/**
+ * Source sampling positions along one axis. Output position `o` blends source
+ * positions `lo_[o]` and `hi_[o]` with weight `frac_[o]` on `hi_[o]`.
+ */
+struct AxisMap {
+  size_t *lo_;
+  size_t *hi_;
+  float *frac_;
+};
+
+// Half-pixel centers, matching the usual `align_corners = false` resize.
+void build_axis_map(size_t offset, size_t in, size_t out, AxisMap &map,
+                    WorkspaceScope &workspace) {
+  map.lo_ = workspace.alloc<size_t>(out);
+  map.hi_ = workspace.alloc<size_t>(out);
+  map.frac_ = workspace.alloc<float>(out);
+  const float ratio = static_cast<float>(in) / static_cast<float>(out);
+  for (size_t o = 0; o < out; ++o) {
+    float src = (static_cast<float>(o) + 0.5f) * ratio - 0.5f;
+    src = std::min(std::max(src, 0.0f), static_cast<float>(in - 1));
+    size_t lo = static_cast<size_t>(src);
+    map.lo_[o] = offset + lo;
+    map.hi_[o] = offset + std::min(lo + 1, in - 1);
+    map.frac_[o] = src - static_cast<float>(lo);
+  }
+}
+
+struct ImagePlan {
+  AxisMap rows_;
+  AxisMap cols_;
+  bool identity_;
+};
+
+} // namespace
+
+/**
+ * @brief Converts a batch of 8-bit HWC images into a normalized NCHW tensor.
+ *
+ * Every image is cropped, bilinearly resized to the spatial extents of
+ * `batch`, converted to float, normalized as
+ * `(pixel * scale - mean[c]) / std[c]` and transposed to CHW in a single pass
+ * that writes straight into `batch`. Output rows are spread over the thread
+ * pool.
+ *
+ * @param images The images, which may differ in size.
+ * @param num_images Number of entries in `images`.
+ * @param params Crop and normalization settings.
+ * @param batch The `[N, C, H, W]` tensor to overwrite.
+ */
+void preprocess_images(const ImageView *images, size_t num_images,
+                       const PreprocessParams &params, FloatTensor &batch) {
+  if (batch.ndim_ != 4 || batch.size_[0] != num_images) {
+    throw std::invalid_argument("preprocess_images: expected [N, C, H, W]");
+  }
+  const size_t channels = batch.size_[1];
+  const size_t out_h = batch.size_[2];
+  const size_t out_w = batch.size_[3];
+  if ((!params.mean_.empty() && params.mean_.size() != channels) ||
+      (!params.std_.empty() && params.std_.size() != channels)) {
+    throw std::invalid_argument("preprocess_images: mean/std size mismatch");
+  }
+  check_mutable("preprocess_images", batch);
+
+  // Fold scale, mean and std into one multiply-add per pixel.
+  WorkspaceScope workspace;
+  float *mul = workspace.alloc<float>(channels);
+  float *add = workspace.alloc<float>(channels);
+  for (size_t c = 0; c < channels; ++c) {
+    float mean = params.mean_.empty() ? 0.0f : params.mean_[c];
+    float stddev = params.std_.empty() ? 1.0f : params.std_[c];
+    mul[c] = params.scale_ / stddev;
+    add[c] = -mean / stddev;
+  }
+
+  ImagePlan *plans = workspace.alloc<ImagePlan>(num_images);
+  for (size_t i = 0; i < num_images; ++i) {
+    const ImageView &image = images[i];
+    if (image.channels_ != channels || image.height_ == 0 ||
+        image.width_ == 0) {
+      throw std::invalid_argument("preprocess_images: image shape mismatch");
+    }
+    size_t crop_h = params.crop_h_ ? params.crop_h_ : image.height_;
+    size_t crop_w = params.crop_w_ ? params.crop_w_ : image.width_;
+    if (crop_h > image.height_ || crop_w > image.width_) {
+      throw std::invalid_argument("preprocess_images: crop exceeds image");
+    }
+    size_t top = (image.height_ - crop_h) / 2;
+    size_t left = (image.width_ - crop_w) / 2;
+    if (params.crop_mode_ == CropMode::RANDOM) {
+      std::mt19937 rng(params.seed_ + static_cast<uint32_t>(i));
+      std::uniform_int_distribution<size_t> row_dist(0, image.height_ - crop_h);
+      std::uniform_int_distribution<size_t> col_dist(0, image.width_ - crop_w);
+      top = row_dist(rng);
+      left = col_dist(rng);
+    }
+    build_axis_map(top, crop_h, out_h, plans[i].rows_, workspace);
+    build_axis_map(left, crop_w, out_w, plans[i].cols_, workspace);
+    plans[i].identity_ = crop_h == out_h && crop_w == out_w;
+  }
+
+  const size_t plane = out_h * out_w;
+  parallel_for(0, num_images * out_h, [&](size_t lo, size_t hi) {
+    WorkspaceScope scratch;
+    float *top_row = scratch.alloc<float>(out_w);
+    float *bottom_row = scratch.alloc<float>(out_w);
+    for (size_t r = lo; r < hi; ++r) {
+      const size_t i = r / out_h;
+      const size_t oy = r % out_h;
+      const ImageView &image = images[i];
+      const ImagePlan &plan = plans[i];
+      const size_t stride =
+          image.row_stride_ ? image.row_stride_ : image.width_ * channels;
+      const uint8_t *src0 = image.data_ + plan.rows_.lo_[oy] * stride;
+      const uint8_t *src1 = image.data_ + plan.rows_.hi_[oy] * stride;
+      const float wy = plan.rows_.frac_[oy];
+      const size_t *x0 = plan.cols_.lo_;
+      const size_t *x1 = plan.cols_.hi_;
+      const float *wx = plan.cols_.frac_;
+
+      for (size_t c = 0; c < channels; ++c) {
+        float *dst = batch.data_ + (i * channels + c) * plane + oy * out_w;
+        const float m = mul[c];
+        const float a = add[c];
+        if (plan.identity_) {
+          const uint8_t *src = src0 + x0[0] * channels + c;
+          for (size_t ox = 0; ox < out_w; ++ox) {
+            dst[ox] = static_cast<float>(src[ox * channels]) * m + a;
+          }
+          continue;
+        }
+        // Horizontal pass on both source rows, then the vertical blend fused
+        // with normalization.
+        for (size_t ox = 0; ox < out_w; ++ox) {
+          float p00 = src0[x0[ox] * channels + c];
+          float p01 = src0[x1[ox] * channels + c];
+          float p10 = src1[x0[ox] * channels + c];
+          float p11 = src1[x1[ox] * channels + c];
+          top_row[ox] = p00 + (p01 - p00) * wx[ox];
+          bottom_row[ox] = p10 + (p11 - p10) * wx[ox];
+        }
+        for (size_t ox = 0; ox < out_w; ++ox) {
+          float p = top_row[ox] + (bottom_row[ox] - top_row[ox]) * wy;
+          dst[ox] = p * m + a;
+        }
+      }
+    }
+  });
+}
+
+} // namespace focus
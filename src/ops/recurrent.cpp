@@ -0,0 +1,244 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// recurrent.cpp
+//
+// Identification: src/ops/recurrent.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/recurrent.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Input rows per task of the input projection.
+const size_t kRowBlock = 32;
+
+// Weight rows kept hot while a block of input rows is projected onto them.
+const size_t kWeightBlock = 64;
+
+// Batch rows that share each pass over the recurrent weights.
+const size_t kBatchBlock = 8;
+
+inline float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+inline float dot(const float *a, const float *b, size_t n) {
+  float sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+struct RnnShape {
+  size_t steps_;
+  size_t batch_;
+  size_t input_;
+  size_t hidden_;
+};
+
+bool has_shape(const FloatTensor &t, size_t d0, size_t d1) {
+  return t.ndim_ == 2 && t.size_[0] == d0 && t.size_[1] == d1;
+}
+
+bool has_shape(const FloatTensor &t, size_t d0, size_t d1, size_t d2) {
+  return t.ndim_ == 3 && t.size_[0] == d0 && t.size_[1] == d1 &&
+         t.size_[2] == d2;
+}
+
+RnnShape resolve_shape(const char *op, size_t gates, const FloatTensor &input,
+                       const FloatTensor &w_ih, const FloatTensor &w_hh,
+                       const FloatTensor *b_ih, const FloatTensor *b_hh,
+                       const FloatTensor &h, const FloatTensor &output) {
+  if (input.ndim_ != 3) {
+    throw std::invalid_argument(std::string(op) + ": expected 3-D input");
+  }
+  if (h.ndim_ != 2) {
+    throw std::invalid_argument(std::string(op) +
+                                ": expected [B, H] hidden state");
+  }
+  RnnShape s;
+  s.steps_ = input.size_[0];
+  s.batch_ = input.size_[1];
+  s.input_ = input.size_[2];
+  s.hidden_ = h.size_[1];
+  const size_t rows = gates * s.hidden_;
+  if (!has_shape(w_ih, rows, s.input_) || !has_shape(w_hh, rows, s.hidden_)) {
+    throw std::invalid_argument(std::string(op) + ": weight shape mismatch");
+  }
+  if ((b_ih && b_ih->numel_ != rows) || (b_hh && b_hh->numel_ != rows)) {
+    throw std::invalid_argument(std::string(op) + ": bias shape mismatch");
+  }
+  if (!has_shape(h, s.batch_, s.hidden_) ||
+      !has_shape(output, s.steps_, s.batch_, s.hidden_)) {
+    throw std::invalid_argument(std::string(op) + ": state shape mismatch");
+  }
+  check_mutable(op, h);
+  check_mutable(op, output);
+  return s;
+}
+
+/*
+ * out[r, j] = x[r] . w[j] + bias[j] for all `rows` input rows: the input
+ * projection of every timestep as one matrix product.
+ */
+void project(const float *x, size_t rows, size_t in, const float *w,
+             size_t features, const float *bias, float *out) {
+  parallel_for(0, (rows + kRowBlock - 1) / kRowBlock,
+               [&](size_t lo, size_t hi) {
+    for (size_t block = lo; block < hi; ++block) {
+      const size_t r0 = block * kRowBlock;
+      const size_t r1 = std::min(rows, r0 + kRowBlock);
+      for (size_t j0 = 0; j0 < features; j0 += kWeightBlock) {
+        const size_t j1 = std::min(features, j0 + kWeightBlock);
+        for (size_t r = r0; r < r1; ++r) {
+          const float *xr = x + r * in;
+          float *o = out + r * features;
+          for (size_t j = j0; j < j1; ++j) {
+            o[j] = dot(xr, w + j * in, in) + (bias ? bias[j] : 0.0f);
+          }
+        }
+      }
+    }
+  });
+}
+
+/*
+ * Runs the recurrence. For each block of batch rows and each step, the
+ * hidden-to-hidden product `W_hh h + b_hh` is formed with every weight row
+ * shared across the block, then `cell` applies the fused gate update to one
+ * batch row given its projected input and hidden gates.
+ */
+template <typename Cell>
+void run_sequence(const RnnShape &s, size_t gates, const float *projected,
+                  const FloatTensor &w_hh, const FloatTensor *b_hh,
+                  FloatTensor &h, FloatTensor &output, Cell cell) {
+  const size_t width = gates * s.hidden_;
+  parallel_for(0, s.batch_, [&](size_t lo, size_t hi) {
+    WorkspaceScope workspace;
+    float *hidden_gates = workspace.alloc<float>(kBatchBlock * width);
+    for (size_t b0 = lo; b0 < hi; b0 += kBatchBlock) {
+      const size_t nb = std::min(kBatchBlock, hi - b0);
+      for (size_t t = 0; t < s.steps_; ++t) {
+        for (size_t j = 0; j < width; ++j) {
+          const float *w = w_hh.data_ + j * s.hidden_;
+          const float bias = b_hh ? b_hh->data_[j] : 0.0f;
+          for (size_t b = 0; b < nb; ++b) {
+            hidden_gates[b * width + j] =
+                dot(w, h.data_ + (b0 + b) * s.hidden_, s.hidden_) + bias;
+          }
+        }
+        for (size_t b = 0; b < nb; ++b) {
+          const size_t row = b0 + b;
+          float *hr = h.data_ + row * s.hidden_;
+          cell(row, projected + (t * s.batch_ + row) * width,
+               hidden_gates + b * width, hr);
+          std::copy(hr, hr + s.hidden_,
+                    output.data_ + (t * s.batch_ + row) * s.hidden_);
+        }
+      }
+    }
+  });
+}
+
+} // namespace
+
+/**
+ * @brief Runs a single-layer LSTM over a whole sequence.
+ *
+ * `input` is `[T, B, I]`, `w_ih` is `[4H, I]` and `w_hh` is `[4H, H]` with
+ * gates ordered input, forget, cell, output. The input projection of every
+ * timestep is computed up front in one matrix product; each step then runs a
+ * fused kernel that adds the recurrent product and biases, applies the gate
+ * nonlinearities and updates the state. Batch rows are independent and split
+ * across the thread pool.
+ *
+ * @param input The input sequence.
+ * @param w_ih The input-to-hidden weights.
+ * @param w_hh The hidden-to-hidden weights.
+ * @param b_ih Optional `[4H]` input bias, may be `nullptr`.
+ * @param b_hh Optional `[4H]` hidden bias, may be `nullptr`.
+ * @param h `[B, H]` initial hidden state, overwritten with the final one.
+ * @param c `[B, H]` initial cell state, overwritten with the final one.
+ * @param output `[T, B, H]` receives the hidden state of every timestep.
+ */
+void lstm(const FloatTensor &input, const FloatTensor &w_ih,
+          const FloatTensor &w_hh, const FloatTensor *b_ih,
+          const FloatTensor *b_hh, FloatTensor &h, FloatTensor &c,
+          FloatTensor &output) {
+  const RnnShape s =
+      resolve_shape("lstm", 4, input, w_ih, w_hh, b_ih, b_hh, h, output);
+  if (!has_shape(c, s.batch_, s.hidden_)) {
+    throw std::invalid_argument("lstm: state shape mismatch");
+  }
+  check_mutable("lstm", c);
+  const size_t hs = s.hidden_;
+  WorkspaceScope workspace;
+  float *projected = workspace.alloc<float>(s.steps_ * s.batch_ * 4 * hs);
+  project(input.data_, s.steps_ * s.batch_, s.input_, w_ih.data_, 4 * hs,
+          b_ih ? b_ih->data_ : nullptr, projected);
+
+  run_sequence(s, 4, projected, w_hh, b_hh, h, output,
+               [&](size_t row, const float *x, const float *g, float *hr) {
+    float *cr = c.data_ + row * hs;
+    for (size_t k = 0; k < hs; ++k) {
+      const float i = sigmoid(x[k] + g[k]);
+      const float f = sigmoid(x[hs + k] + g[hs + k]);
+      const float n = std::tanh(x[2 * hs + k] + g[2 * hs + k]);
+      const float o = sigmoid(x[3 * hs + k] + g[3 * hs + k]);
+      cr[k] = f * cr[k] + i * n;
+      hr[k] = o * std::tanh(cr[k]);
+    }
+  });
+}
+
+/**
+ * @brief Runs a single-layer GRU over a whole sequence.
+ *
+ * `input` is `[T, B, I]`, `w_ih` is `[3H, I]` and `w_hh` is `[3H, H]` with
+ * gates ordered reset, update, new. The input projection of every timestep is
+ * computed up front in one matrix product, and each step runs a fused gate
+ * kernel. Batch rows are independent and split across the thread pool.
+ *
+ * @param input The input sequence.
+ * @param w_ih The input-to-hidden weights.
+ * @param w_hh The hidden-to-hidden weights.
+ * @param b_ih Optional `[3H]` input bias, may be `nullptr`.
+ * @param b_hh Optional `[3H]` hidden bias, may be `nullptr`.
+ * @param h `[B, H]` initial hidden state, overwritten with the final one.
+ * @param output `[T, B, H]` receives the hidden state of every timestep.
+ */
+void gru(const FloatTensor &input, const FloatTensor &w_ih,
+         const FloatTensor &w_hh, const FloatTensor *b_ih,
+         const FloatTensor *b_hh, FloatTensor &h, FloatTensor &output) {
+  const RnnShape s =
+      resolve_shape("gru", 3, input, w_ih, w_hh, b_ih, b_hh, h, output);
+  const size_t hs = s.hidden_;
+  WorkspaceScope workspace;
+  float *projected = workspace.alloc<float>(s.steps_ * s.batch_ * 3 * hs);
+  project(input.data_, s.steps_ * s.batch_, s.input_, w_ih.data_, 3 * hs,
+          b_ih ? b_ih->data_ : nullptr, projected);
+
+  run_sequence(s, 3, projected, w_hh, b_hh, h, output,
+               [&](size_t, const float *x, const float *g, float *hr) {
+    for (size_t k = 0; k < hs; ++k) {
+      const float r = sigmoid(x[k] + g[k]);
+      const float z = sigmoid(x[hs + k] + g[hs + k]);
+      const float n = std::tanh(x[2 * hs + k] + r * g[2 * hs + k]);
+      hr[k] = (1 - z) * n + z * hr[k];
+    }
+  });
+}
+
+} // namespace focus
@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// scan.cpp
+//
+// Identification: src/ops/scan.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/scan.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Shortest lane worth splitting into blocks for the two-pass scan.
+const size_t kMinBlockedLength = 1 << 14;
+
+// Elements of the inner dimension handled by one task of the lane scan.
+const size_t kInnerChunk = 256;
+
+/*
+ * Scans `input` along `dim` with the associative `op` whose identity is
+ * `identity`. The tensor is viewed as `[outer, length, inner]`.
+ */
+template <typename Op>
+void scan(const char *name, const FloatTensor &input, size_t dim,
+          FloatTensor &output, float identity, Op op) {
+  if (dim >= input.ndim_) {
+    throw std::out_of_range(std::string(name) + ": dim out of range");
+  }
+  if (output.ndim_ != input.ndim_ ||
+      !std::equal(input.size_, input.size_ + input.ndim_, output.size_)) {
+    throw std::invalid_argument(std::string(name) + ": shape mismatch");
+  }
+  check_mutable(name, output);
+  size_t outer = 1;
+  size_t inner = 1;
+  for (size_t d = 0; d < dim; ++d) {
+    outer *= input.size_[d];
+  }
+  for (size_t d = dim + 1; d < input.ndim_; ++d) {
+    inner *= input.size_[d];
+  }
+  const size_t length = input.size_[dim];
+  const float *src = input.data_;
+  float *dst = output.data_;
+
+  const size_t threads = ThreadPool::global().num_threads();
+  if (inner == 1 && outer < threads && length >= kMinBlockedLength) {
+    // Two-pass blocked scan of each lane.
+    const size_t blocks = threads;
+    WorkspaceScope workspace;
+    float *totals = workspace.alloc<float>(blocks);
+    for (size_t o = 0; o < outer; ++o) {
+      const float *in = src + o * length;
+      float *out = dst + o * length;
+      parallel_for(0, blocks, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b) {
+          float acc = identity;
+          for (size_t i = length * b / blocks; i < length * (b + 1) / blocks;
+               ++i) {
+            acc = op(acc, in[i]);
+          }
+          totals[b] = acc;
+        }
+      });
+      float carry = identity;
+      for (size_t b = 0; b < blocks; ++b) {
+        float total = totals[b];
+        totals[b] = carry;
+        carry = op(carry, total);
+      }
+      parallel_for(0, blocks, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b) {
+          float acc = totals[b];
+          for (size_t i = length * b / blocks; i < length * (b + 1) / blocks;
+               ++i) {
+            acc = op(acc, in[i]);
+            out[i] = acc;
+          }
+        }
+      });
+    }
+    return;
+  }
+
+  // Independent lanes. Rows of the inner dimension are contiguous, so the
+  // scan walks along `dim` updating a chunk of adjacent lanes at a time.
+  const size_t chunks = (inner + kInnerChunk - 1) / kInnerChunk;
+  parallel_for(0, outer * chunks, [&](size_t lo, size_t hi) {
+    for (size_t task = lo; task < hi; ++task) {
+      const size_t o = task / chunks;
+      const size_t j0 = (task % chunks) * kInnerChunk;
+      const size_t j1 = std::min(inner, j0 + kInnerChunk);
+      const float *in = src + o * length * inner;
+      float *out = dst + o * length * inner;
+      if (length == 0) {
+        continue;
+      }
+      for (size_t j = j0; j < j1; ++j) {
+        out[j] = op(identity, in[j]);
+      }
+      for (size_t i = 1; i < length; ++i) {
+        const float *prev = out + (i - 1) * inner;
+        for (size_t j = j0; j < j1; ++j) {
+          out[i * inner + j] = op(prev[j], in[i * inner + j]);
+        }
+      }
+    }
+  });
+}
+
+} // namespace
+
+/**
+ * @brief Writes the inclusive prefix sum of `input` along `dim` into `output`.
+ *
+ * `output` must have the shape of `input` and may alias it. Independent lanes
+ * are split across the thread pool. When there are too few lanes to occupy
+ * it, each long lane is scanned in two passes over blocks: block totals first,
+ * then every block again offset by the totals before it.
+ *
+ * @param input The tensor to scan.
+ * @param dim The dimension to scan along.
+ * @param output The tensor to overwrite.
+ */
+void cumsum(const FloatTensor &input, size_t dim, FloatTensor &output) {
+  scan("cumsum", input, dim, output, 0.0f, std::plus<float>());
+}
+
+/**
+ * @brief Writes the inclusive prefix product of `input` along `dim` into
+ * `output`.
+ *
+ * Parallelized like `cumsum`.
+ *
+ * @param input The tensor to scan.
+ * @param dim The dimension to scan along.
+ * @param output The tensor to overwrite.
+ */
+void cumprod(const FloatTensor &input, size_t dim, FloatTensor &output) {
+  scan("cumprod", input, dim, output, 1.0f, std::multiplies<float>());
+}
+
+} // namespace focus
@@ -0,0 +1,341 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sort.cpp
+//
+// Identification: src/ops/sort.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/sort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "common/thread_pool.h"
+#include "common/workspace.h"
+
+namespace focus {
+
+namespace {
+
+// Longest row sorted with the bitonic network.
+const size_t kNetworkLength = 32;
+
+// Shortest single row worth sorting or selecting across threads.
+const size_t kParallelLength = 1 << 15;
+
+// A value paired with its position. Keys are negated for descending order so
+// that every comparison is ascending, and ties break on the position, which
+// makes every algorithm below produce the same stable order.
+struct Entry {
+  float key_;
+  size_t index_;
+};
+
+// A strict total order: numbers ascending, then NaNs, each by position.
+// Negating a NaN leaves it a NaN, so NaNs come last in both directions.
+inline bool before(const Entry &a, const Entry &b) {
+  const bool a_nan = std::isnan(a.key_);
+  const bool b_nan = std::isnan(b.key_);
+  if (a_nan || b_nan) {
+    return !a_nan || (b_nan && a.index_ < b.index_);
+  }
+  return a.key_ < b.key_ || (a.key_ == b.key_ && a.index_ < b.index_);
+}
+
+// The tensor viewed as `[outer, length, inner]`, one lane per (outer, inner).
+struct Lanes {
+  size_t outer_;
+  size_t length_;
+  size_t inner_;
+
+  size_t count() const { return outer_ * inner_; }
+
+  // Offset of element `i` of `lane` in a tensor whose `dim` has `length`.
+  size_t offset(size_t lane, size_t i, size_t length) const {
+    return (lane / inner_) * length * inner_ + i * inner_ + lane % inner_;
+  }
+};
+
+Lanes resolve_lanes(const char *op, const FloatTensor &input, size_t dim) {
+  if (dim >= input.ndim_) {
+    throw std::out_of_range(std::string(op) + ": dim out of range");
+  }
+  Lanes lanes = {1, input.size_[dim], 1};
+  for (size_t d = 0; d < dim; ++d) {
+    lanes.outer_ *= input.size_[d];
+  }
+  for (size_t d = dim + 1; d < input.ndim_; ++d) {
+    lanes.inner_ *= input.size_[d];
+  }
+  return lanes;
+}
+
+void check_output(const char *op, const FloatTensor &input, size_t dim,
+                  size_t length, const FloatTensor &values) {
+  bool ok = values.ndim_ == input.ndim_;
+  for (size_t d = 0; ok && d < input.ndim_; ++d) {
+    ok = values.size_[d] == (d == dim ? length : input.size_[d]);
+  }
+  if (!ok) {
+    throw std::invalid_argument(std::string(op) + ": output shape mismatch");
+  }
+  check_mutable(op, values);
+}
+
+void load_lane(const FloatTensor &input, const Lanes &lanes, size_t lane,
+               bool negate, Entry *entries) {
+  for (size_t i = 0; i < lanes.length_; ++i) {
+    float x = input.data_[lanes.offset(lane, i, lanes.length_)];
+    entries[i].key_ = negate ? -x : x;
+    entries[i].index_ = i;
+  }
+}
+
+void store_lane(const Entry *entries, size_t count, const Lanes &lanes,
+                size_t lane, bool negate, FloatTensor *values,
+                size_t *indices) {
+  for (size_t i = 0; i < count; ++i) {
+    size_t at = lanes.offset(lane, i, count);
+    if (values) {
+      values->data_[at] = negate ? -entries[i].key_ : entries[i].key_;
+    }
+    if (indices) {
+      indices[at] = entries[i].index_;
+    }
+  }
+}
+
+/*
+ * Bitonic sorting network over a power-of-two padded copy of the row. The
+ * compare-exchange is written as selects so the compiler emits conditional
+ * moves instead of unpredictable branches.
+ */
+void network_sort(Entry *entries, size_t n) {
+  size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  // Sorts after every entry, NaNs included.
+  Entry pad = {std::numeric_limits<float>::quiet_NaN(),
+               std::numeric_limits<size_t>::max()};
+  Entry e[kNetworkLength];
+  std::copy(entries, entries + n, e);
+  std::fill(e + n, e + p, pad);
+
+  for (size_t k = 2; k <= p; k <<= 1) {
+    for (size_t j = k >> 1; j > 0; j >>= 1) {
+      for (size_t i = 0; i < p; ++i) {
+        size_t l = i ^ j;
+        if (l <= i) {
+          continue;
+        }
+        Entry a = e[i];
+        Entry b = e[l];
+        bool swap = (i & k) == 0 ? before(b, a) : before(a, b);
+        e[i] = swap ? b : a;
+        e[l] = swap ? a : b;
+      }
+    }
+  }
+  std::copy(e, e + n, entries);
+}
+
+void sort_entries(Entry *entries, size_t n) {
+  if (n <= kNetworkLength) {
+    network_sort(entries, n);
+  } else {
+    std::sort(entries, entries + n, before);
+  }
+}
+
+/*
+ * Sorts one long row across the thread pool: every chunk is sorted
+ * independently, then neighbouring runs are merged pairwise, doubling the run
+ * length each round. Rounds alternate between `entries` and a workspace copy.
+ */
+void parallel_sort(Entry *entries, size_t n) {
+  const size_t chunks = ThreadPool::global().num_threads();
+  WorkspaceScope workspace;
+  size_t *bounds = workspace.alloc<size_t>(chunks + 1);
+  for (size_t c = 0; c <= chunks; ++c) {
+    bounds[c] = n * c / chunks;
+  }
+  parallel_for(0, chunks, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c < hi; ++c) {
+      std::sort(entries + bounds[c], entries + bounds[c + 1], before);
+    }
+  });
+
+  Entry *src = entries;
+  Entry *dst = workspace.alloc<Entry>(n);
+  for (size_t width = 1; width < chunks; width *= 2) {
+    const size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+    parallel_for(0, pairs, [&](size_t lo, size_t hi) {
+      for (size_t pair = lo; pair < hi; ++pair) {
+        size_t first = bounds[pair * 2 * width];
+        size_t middle = bounds[std::min(chunks, (pair * 2 + 1) * width)];
+        size_t last = bounds[std::min(chunks, (pair * 2 + 2) * width)];
+        std::merge(src + first, src + middle, src + middle, src + last,
+                   dst + first, before);
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src != entries) {
+    std::copy(src, src + n, entries);
+  }
+}
+
+// Leaves the first `min(k, n)` entries the smallest, in order.
+void select_entries(Entry *entries, size_t n, size_t k) {
+  if (k < n) {
+    std::nth_element(entries, entries + k, entries + n, before);
+    n = k;
+  }
+  sort_entries(entries, n);
+}
+
+/*
+ * Selects from one long row across the thread pool: every chunk selects its
+ * own top `k` in place, those candidates are packed to the front, and the
+ * final `k` are selected from them.
+ */
+void parallel_select(Entry *entries, size_t n, size_t k) {
+  const size_t chunks = ThreadPool::global().num_threads();
+  parallel_for(0, chunks, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c < hi; ++c) {
+      select_entries(entries + n * c / chunks,
+                     n * (c + 1) / chunks - n * c / chunks, k);
+    }
+  });
+  size_t candidates = 0;
+  for (size_t c = 0; c < chunks; ++c) {
+    const size_t begin = n * c / chunks;
+    const size_t kept = std::min(k, n * (c + 1) / chunks - begin);
+    // The destination never passes the source, so a forward copy is safe.
+    for (size_t i = 0; i < kept; ++i) {
+      entries[candidates + i] = entries[begin + i];
+    }
+    candidates += kept;
+  }
+  select_entries(entries, candidates, k);
+}
+
+/*
+ * Runs `fn(entries, length)` on every lane and stores the first `keep`
+ * entries. `fn_parallel` replaces `fn` when there are too few lanes to occupy
+ * the thread pool and the lanes are long.
+ */
+template <typename Fn, typename ParallelFn>
+void for_each_lane(const FloatTensor &input, const Lanes &lanes, bool negate,
+                   size_t keep, FloatTensor *values, size_t *indices, Fn fn,
+                   ParallelFn fn_parallel) {
+  if (lanes.count() < ThreadPool::global().num_threads() &&
+      lanes.length_ >= kParallelLength) {
+    WorkspaceScope workspace;
+    Entry *entries = workspace.alloc<Entry>(lanes.length_);
+    for (size_t lane = 0; lane < lanes.count(); ++lane) {
+      load_lane(input, lanes, lane, negate, entries);
+      fn_parallel(entries, lanes.length_);
+      store_lane(entries, keep, lanes, lane, negate, values, indices);
+    }
+    return;
+  }
+  parallel_for(0, lanes.count(), [&](size_t lo, size_t hi) {
+    WorkspaceScope scratch;
+    Entry *entries = scratch.alloc<Entry>(lanes.length_);
+    for (size_t lane = lo; lane < hi; ++lane) {
+      load_lane(input, lanes, lane, negate, entries);
+      fn(entries, lanes.length_);
+      store_lane(entries, keep, lanes, lane, negate, values, indices);
+    }
+  });
+}
+
+void sort_lanes(const FloatTensor &input, size_t dim, bool descending,
+                FloatTensor *values, size_t *indices) {
+  const char *op = values ? "sort" : "argsort";
+  Lanes lanes = resolve_lanes(op, input, dim);
+  if (values) {
+    check_output(op, input, dim, lanes.length_, *values);
+  }
+  for_each_lane(input, lanes, descending, lanes.length_, values, indices,
+                sort_entries, parallel_sort);
+}
+
+} // namespace
+
+/**
+ * @brief Sorts `input` along `dim`.
+ *
+ * Equal values keep their original order. Rows of up to 32 elements are sorted
+ * with a branch-free bitonic network; longer rows use `std::sort`, made stable
+ * by breaking ties on the original position. Rows are split across the thread
+ * pool, and a single long row is sorted in parallel chunks that are then
+ * merged pairwise. NaNs are placed after every number, in their original
+ * order, whether sorting ascending or descending.
+ *
+ * @param input The tensor to sort.
+ * @param dim The dimension to sort along.
+ * @param descending Sort largest first.
+ * @param values Receives the sorted values; shaped like `input`.
+ * @param indices Optional, receives the position along `dim` each value came
+ * from, `input.numel_` entries. May be `nullptr`.
+ */
+void sort(const FloatTensor &input, size_t dim, bool descending,
+          FloatTensor &values, size_t *indices) {
+  sort_lanes(input, dim, descending, &values, indices);
+}
+
+/**
+ * @brief Writes the positions that would sort `input` along `dim`.
+ *
+ * @param input The tensor to sort.
+ * @param dim The dimension to sort along.
+ * @param descending Sort largest first.
+ * @param indices Receives `input.numel_` positions along `dim`.
+ */
+void argsort(const FloatTensor &input, size_t dim, bool descending,
+             size_t *indices) {
+  sort_lanes(input, dim, descending, nullptr, indices);
+}
+
+/**
+ * @brief Selects the `k` largest or smallest elements along `dim`, in sorted
+ * order.
+ *
+ * Each row is reduced with partial selection rather than a full sort. A long
+ * single row is split into chunks whose local top `k` are selected in parallel
+ * and then merged. NaNs rank after every number, so they are only selected
+ * once the numbers run out, and then come last.
+ *
+ * @param input The tensor to select from.
+ * @param dim The dimension to select along.
+ * @param k Number of elements to keep, at most `input.size_[dim]`.
+ * @param largest Keep the largest elements rather than the smallest.
+ * @param values Receives the selected values; shaped like `input` with
+ * `size_[dim] == k`.
+ * @param indices Optional, receives the positions along `dim` of the selected
+ * values, `values.numel_` entries. May be `nullptr`.
+ */
+void topk(const FloatTensor &input, size_t dim, size_t k, bool largest,
+          FloatTensor &values, size_t *indices) {
+  Lanes lanes = resolve_lanes("topk", input, dim);
+  if (k > lanes.length_) {
+    throw std::out_of_range("topk: k exceeds the dimension size");
+  }
+  check_output("topk", input, dim, k, values);
+  for_each_lane(
+      input, lanes, largest, k, &values, indices,
+      [k](Entry *entries, size_t n) { select_entries(entries, n, k); },
+      [k](Entry *entries, size_t n) { parallel_select(entries, n, k); });
+}
+
+} // namespace focus
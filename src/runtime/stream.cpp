@@ -0,0 +1,306 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// stream.cpp
+//
+// Identification: src/runtime/stream.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "runtime/stream.h"
+
+#include <algorithm>
+
+namespace focus {
+
+/**
+ * @brief Blocks until the op has finished.
+ *
+ * Rethrows the exception thrown by the op, or by an op it depended on.
+ */
+void Event::wait() const {
+  if (!node_) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(node_->mutex_);
+  node_->cv_.wait(lock, [this] { return node_->done_; });
+  if (node_->error_) {
+    std::rethrow_exception(node_->error_);
+  }
+}
+
+/**
+ * @brief Returns `true` if the op has finished, `false` otherwise.
+ *
+ * @return bool
+ */
+bool Event::ready() const {
+  if (!node_) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(node_->mutex_);
+  return node_->done_;
+}
+
+Scheduler::Scheduler(ThreadPool &pool) : pool_(pool), outstanding_(0) {}
+
+Scheduler::~Scheduler() { synchronize(); }
+
+/**
+ * @brief Enqueues input `fn`, ordered after `after` and after every
+ * conflicting op enqueued before it.
+ *
+ * @param reads Buffers `fn` reads.
+ * @param writes Buffers `fn` writes.
+ * @param after An extra dependency, e.g. the previous op of a stream.
+ * @param fn The op to run.
+ * @return An event that completes when `fn` has run.
+ */
+Event Scheduler::enqueue(const std::vector<const void *> &reads,
+                         const std::vector<const void *> &writes,
+                         const Event &after, std::function<void()> fn) {
+  NodePtr node = std::make_shared<Event::Node>();
+  node->fn_ = std::move(fn);
+  node->buffers_ = reads;
+  node->buffers_.insert(node->buffers_.end(), writes.begin(), writes.end());
+
+  bool ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++outstanding_;
+
+    // Hold one extra count while wiring edges so the node cannot start early.
+    node->remaining_ = 1;
+    add_dependency(node, after.node_);
+    for (size_t i = 0; i < reads.size(); ++i) {
+      add_dependency(node, buffers_[reads[i]].last_writer_);
+    }
+    for (size_t i = 0; i < writes.size(); ++i) {
+      BufferState &state = buffers_[writes[i]];
+      add_dependency(node, state.last_writer_);
+      for (size_t r = 0; r < state.readers_.size(); ++r) {
+        add_dependency(node, state.readers_[r]);
+      }
+    }
+
+    for (size_t i = 0; i < reads.size(); ++i) {
+      std::vector<NodePtr> &readers = buffers_[reads[i]].readers_;
+      readers.erase(std::remove_if(readers.begin(), readers.end(),
+                                   [](const NodePtr &r) {
+                                     return r->finished_;
+                                   }),
+                    readers.end());
+      readers.push_back(node);
+    }
+    for (size_t i = 0; i < writes.size(); ++i) {
+      BufferState &state = buffers_[writes[i]];
+      state.last_writer_ = node;
+      state.readers_.clear();
+    }
+    ready = --node->remaining_ == 0;
+  }
+
+  if (ready) {
+    launch(node);
+  }
+  return Event(node);
+}
+
+/**
+ * @brief Blocks until every enqueued op has finished.
+ */
+void Scheduler::synchronize() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cv_.wait(lock, [this] { return outstanding_ == 0; });
+  buffers_.clear();
+}
+
+/**
+ * @brief Returns the number of buffers still tracked for ordering.
+ *
+ * A buffer is forgotten once every op touching it has finished, unless its
+ * last writer failed and must still poison later readers.
+ *
+ * @return size_t
+ */
+size_t Scheduler::tracked_buffers() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffers_.size();
+}
+
+// Requires `mutex_`.
+void Scheduler::add_dependency(const NodePtr &node, const NodePtr &on) {
+  if (!on || on == node) {
+    return;
+  }
+  if (on->finished_) {
+    // A finished failure still poisons ops enqueued after it.
+    if (on->error_ && !node->error_) {
+      node->error_ = on->error_;
+    }
+    return;
+  }
+  on->successors_.push_back(node);
+  ++node->remaining_;
+}
+
+// Requires `mutex_`. Drops the state of buffers whose ops have all finished,
+// so a scheduler that never synchronizes does not keep them alive.
+void Scheduler::forget_buffers(const NodePtr &node) {
+  for (size_t i = 0; i < node->buffers_.size(); ++i) {
+    auto it = buffers_.find(node->buffers_[i]);
+    if (it == buffers_.end()) {
+      continue;
+    }
+    std::vector<NodePtr> &readers = it->second.readers_;
+    readers.erase(std::remove_if(readers.begin(), readers.end(),
+                                 [](const NodePtr &r) {
+                                   return r->finished_;
+                                 }),
+                  readers.end());
+    const NodePtr &writer = it->second.last_writer_;
+    // A failed writer stays tracked so later readers are still poisoned.
+    if (readers.empty() &&
+        (!writer || (writer->finished_ && !writer->error_))) {
+      buffers_.erase(it);
+    }
+  }
+  node->buffers_.clear();
+}
+
+void Scheduler::launch(const NodePtr &node) {
+  pool_.submit([this, node] {
+    if (!node->error_) {
+      try {
+        node->fn_();
+      } catch (...) {
+        node->error_ = std::current_exception();
+      }
+    }
+    complete(node);
+  });
+}
+
+void Scheduler::complete(const NodePtr &node) {
+  std::vector<NodePtr> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    node->finished_ = true;
+    for (size_t i = 0; i < node->successors_.size(); ++i) {
+      const NodePtr &next = node->successors_[i];
+      // Failures poison everything downstream.
+      if (node->error_ && !next->error_) {
+        next->error_ = node->error_;
+      }
+      if (--next->remaining_ == 0) {
+        ready.push_back(next);
+      }
+    }
+    node->successors_.clear();
+    node->fn_ = nullptr;
+    forget_buffers(node);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(node->mutex_);
+    node->done_ = true;
+  }
+  node->cv_.notify_all();
+
+  for (size_t i = 0; i < ready.size(); ++i) {
+    launch(ready[i]);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (--outstanding_ == 0) {
+    idle_cv_.notify_all();
+  }
+}
+
+Stream::Stream(Scheduler &scheduler) : scheduler_(scheduler) {}
+
+/**
+ * @brief Enqueues input `fn`, which reads the data of `reads` and writes the
+ * data of `writes`.
+ *
+ * All tensors are borrowed and must stay alive until the op has finished.
+ *
+ * @param reads Tensors `fn` reads.
+ * @param writes Tensors `fn` writes.
+ * @param fn The op to run.
+ * @return Event
+ */
+Event Stream::enqueue(const std::vector<const FloatTensor *> &reads,
+                      const std::vector<FloatTensor *> &writes,
+                      std::function<void()> fn) {
+  std::vector<const void *> read_buffers;
+  std::vector<const void *> write_buffers;
+  for (size_t i = 0; i < reads.size(); ++i) {
+    read_buffers.push_back(reads[i]->data_);
+  }
+  for (size_t i = 0; i < writes.size(); ++i) {
+    write_buffers.push_back(writes[i]->data_);
+  }
+  last_ = scheduler_.enqueue(read_buffers, write_buffers, last_, fn);
+  return last_;
+}
+
+/**
+ * @brief Enqueues `self.add_(other)`.
+ *
+ * @return Event
+ */
+Event Stream::add_(FloatTensor &self, FloatTensor &other) {
+  FloatTensor *x = &self;
+  FloatTensor *y = &other;
+  return enqueue({&other}, {&self}, [x, y] { x->add_(*y); });
+}
+
+/**
+ * @brief Enqueues `self.sub_(other)`.
+ *
+ * @return Event
+ */
+Event Stream::sub_(FloatTensor &self, FloatTensor &other) {
+  FloatTensor *x = &self;
+  FloatTensor *y = &other;
+  return enqueue({&other}, {&self}, [x, y] { x->sub_(*y); });
+}
+
+/**
+ * @brief Enqueues `self.mul_(value)`.
+ *
+ * @return Event
+ */
+Event Stream::mul_(FloatTensor &self, float value) {
+  FloatTensor *x = &self;
+  return enqueue({}, {&self}, [x, value] { x->mul_(value); });
+}
+
+/**
+ * @brief Enqueues `*out = self.sum_()`.
+ *
+ * @return Event
+ */
+Event Stream::sum_(FloatTensor &self, float *out) {
+  FloatTensor *x = &self;
+  last_ = scheduler_.enqueue({self.data_}, {out}, last_,
+                             [x, out] { *out = x->sum_(); });
+  return last_;
+}
+
+/**
+ * @brief Blocks until every op enqueued on this stream has finished.
+ *
+ * Rethrows the error of a failed op, after which the stream starts a new
+ * chain, so later ops no longer inherit the failure. A buffer the failed op
+ * wrote stays poisoned until `Scheduler::synchronize`.
+ */
+void Stream::synchronize() {
+  Event last = last_;
+  last_ = Event();
+  last.wait();
+}
+
+} // namespace focus
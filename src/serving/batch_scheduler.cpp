@@ -0,0 +1,249 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// batch_scheduler.cpp
+//
+// Identification: src/serving/batch_scheduler.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "serving/batch_scheduler.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+namespace focus {
+
+namespace {
+
+// Number of most recent queueing latencies kept for the percentile report.
+const size_t kLatencyWindow = 1 << 16;
+
+double percentile(std::vector<double> &values, double q) {
+  if (values.empty()) {
+    return 0;
+  }
+  size_t k = static_cast<size_t>(q * (values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + k, values.end());
+  return values[k];
+}
+
+} // namespace
+
+BatchScheduler::BatchScheduler(BatchForwardFn forward, size_t *input_size,
+                               size_t input_ndim, size_t *output_size,
+                               size_t output_ndim,
+                               BatchSchedulerOptions options)
+    : forward_(forward), options_(options),
+      input_size_(input_size, input_size + input_ndim),
+      output_size_(output_size, output_size + output_ndim),
+      queue_(options.queue_capacity_), pending_(0), sleeping_(false),
+      stopping_(false), latency_cursor_(0), num_requests_(0), num_batches_(0),
+      started_(false) {
+  if (options_.max_batch_size_ == 0) {
+    throw std::invalid_argument("BatchScheduler: max_batch_size_ must be > 0");
+  }
+
+  // The batch dimension is prepended to the per-sample shapes.
+  input_numel_ = 1;
+  for (size_t dim = 0; dim < input_ndim; ++dim) {
+    input_numel_ *= input_size[dim];
+  }
+  output_numel_ = 1;
+  for (size_t dim = 0; dim < output_ndim; ++dim) {
+    output_numel_ *= output_size[dim];
+  }
+  input_size_.insert(input_size_.begin(), options_.max_batch_size_);
+  output_size_.insert(output_size_.begin(), options_.max_batch_size_);
+  input_buffer_.resize(options_.max_batch_size_ * input_numel_);
+  output_buffer_.resize(options_.max_batch_size_ * output_numel_);
+  latencies_us_.reserve(kLatencyWindow);
+
+  worker_ = std::thread(&BatchScheduler::run, this);
+}
+
+BatchScheduler::~BatchScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_.store(true);
+  }
+  wake_cv_.notify_one();
+  worker_.join();
+}
+
+/**
+ * @brief Queues a single sample for the next batched forward pass.
+ *
+ * Both tensors are borrowed and must stay alive until the returned future is
+ * ready. Safe to call from any number of threads.
+ *
+ * @param input The sample to run, shaped like the configured input sample.
+ * @param output Receives the result, shaped like the configured output sample.
+ * @return A future that becomes ready once `output` has been written.
+ */
+std::future<void> BatchScheduler::submit(FloatTensor &input,
+                                         FloatTensor &output) {
+  if (input.numel_ != input_numel_ || output.numel_ != output_numel_) {
+    throw std::invalid_argument("BatchScheduler: sample shape mismatch");
+  }
+  check_mutable("BatchScheduler", output);
+
+  Request *request = new Request();
+  request->input_ = &input;
+  request->output_ = &output;
+  request->enqueue_time_ = std::chrono::steady_clock::now();
+  std::future<void> out = request->promise_.get_future();
+
+  // Back-pressure: a full queue means the worker is behind, let it catch up.
+  while (!queue_.push(request)) {
+    std::this_thread::yield();
+  }
+
+  pending_.fetch_add(1);
+  if (sleeping_.load()) {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_one();
+  }
+  return out;
+}
+
+/**
+ * @brief Returns throughput and queueing latency statistics.
+ *
+ * @return BatchSchedulerStats
+ */
+BatchSchedulerStats BatchScheduler::stats() {
+  BatchSchedulerStats out;
+  std::vector<double> latencies;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    out.num_requests_ = num_requests_;
+    out.num_batches_ = num_batches_;
+    if (num_requests_ > 0) {
+      std::chrono::duration<double> elapsed = last_completion_ - first_enqueue_;
+      if (elapsed.count() > 0) {
+        out.throughput_ = num_requests_ / elapsed.count();
+      }
+    }
+    latencies = latencies_us_;
+  }
+  out.p50_latency_us_ = percentile(latencies, 0.50);
+  out.p90_latency_us_ = percentile(latencies, 0.90);
+  out.p99_latency_us_ = percentile(latencies, 0.99);
+  return out;
+}
+
+void BatchScheduler::wait_for_work(
+    std::chrono::steady_clock::duration timeout) {
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  sleeping_.store(true);
+  wake_cv_.wait_for(lock, timeout, [this] {
+    return pending_.load() > 0 || stopping_.load();
+  });
+  sleeping_.store(false);
+}
+
+void BatchScheduler::run() {
+  std::vector<Request *> batch;
+  batch.reserve(options_.max_batch_size_);
+  Request *request;
+
+  for (;;) {
+    if (!queue_.pop(request)) {
+      if (stopping_.load() && pending_.load() == 0) {
+        break;
+      }
+      wait_for_work(options_.max_latency_);
+      continue;
+    }
+    pending_.fetch_sub(1);
+    batch.push_back(request);
+
+    // Keep filling the batch until it is full or the oldest request in it hits
+    // its latency deadline.
+    std::chrono::steady_clock::time_point deadline =
+        request->enqueue_time_ + options_.max_latency_;
+    while (batch.size() < options_.max_batch_size_) {
+      if (queue_.pop(request)) {
+        pending_.fetch_sub(1);
+        batch.push_back(request);
+        continue;
+      }
+      std::chrono::steady_clock::time_point now =
+          std::chrono::steady_clock::now();
+      if (now >= deadline || stopping_.load()) {
+        break;
+      }
+      wait_for_work(deadline - now);
+    }
+
+    run_batch(batch);
+    batch.clear();
+  }
+}
+
+void BatchScheduler::run_batch(std::vector<Request *> &batch) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  size_t n = batch.size();
+
+  // Gather the samples into one contiguous batch.
+  for (size_t b = 0; b < n; ++b) {
+    std::copy(batch[b]->input_->data_,
+              batch[b]->input_->data_ + input_numel_,
+              input_buffer_.data() + b * input_numel_);
+  }
+  input_size_[0] = n;
+  output_size_[0] = n;
+  FloatTensor input(input_buffer_.data(), input_size_.data(),
+                    input_size_.size());
+  FloatTensor output(output_buffer_.data(), output_size_.data(),
+                     output_size_.size());
+
+  std::exception_ptr error;
+  try {
+    forward_(input, output);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (size_t b = 0; b < n; ++b) {
+      if (!started_ || batch[b]->enqueue_time_ < first_enqueue_) {
+        first_enqueue_ = batch[b]->enqueue_time_;
+        started_ = true;
+      }
+      double latency_us =
+          std::chrono::duration<double, std::micro>(start -
+                                                    batch[b]->enqueue_time_)
+              .count();
+      if (latencies_us_.size() < kLatencyWindow) {
+        latencies_us_.push_back(latency_us);
+      } else {
+        latencies_us_[latency_cursor_] = latency_us;
+        latency_cursor_ = (latency_cursor_ + 1) % kLatencyWindow;
+      }
+    }
+    num_requests_ += n;
+    num_batches_ += 1;
+    last_completion_ = std::chrono::steady_clock::now();
+  }
+
+  // Scatter the results back and wake up the submitters.
+  for (size_t b = 0; b < n; ++b) {
+    if (error) {
+      batch[b]->promise_.set_exception(error);
+    } else {
+      std::copy(output_buffer_.data() + b * output_numel_,
+                output_buffer_.data() + (b + 1) * output_numel_,
+                batch[b]->output_->data_);
+      batch[b]->promise_.set_value();
+    }
+    delete batch[b];
+  }
+}
+
+} // namespace focus
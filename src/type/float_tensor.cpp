@@ -10,12 +10,16 @@
 
 #include "type/float_tensor.h"
 
+#include <stdexcept>
+#include <string>
+
 namespace focus {
 
 FloatTensor::FloatTensor(float *data, size_t *size, size_t ndim,
                          bool requires_grad, bool requires_allocation)
     : data_(data), size_(size), ndim_(ndim), requires_grad_(requires_grad),
-      requires_allocation_(requires_allocation) {
+      requires_allocation_(requires_allocation), placed_(false),
+      frozen_(false) {
 
   // Calculate the number of elements based on the provided size.
   numel_ = 1;
@@ -39,7 +43,57 @@ FloatTensor::FloatTensor(float *data, size_t *size, size_t ndim,
   }
 }
 
+/**
+ * @brief Allocates the data, and the gradient when `requires_grad` is `true`,
+ * with `placed_alloc`.
+ *
+ * The data is copied from input `data`, or zeroed when it is `nullptr`.
+ *
+ * @param data Optional initial values, may be `nullptr`.
+ * @param size The extent of each dimension.
+ * @param ndim Number of dimensions.
+ * @param placement NUMA node and page-size policies.
+ * @param requires_grad `true` to allocate a gradient.
+ */
+FloatTensor::FloatTensor(const float *data, size_t *size, size_t ndim,
+                         const PlacementOptions &placement, bool requires_grad)
+    : data_(nullptr), requires_grad_(requires_grad), grad_(nullptr),
+      requires_allocation_(true), placed_(true), frozen_(false),
+      ndim_(ndim) {
+  numel_ = 1;
+  for (size_t dim = 0; dim < ndim; ++dim) {
+    numel_ *= size[dim];
+  }
+
+  size_ = new size_t[ndim];
+  for (size_t dim = 0; dim < ndim; ++dim) {
+    size_[dim] = size[dim];
+  }
+
+  try {
+    data_ = static_cast<float *>(
+        placed_alloc(numel_ * sizeof(float), placement, data));
+    if (requires_grad_) {
+      grad_ = static_cast<float *>(
+          placed_alloc(numel_ * sizeof(float), placement));
+    }
+  } catch (...) {
+    placed_free(data_);
+    delete[] size_;
+    throw;
+  }
+}
+
 FloatTensor::~FloatTensor() {
+  if (placed_) {
+    placed_free(data_);
+    delete[] size_;
+    if (requires_grad_) {
+      placed_free(grad_);
+    }
+    return;
+  }
+
   if (requires_allocation_) {
     delete[] data_;
     delete[] size_;
@@ -50,6 +104,24 @@ FloatTensor::~FloatTensor() {
   }
 }
 
+/**
+ * @brief Makes the stored data read-only.
+ *
+ * The in-place methods, and every op given the tensor as an output, throw
+ * `std::logic_error` afterwards, and storage from `placed_alloc` is also
+ * write-protected in hardware. Freezing cannot be undone. A frozen tensor can
+ * be read by any number of threads without locks.
+ */
+void FloatTensor::freeze_() {
+  if (frozen_) {
+    return;
+  }
+  if (placed_) {
+    placed_protect(data_);
+  }
+  frozen_ = true;
+}
+
 /**
  * @brief Zeros every element in the stored gradient.
  */
@@ -66,7 +138,8 @@ void FloatTensor::zero_grad_() {
  *
  * @param other The tensor to add by.
  */
-void FloatTensor::add_(FloatTensor &other) {
+void FloatTensor::add_(const FloatTensor &other) {
+  check_mutable("FloatTensor", *this);
   for (size_t i = 0; i < numel_; ++i) {
     data_[i] += other.data_[i];
   }
@@ -80,6 +153,7 @@ void FloatTensor::add_(FloatTensor &other) {
  * @param value The value to add by.
  */
 void FloatTensor::add_(float value) {
+  check_mutable("FloatTensor", *this);
   for (size_t i = 0; i < numel_; ++i) {
     data_[i] += value;
   }
@@ -104,7 +178,8 @@ FloatTensor &FloatTensor::operator+=(float value) {
  *
  * @param other The tensor to subtract by.
  */
-void FloatTensor::sub_(FloatTensor &other) {
+void FloatTensor::sub_(const FloatTensor &other) {
+  check_mutable("FloatTensor", *this);
   for (size_t i = 0; i < numel_; ++i) {
     data_[i] -= other.data_[i];
   }
@@ -118,6 +193,7 @@ void FloatTensor::sub_(FloatTensor &other) {
  * @param value The value to subtract by.
  */
 void FloatTensor::sub_(float value) {
+  check_mutable("FloatTensor", *this);
   for (size_t i = 0; i < numel_; ++i) {
     data_[i] -= value;
   }
@@ -143,6 +219,7 @@ FloatTensor &FloatTensor::operator-=(float value) {
  * @param value The value to multiply by.
  */
 void FloatTensor::mul_(float value) {
+  check_mutable("FloatTensor", *this);
   for (size_t i = 0; i < numel_; ++i) {
     data_[i] *= value;
   }
@@ -168,6 +245,7 @@ FloatTensor &FloatTensor::operator*=(float value) {
  * @param value The value to divide by.
  */
 void FloatTensor::div_(float value) {
+  check_mutable("FloatTensor", *this);
   for (size_t i = 0; i < numel_; ++i) {
     data_[i] /= value;
   }
@@ -190,7 +268,7 @@ FloatTensor &FloatTensor::operator/=(float value) {
  *
  * @return float
  */
-float FloatTensor::sum_() {
+float FloatTensor::sum_() const {
   float out = 0;
   for (size_t i = 0; i < numel_; ++i) {
     out += data_[i];
@@ -198,4 +276,19 @@ float FloatTensor::sum_() {
   return out;
 }
 
+/**
+ * @brief Throws `std::logic_error` if `tensor` is frozen.
+ *
+ * Every op calls this on the tensors whose data it overwrites or updates, so
+ * a frozen tensor cannot be passed as an output.
+ *
+ * @param op The caller's name, used in the message.
+ * @param tensor The tensor about to be written.
+ */
+void check_mutable(const char *op, const FloatTensor &tensor) {
+  if (tensor.frozen_) {
+    throw std::logic_error(std::string(op) + ": tensor is frozen");
+  }
+}
+
 } // namespace focus
@@ -0,0 +1,469 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// paged_tensor.cpp
+//
+// Identification: src/type/paged_tensor.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/paged_tensor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <system_error>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "common/thread_pool.h"
+
+namespace focus {
+
+namespace {
+
+std::system_error os_error(const std::string &what) {
+  return std::system_error(errno, std::generic_category(), what);
+}
+
+int open_scratch(const std::string &dir) {
+  std::string base = dir;
+  if (base.empty()) {
+    const char *env = std::getenv("TMPDIR");
+    base = env != nullptr && env[0] != '\0' ? env : "/tmp";
+  }
+  std::string path = base + "/focus-paged-XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back('\0');
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    throw os_error("PagedTensor: mkstemp " + path);
+  }
+  // The file lives only as long as the descriptor.
+  unlink(name.data());
+  return fd;
+}
+
+void write_all(int fd, const float *data, size_t numel, off_t offset) {
+  const char *bytes = reinterpret_cast<const char *>(data);
+  size_t left = numel * sizeof(float);
+  while (left > 0) {
+    ssize_t n = pwrite(fd, bytes, left, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw os_error("PagedTensor: pwrite");
+    }
+    bytes += n;
+    left -= static_cast<size_t>(n);
+    offset += n;
+  }
+}
+
+void read_all(int fd, float *data, size_t numel, off_t offset) {
+  char *bytes = reinterpret_cast<char *>(data);
+  size_t left = numel * sizeof(float);
+  while (left > 0) {
+    ssize_t n = pread(fd, bytes, left, offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      throw n == 0 ? std::runtime_error("PagedTensor: short read")
+                   : os_error("PagedTensor: pread");
+    }
+    bytes += n;
+    left -= static_cast<size_t>(n);
+    offset += n;
+  }
+}
+
+} // namespace
+
+/**
+ * @param size The extent of each dimension.
+ * @param ndim Number of dimensions.
+ * @param options Chunking, budget and scratch options.
+ */
+PagedTensor::PagedTensor(const size_t *size, size_t ndim,
+                         PagedTensorOptions options)
+    : size_(size, size + ndim), ndim_(ndim), numel_(1), options_(options),
+      fd_(-1), in_memory_(0), clock_(0), stopping_(false) {
+  if (options_.chunk_numel_ == 0) {
+    throw std::invalid_argument("PagedTensor: chunk_numel_ must be > 0");
+  }
+  for (size_t dim = 0; dim < ndim; ++dim) {
+    numel_ *= size[dim];
+  }
+  const size_t chunk_bytes = options_.chunk_numel_ * sizeof(float);
+  max_resident_ = std::max<size_t>(1, options_.memory_budget_ / chunk_bytes);
+  chunks_.resize((numel_ + options_.chunk_numel_ - 1) / options_.chunk_numel_);
+  fd_ = open_scratch(options_.scratch_dir_);
+  worker_ = std::thread(&PagedTensor::run, this);
+}
+
+PagedTensor::~PagedTensor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+  close(fd_);
+}
+
+/**
+ * @brief Returns the number of floats in chunk `chunk`, which is less than
+ * `chunk_numel_` only for the last chunk.
+ */
+size_t PagedTensor::chunk_size(size_t chunk) const {
+  const size_t offset = chunk * options_.chunk_numel_;
+  return std::min(options_.chunk_numel_, numel_ - offset);
+}
+
+/**
+ * @brief Makes chunk `chunk` resident and keeps it from being evicted until
+ * the matching `unpin`.
+ *
+ * @param chunk The chunk index.
+ * @param write `true` if the caller will modify the chunk.
+ * @return The first float of the chunk.
+ */
+float *PagedTensor::pin(size_t chunk, bool write) {
+  if (chunk >= chunks_.size()) {
+    throw std::out_of_range("PagedTensor: chunk out of range");
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    Chunk &c = chunks_[chunk];
+    if (c.state_ == ChunkState::RESIDENT) {
+      ++c.pins_;
+      c.last_use_ = ++clock_;
+      c.dirty_ = c.dirty_ || write;
+      return c.data_.data();
+    }
+    if (c.state_ == ChunkState::ABSENT) {
+      load(chunk, lock, false);
+    } else {
+      cv_.wait(lock);
+    }
+  }
+}
+
+/**
+ * @brief Releases a pin taken by `pin`.
+ *
+ * @param chunk The chunk index.
+ */
+void PagedTensor::unpin(size_t chunk) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Chunk &c = chunks_.at(chunk);
+  if (c.pins_ == 0) {
+    throw std::logic_error("PagedTensor: unpin without pin");
+  }
+  --c.pins_;
+}
+
+/**
+ * @brief Asks the background thread to load chunk `chunk`.
+ *
+ * @param chunk The chunk index.
+ */
+void PagedTensor::prefetch(size_t chunk) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Chunk &c = chunks_.at(chunk);
+    if (c.state_ != ChunkState::ABSENT || c.queued_) {
+      return;
+    }
+    c.queued_ = true;
+    prefetch_queue_.push_back(chunk);
+  }
+  cv_.notify_all();
+}
+
+/**
+ * @brief Runs `fn(offset, data, count)` over every chunk in order, where
+ * `offset` is the index of `data[0]` in the tensor. The next chunks are
+ * prefetched while `fn` runs.
+ *
+ * @param write `true` if `fn` modifies the chunks.
+ * @param fn The function to run on each chunk.
+ */
+void PagedTensor::for_each_chunk(
+    bool write, const std::function<void(size_t, float *, size_t)> &fn) {
+  // Keep the chunk in use resident alongside the read-ahead.
+  const size_t depth = std::min(options_.prefetch_depth_, max_resident_ - 1);
+  for (size_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+    for (size_t ahead = 1; ahead <= depth; ++ahead) {
+      if (chunk + ahead < chunks_.size()) {
+        prefetch(chunk + ahead);
+      }
+    }
+    float *data = pin(chunk, write);
+    try {
+      fn(chunk * options_.chunk_numel_, data, chunk_size(chunk));
+    } catch (...) {
+      unpin(chunk);
+      throw;
+    }
+    unpin(chunk);
+  }
+}
+
+/**
+ * @brief Sets every element to input `value`.
+ *
+ * @param value The value to fill with.
+ */
+void PagedTensor::fill_(float value) {
+  for_each_chunk(true, [value](size_t, float *data, size_t n) {
+    parallel_for(0, n, [&](size_t lo, size_t hi) {
+      std::fill(data + lo, data + hi, value);
+    });
+  });
+}
+
+/**
+ * @brief Adds input `value` to each element.
+ *
+ * @param value The value to add by.
+ */
+void PagedTensor::add_(float value) {
+  for_each_chunk(true, [value](size_t, float *data, size_t n) {
+    parallel_for(0, n, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        data[i] += value;
+      }
+    });
+  });
+}
+
+/**
+ * @brief Adds input `other`, which must have the same number of elements.
+ *
+ * @param other The tensor to add by.
+ */
+void PagedTensor::add_(PagedTensor &other) {
+  if (other.numel_ != numel_) {
+    throw std::invalid_argument("PagedTensor: add_ shape mismatch");
+  }
+  // The chunk grids may differ, so walk ours and pin the overlapping pieces
+  // of `other`.
+  for_each_chunk(true, [&other](size_t offset, float *data, size_t n) {
+    size_t done = 0;
+    while (done < n) {
+      const size_t index = offset + done;
+      const size_t chunk = index / other.options_.chunk_numel_;
+      const size_t start = index % other.options_.chunk_numel_;
+      const size_t count = std::min(n - done, other.chunk_size(chunk) - start);
+      if (start == 0 && chunk + 1 < other.num_chunks()) {
+        other.prefetch(chunk + 1);
+      }
+      const float *src = other.pin(chunk, false) + start;
+      float *dst = data + done;
+      parallel_for(0, count, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+          dst[i] += src[i];
+        }
+      });
+      other.unpin(chunk);
+      done += count;
+    }
+  });
+}
+
+/**
+ * @brief Multiplies each element by input `value`.
+ *
+ * @param value The value to multiply by.
+ */
+void PagedTensor::mul_(float value) {
+  for_each_chunk(true, [value](size_t, float *data, size_t n) {
+    parallel_for(0, n, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        data[i] *= value;
+      }
+    });
+  });
+}
+
+/**
+ * @brief Returns the sum of all the elements.
+ *
+ * @return float
+ */
+float PagedTensor::sum_() {
+  // Accumulate chunks in double so long tensors do not lose small addends.
+  double total = 0;
+  for_each_chunk(false, [&total](size_t, float *data, size_t n) {
+    double acc = 0;
+    for (size_t i = 0; i < n; ++i) {
+      acc += data[i];
+    }
+    total += acc;
+  });
+  return static_cast<float>(total);
+}
+
+/**
+ * @brief Copies `numel_` floats from `src` into the tensor.
+ *
+ * @param src The source values.
+ */
+void PagedTensor::copy_from(const float *src) {
+  for_each_chunk(true, [src](size_t offset, float *data, size_t n) {
+    std::copy(src + offset, src + offset + n, data);
+  });
+}
+
+/**
+ * @brief Copies the tensor into `numel_` floats at `dst`.
+ *
+ * @param dst The destination.
+ */
+void PagedTensor::copy_to(float *dst) {
+  for_each_chunk(false, [dst](size_t offset, float *data, size_t n) {
+    std::copy(data, data + n, dst + offset);
+  });
+}
+
+/** @brief Returns the number of chunks held in memory. */
+size_t PagedTensor::resident_chunks() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    count += chunks_[i].state_ == ChunkState::RESIDENT;
+  }
+  return count;
+}
+
+/** @brief Returns the paging counters. */
+PagedTensorStats PagedTensor::stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+// Requires `lock` on `mutex_` and `chunk` ABSENT. Drops the lock around I/O;
+// the LOADING state keeps other threads off the chunk meanwhile.
+void PagedTensor::load(size_t chunk, std::unique_lock<std::mutex> &lock,
+                       bool prefetch) {
+  Chunk &c = chunks_[chunk];
+  c.state_ = ChunkState::LOADING;
+  ++in_memory_;
+  try {
+    make_room(chunk, lock);
+  } catch (...) {
+    c.state_ = ChunkState::ABSENT;
+    --in_memory_;
+    cv_.notify_all();
+    throw;
+  }
+
+  std::vector<float> buffer;
+  if (!free_buffers_.empty()) {
+    buffer.swap(free_buffers_.back());
+    free_buffers_.pop_back();
+  }
+  const size_t n = chunk_size(chunk);
+  const bool on_disk = c.on_disk_;
+  lock.unlock();
+  try {
+    buffer.resize(n);
+    if (on_disk) {
+      read_all(fd_, buffer.data(), n,
+               static_cast<off_t>(chunk * options_.chunk_numel_ *
+                                  sizeof(float)));
+    } else {
+      std::fill(buffer.begin(), buffer.end(), 0.0f);
+    }
+  } catch (...) {
+    lock.lock();
+    c.state_ = ChunkState::ABSENT;
+    --in_memory_;
+    cv_.notify_all();
+    throw;
+  }
+  lock.lock();
+
+  c.data_.swap(buffer);
+  c.state_ = ChunkState::RESIDENT;
+  c.last_use_ = ++clock_;
+  stats_.faults_ += on_disk;
+  stats_.prefetches_ += prefetch;
+  cv_.notify_all();
+}
+
+// Requires `lock` on `mutex_`. Evicts least recently used unpinned chunks,
+// writing dirty ones back, until the budget holds or nothing can be evicted.
+void PagedTensor::make_room(size_t loading,
+                            std::unique_lock<std::mutex> &lock) {
+  while (in_memory_ > max_resident_) {
+    size_t victim = chunks_.size();
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+      const Chunk &c = chunks_[i];
+      if (i != loading && c.state_ == ChunkState::RESIDENT && c.pins_ == 0 &&
+          (victim == chunks_.size() ||
+           c.last_use_ < chunks_[victim].last_use_)) {
+        victim = i;
+      }
+    }
+    if (victim == chunks_.size()) {
+      return;
+    }
+
+    Chunk &c = chunks_[victim];
+    if (c.dirty_) {
+      c.state_ = ChunkState::WRITING;
+      lock.unlock();
+      try {
+        write_all(fd_, c.data_.data(), c.data_.size(),
+                  static_cast<off_t>(victim * options_.chunk_numel_ *
+                                     sizeof(float)));
+      } catch (...) {
+        lock.lock();
+        c.state_ = ChunkState::RESIDENT;
+        cv_.notify_all();
+        throw;
+      }
+      lock.lock();
+      c.dirty_ = false;
+      c.on_disk_ = true;
+      ++stats_.writebacks_;
+    }
+    c.state_ = ChunkState::ABSENT;
+    free_buffers_.push_back(std::vector<float>());
+    free_buffers_.back().swap(c.data_);
+    --in_memory_;
+    ++stats_.evictions_;
+    cv_.notify_all();
+  }
+}
+
+void PagedTensor::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this] { return stopping_ || !prefetch_queue_.empty(); });
+    if (stopping_) {
+      return;
+    }
+    const size_t chunk = prefetch_queue_.front();
+    prefetch_queue_.pop_front();
+    Chunk &c = chunks_[chunk];
+    c.queued_ = false;
+    if (c.state_ != ChunkState::ABSENT) {
+      continue;
+    }
+    try {
+      load(chunk, lock, true);
+    } catch (...) {
+      // A failed read-ahead resurfaces when the chunk is pinned.
+    }
+  }
+}
+
+} // namespace focus
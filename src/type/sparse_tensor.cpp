@@ -0,0 +1,195 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sparse_tensor.cpp
+//
+// Identification: src/type/sparse_tensor.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/sparse_tensor.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace focus {
+
+namespace {
+
+void check_matrix(const FloatTensor &dense, size_t rows, size_t cols) {
+  if (dense.ndim_ != 2 || dense.size_[0] != rows || dense.size_[1] != cols) {
+    throw std::invalid_argument("sparse tensor: dense shape mismatch");
+  }
+}
+
+void check_extents(size_t rows, size_t cols) {
+  if (rows > std::numeric_limits<uint32_t>::max() ||
+      cols > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("sparse tensor: extent exceeds 32-bit index");
+  }
+}
+
+} // namespace
+
+CooTensor::CooTensor(size_t rows, size_t cols) : rows_(rows), cols_(cols) {
+  check_extents(rows, cols);
+}
+
+CooTensor::CooTensor(const FloatTensor &dense) {
+  if (dense.ndim_ != 2) {
+    throw std::invalid_argument("CooTensor: expected a 2-D tensor");
+  }
+  rows_ = dense.size_[0];
+  cols_ = dense.size_[1];
+  check_extents(rows_, cols_);
+  for (size_t r = 0; r < rows_; ++r) {
+    const float *row = dense.data_ + r * cols_;
+    for (size_t c = 0; c < cols_; ++c) {
+      if (row[c] != 0) {
+        row_indices_.push_back(static_cast<uint32_t>(r));
+        col_indices_.push_back(static_cast<uint32_t>(c));
+        values_.push_back(row[c]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Appends input `value` at position (`row`, `col`).
+ *
+ * Entries may be appended in any order; duplicates are summed when
+ * converting.
+ *
+ * @param row The row index.
+ * @param col The column index.
+ * @param value The value to store.
+ */
+void CooTensor::push_back(size_t row, size_t col, float value) {
+  if (row >= rows_ || col >= cols_) {
+    throw std::out_of_range("CooTensor: index out of range");
+  }
+  row_indices_.push_back(static_cast<uint32_t>(row));
+  col_indices_.push_back(static_cast<uint32_t>(col));
+  values_.push_back(value);
+}
+
+/**
+ * @brief Writes the matrix into input `dense`, which must be 2-D and of
+ * matching shape.
+ *
+ * @param dense The tensor to overwrite.
+ */
+void CooTensor::to_dense(FloatTensor &dense) const {
+  check_matrix(dense, rows_, cols_);
+  check_mutable("to_dense", dense);
+  std::fill(dense.data_, dense.data_ + dense.numel_, 0.0f);
+  for (size_t i = 0; i < values_.size(); ++i) {
+    dense.data_[row_indices_[i] * cols_ + col_indices_[i]] += values_[i];
+  }
+}
+
+CsrTensor::CsrTensor(size_t rows, size_t cols)
+    : rows_(rows), cols_(cols), row_ptr_(rows + 1, 0) {
+  check_extents(rows, cols);
+}
+
+CsrTensor::CsrTensor(const FloatTensor &dense) {
+  if (dense.ndim_ != 2) {
+    throw std::invalid_argument("CsrTensor: expected a 2-D tensor");
+  }
+  rows_ = dense.size_[0];
+  cols_ = dense.size_[1];
+  check_extents(rows_, cols_);
+  row_ptr_.reserve(rows_ + 1);
+  row_ptr_.push_back(0);
+  for (size_t r = 0; r < rows_; ++r) {
+    const float *row = dense.data_ + r * cols_;
+    for (size_t c = 0; c < cols_; ++c) {
+      if (row[c] != 0) {
+        col_indices_.push_back(static_cast<uint32_t>(c));
+        values_.push_back(row[c]);
+      }
+    }
+    row_ptr_.push_back(values_.size());
+  }
+}
+
+CsrTensor::CsrTensor(const CooTensor &coo)
+    : rows_(coo.rows_), cols_(coo.cols_), row_ptr_(coo.rows_ + 1, 0) {
+  // Counting sort by row, then sort each row by column and fold duplicates.
+  for (size_t i = 0; i < coo.nnz(); ++i) {
+    ++row_ptr_[coo.row_indices_[i] + 1];
+  }
+  for (size_t r = 0; r < rows_; ++r) {
+    row_ptr_[r + 1] += row_ptr_[r];
+  }
+  std::vector<size_t> cursor(row_ptr_.begin(), row_ptr_.end() - 1);
+  std::vector<std::pair<uint32_t, float>> entries(coo.nnz());
+  for (size_t i = 0; i < coo.nnz(); ++i) {
+    entries[cursor[coo.row_indices_[i]]++] =
+        std::make_pair(coo.col_indices_[i], coo.values_[i]);
+  }
+
+  col_indices_.reserve(coo.nnz());
+  values_.reserve(coo.nnz());
+  size_t begin = 0;
+  for (size_t r = 0; r < rows_; ++r) {
+    size_t end = row_ptr_[r + 1];
+    std::sort(entries.begin() + begin, entries.begin() + end,
+              [](const std::pair<uint32_t, float> &a,
+                 const std::pair<uint32_t, float> &b) {
+                return a.first < b.first;
+              });
+    for (size_t i = begin; i < end; ++i) {
+      if (i > begin && entries[i].first == col_indices_.back()) {
+        values_.back() += entries[i].second;
+      } else {
+        col_indices_.push_back(entries[i].first);
+        values_.push_back(entries[i].second);
+      }
+    }
+    begin = end;
+    row_ptr_[r + 1] = values_.size();
+  }
+}
+
+/**
+ * @brief Returns the matrix in COO format.
+ *
+ * @return CooTensor
+ */
+CooTensor CsrTensor::to_coo() const {
+  CooTensor out(rows_, cols_);
+  out.row_indices_.reserve(nnz());
+  for (size_t r = 0; r < rows_; ++r) {
+    for (size_t i = row_ptr_[r]; i < row_ptr_[r + 1]; ++i) {
+      out.row_indices_.push_back(static_cast<uint32_t>(r));
+    }
+  }
+  out.col_indices_ = col_indices_;
+  out.values_ = values_;
+  return out;
+}
+
+/**
+ * @brief Writes the matrix into input `dense`, which must be 2-D and of
+ * matching shape.
+ *
+ * @param dense The tensor to overwrite.
+ */
+void CsrTensor::to_dense(FloatTensor &dense) const {
+  check_matrix(dense, rows_, cols_);
+  check_mutable("to_dense", dense);
+  std::fill(dense.data_, dense.data_ + dense.numel_, 0.0f);
+  for (size_t r = 0; r < rows_; ++r) {
+    float *row = dense.data_ + r * cols_;
+    for (size_t i = row_ptr_[r]; i < row_ptr_[r + 1]; ++i) {
+      row[col_indices_[i]] = values_[i];
+    }
+  }
+}
+
+} // namespace focus
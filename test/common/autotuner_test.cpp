@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// autotuner_test.cpp
+//
+// Identification: test/common/autotuner_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/autotuner.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace focus {
+
+std::string temp_cache_path(const std::string &name) {
+  std::string path = ::testing::TempDir() + "focus_" + name + ".cache";
+  std::remove(path.c_str());
+  return path;
+}
+
+// Candidate `c` sleeps for `delays_us[c]` microseconds.
+struct SleepKernel {
+  std::vector<int> delays_us;
+  std::vector<size_t> *calls;
+  void operator()(size_t c) {
+    (*calls)[c] += 1;
+    std::this_thread::sleep_for(std::chrono::microseconds(delays_us[c]));
+  }
+};
+
+TEST(AutotunerTest, AutotunerSelectsFastest) {
+  Autotuner tuner;
+  std::vector<size_t> calls(3, 0);
+  SleepKernel kernel = {{3000, 200, 3000}, &calls};
+  EXPECT_EQ(tuner.select("op", "n=1", 3, kernel), 1);
+  EXPECT_EQ(calls[0], tuner.repeats_ + 1);
+
+  // Cached in memory: no more runs.
+  EXPECT_EQ(tuner.select("op", "n=1", 3, kernel), 1);
+  EXPECT_EQ(calls[1], tuner.repeats_ + 1);
+
+  // Another signature is tuned separately.
+  SleepKernel other = {{200, 3000, 3000}, &calls};
+  EXPECT_EQ(tuner.select("op", "n=2", 3, other), 0);
+}
+
+TEST(AutotunerTest, AutotunerPersistsAcrossInstances) {
+  std::string path = temp_cache_path("persist");
+  {
+    Autotuner tuner(path, "cpu-a");
+    tuner.record("conv", "k=3", 2);
+  }
+
+  Autotuner tuner(path, "cpu-a");
+  std::vector<size_t> calls(3, 0);
+  SleepKernel kernel = {{0, 0, 0}, &calls};
+  EXPECT_EQ(tuner.select("conv", "k=3", 3, kernel), 2);
+  EXPECT_EQ(calls[0] + calls[1] + calls[2], 0);
+  std::remove(path.c_str());
+}
+
+TEST(AutotunerTest, AutotunerConcurrentSavesStayReadable) {
+  std::string path = temp_cache_path("concurrent");
+  std::vector<std::thread> writers;
+  for (size_t t = 0; t < 8; ++t) {
+    writers.emplace_back([path, t] {
+      Autotuner tuner(path, "cpu-" + std::to_string(t));
+      for (size_t i = 0; i < 20; ++i) {
+        tuner.record("op", "n=" + std::to_string(i), t);
+      }
+    });
+  }
+  for (std::thread &writer : writers) {
+    writer.join();
+  }
+
+  // Whichever writer renamed last, the published table is complete for its
+  // CPU model.
+  std::ifstream in(path.c_str());
+  std::string header;
+  ASSERT_TRUE(static_cast<bool>(std::getline(in, header)));
+  EXPECT_EQ(header, "focus-tuning-cache\t1");
+  bool found = false;
+  for (size_t t = 0; t < 8 && !found; ++t) {
+    Autotuner tuner(path, "cpu-" + std::to_string(t));
+    size_t choice;
+    if (tuner.lookup("op", "n=19", choice)) {
+      EXPECT_EQ(choice, t);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+  std::remove(path.c_str());
+}
+
+TEST(AutotunerTest, AutotunerKeysByCpuModel) {
+  std::string path = temp_cache_path("cpu");
+  {
+    Autotuner tuner(path, "cpu-a");
+    tuner.record("conv", "k=3", 2);
+  }
+  {
+    Autotuner tuner(path, "cpu-b");
+    size_t choice;
+    EXPECT_FALSE(tuner.lookup("conv", "k=3", choice));
+    tuner.record("conv", "k=3", 1);
+  }
+
+  // Both sections survive.
+  size_t choice = 0;
+  Autotuner a(path, "cpu-a");
+  EXPECT_TRUE(a.lookup("conv", "k=3", choice));
+  EXPECT_EQ(choice, 2);
+  Autotuner b(path, "cpu-b");
+  EXPECT_TRUE(b.lookup("conv", "k=3", choice));
+  EXPECT_EQ(choice, 1);
+  std::remove(path.c_str());
+}
+
+TEST(AutotunerTest, AutotunerIgnoresOtherVersions) {
+  std::string path = temp_cache_path("version");
+  {
+    std::ofstream out(path.c_str());
+    out << "focus-tuning-cache\t0\ncpu\tcpu-a\nconv\tk=3\t2\n";
+  }
+  Autotuner tuner(path, "cpu-a");
+  size_t choice;
+  EXPECT_FALSE(tuner.lookup("conv", "k=3", choice));
+  EXPECT_THROW(tuner.record("conv", "k 3", 0), std::invalid_argument);
+  std::remove(path.c_str());
+}
+
+} // namespace focus
@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// placement_test.cpp
+//
+// Identification: test/common/placement_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/placement.h"
+#include "gtest/gtest.h"
+#include "type/float_tensor.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+size_t resident_bytes(const PlacementReport &report) {
+  return std::accumulate(report.node_bytes_.begin(), report.node_bytes_.end(),
+                         size_t(0));
+}
+
+TEST(PlacementTest, EveryPolicyCopiesInitialValues) {
+  size_t numel = (size_t(3) << 20) / sizeof(float) + 17;
+  std::vector<float> values(numel);
+  for (size_t i = 0; i < numel; ++i) {
+    values[i] = static_cast<float>(i % 1000);
+  }
+
+  NumaPolicy policies[] = {NumaPolicy::DEFAULT, NumaPolicy::BIND,
+                           NumaPolicy::INTERLEAVE,
+                           NumaPolicy::PARALLEL_PREFAULT};
+  HugePagePolicy pages[] = {HugePagePolicy::NONE, HugePagePolicy::TRANSPARENT,
+                            HugePagePolicy::EXPLICIT};
+  for (NumaPolicy policy : policies) {
+    for (HugePagePolicy page : pages) {
+      PlacementOptions options;
+      options.numa_ = policy;
+      options.huge_pages_ = page;
+      float *data = static_cast<float *>(
+          placed_alloc(numel * sizeof(float), options, values.data()));
+      ASSERT_NE(data, nullptr);
+      for (size_t i = 0; i < numel; i += 997) {
+        EXPECT_EQ(data[i], values[i]);
+      }
+      EXPECT_EQ(data[numel - 1], values[numel - 1]);
+
+      // Every page was written, so none is left unresident.
+      PlacementReport report = placement_report(data, numel * sizeof(float));
+      EXPECT_EQ(report.unresident_bytes_, 0u);
+      EXPECT_EQ(resident_bytes(report) + report.unknown_bytes_,
+                numel * sizeof(float));
+      placed_free(data);
+    }
+  }
+}
+
+TEST(PlacementTest, UntouchedPagesAreUnresident) {
+  PlacementOptions options;
+  size_t bytes = size_t(1) << 20;
+  char *data = static_cast<char *>(placed_alloc(bytes, options));
+  PlacementReport report = placement_report(data, bytes);
+  EXPECT_EQ(resident_bytes(report), 0u);
+  EXPECT_EQ(report.unresident_bytes_ + report.unknown_bytes_, bytes);
+  placed_free(data);
+}
+
+TEST(PlacementTest, TensorStorageIsReported) {
+  PlacementReport before = placement_report();
+  size_t size[2] = {512, 1024};
+  PlacementOptions options;
+  options.numa_ = NumaPolicy::PARALLEL_PREFAULT;
+  {
+    FloatTensor x(nullptr, size, 2, options, true);
+    EXPECT_TRUE(x.placed_);
+    EXPECT_EQ(x.numel_, 512u * 1024u);
+    EXPECT_EQ(x.size_[1], 1024u);
+    for (size_t i = 0; i < x.numel_; i += 4099) {
+      EXPECT_EQ(x.data_[i], 0);
+      EXPECT_EQ(x.grad_[i], 0);
+    }
+    x.add_(2);
+    EXPECT_EQ(x.sum_(), 2.0f * x.numel_);
+
+    // Data and gradient are both tracked.
+    PlacementReport during = placement_report();
+    size_t tracked = resident_bytes(during) + during.unknown_bytes_ -
+                     resident_bytes(before) - before.unknown_bytes_;
+    EXPECT_EQ(tracked, 2 * x.numel_ * sizeof(float));
+    EXPECT_NE(during.to_string().find("node 0:"), std::string::npos);
+  }
+  PlacementReport after = placement_report();
+  EXPECT_EQ(resident_bytes(after) + after.unknown_bytes_,
+            resident_bytes(before) + before.unknown_bytes_);
+}
+
+TEST(PlacementTest, RejectsInvalidRequests) {
+  EXPECT_GE(numa_node_count(), 1u);
+  PlacementOptions options;
+  options.numa_ = NumaPolicy::BIND;
+  options.node_ = numa_node_count();
+  EXPECT_THROW(placed_alloc(4096, options), std::out_of_range);
+
+  int local = 0;
+  EXPECT_THROW(placed_free(&local), std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// thread_pool_test.cpp
+//
+// Identification: test/common/thread_pool_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/thread_pool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+TEST(ThreadPoolTest, ThreadPoolParallelForCoversRange) {
+  ThreadPool pool(4);
+  std::vector<int> hits(1000, 0);
+  pool.parallel_for(0, hits.size(), [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      hits[i] += 1;
+    }
+  });
+  for (size_t i = 0; i < hits.size(); ++i) {
+    EXPECT_EQ(hits[i], 1);
+  }
+}
+
+TEST(ThreadPoolTest, ThreadPoolParallelForSplitsIntoRanges) {
+  ThreadPool pool(4);
+  std::atomic<size_t> calls(0);
+  pool.parallel_for(0, 3, [&](size_t lo, size_t hi) {
+    EXPECT_LT(lo, hi);
+    calls.fetch_add(1);
+  });
+  EXPECT_EQ(calls.load(), 3);
+}
+
+TEST(ThreadPoolTest, ThreadPoolNestedParallelFor) {
+  ThreadPool pool(2);
+  std::atomic<size_t> total(0);
+  pool.parallel_for(0, 4, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) {
+      pool.parallel_for(0, 10, [&](size_t a, size_t b) {
+        total.fetch_add(b - a);
+      });
+    }
+  });
+  EXPECT_EQ(total.load(), 40);
+}
+
+TEST(ThreadPoolTest, ThreadPoolParallelForRethrows) {
+  ThreadPool pool(4);
+  EXPECT_THROW(pool.parallel_for(0, 8,
+                                 [](size_t lo, size_t) {
+                                   if (lo > 0) {
+                                     throw std::runtime_error("failed");
+                                   }
+                                 }),
+               std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ThreadPoolSubmit) {
+  ThreadPool pool(2);
+  std::promise<int> result;
+  pool.submit([&] { result.set_value(42); });
+  EXPECT_EQ(result.get_future().get(), 42);
+}
+
+} // namespace focus
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// workspace_test.cpp
+//
+// Identification: test/common/workspace_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/workspace.h"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <thread>
+
+namespace focus {
+
+TEST(WorkspaceTest, ScopesReleaseInStackOrder) {
+  Workspace workspace;
+  {
+    WorkspaceScope outer(workspace);
+    float *a = outer.alloc<float>(10);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0u);
+    a[9] = 1;
+    size_t used = workspace.used();
+    {
+      WorkspaceScope inner(workspace);
+      double *b = inner.alloc<double>(100);
+      b[99] = 2;
+      EXPECT_GT(workspace.used(), used);
+    }
+    EXPECT_EQ(workspace.used(), used);
+    EXPECT_EQ(a[9], 1);
+  }
+  EXPECT_EQ(workspace.used(), 0u);
+}
+
+TEST(WorkspaceTest, GrowsToHighWaterMarkThenStops) {
+  Workspace workspace;
+  for (size_t round = 0; round < 3; ++round) {
+    WorkspaceScope scope(workspace);
+    // Larger than the first block, so the first round chains blocks.
+    float *small = scope.alloc<float>(1000);
+    float *large = scope.alloc<float>(1 << 20);
+    small[0] = 1;
+    large[(1 << 20) - 1] = 2;
+    EXPECT_EQ(small[0], 1);
+  }
+  // The chain was merged once, and later rounds reuse the single block.
+  EXPECT_EQ(workspace.num_blocks(), 1u);
+  EXPECT_GE(workspace.capacity(), workspace.high_water());
+  size_t capacity = workspace.capacity();
+  {
+    WorkspaceScope scope(workspace);
+    scope.alloc<float>(1000);
+    scope.alloc<float>(1 << 20);
+  }
+  EXPECT_EQ(workspace.capacity(), capacity);
+  EXPECT_EQ(workspace.num_blocks(), 1u);
+}
+
+TEST(WorkspaceTest, EachThreadHasItsOwnWorkspace) {
+  Workspace *main = &Workspace::local();
+  Workspace *other = nullptr;
+  std::thread thread([&] { other = &Workspace::local(); });
+  thread.join();
+  EXPECT_NE(main, other);
+  EXPECT_EQ(main, &Workspace::local());
+}
+
+} // namespace focus
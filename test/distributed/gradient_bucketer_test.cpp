@@ -0,0 +1,197 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// gradient_bucketer_test.cpp
+//
+// Identification: test/distributed/gradient_bucketer_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "distributed/gradient_bucketer.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace focus {
+
+/*
+ * One rank of a toy data-parallel step: three parameters whose gradients
+ * depend on the rank, marked ready in backward order, reduced twice.
+ */
+bool run_training_rank(const std::string &name, size_t rank, size_t world) {
+  ProcessGroup group(name, getppid(), rank, world, 256);
+  size_t sizes[3] = {100, 300, 50};
+  std::vector<float> data(sizes[0] + sizes[1] + sizes[2]);
+  FloatTensor w0(data.data(), &sizes[0], 1, true);
+  FloatTensor w1(data.data(), &sizes[1], 1, true);
+  FloatTensor w2(data.data(), &sizes[2], 1, true);
+  FloatTensor *params[3] = {&w0, &w1, &w2};
+
+  GradientBucketerOptions options;
+  options.bucket_numel_ = 350;
+  GradientBucketer bucketer(group, {&w0, &w1, &w2},
+                            options);
+  if (bucketer.num_buckets() != 2) {
+    return false;
+  }
+
+  for (size_t step = 0; step < 2; ++step) {
+    // Backward walks the parameters last to first; odd ranks finish them in
+    // a different order to exercise the in-order launch.
+    for (size_t k = 0; k < 3; ++k) {
+      size_t p = rank % 2 == 0 ? 2 - k : k;
+      for (size_t i = 0; i < sizes[p]; ++i) {
+        params[p]->grad_[i] = static_cast<float>(rank * (step + 1) + p + i % 7);
+      }
+      bucketer.mark_ready(*params[p]);
+    }
+    bucketer.wait();
+
+    // Mean over ranks of `rank * (step + 1)` is `(world - 1) / 2 * (step + 1)`.
+    for (size_t p = 0; p < 3; ++p) {
+      for (size_t i = 0; i < sizes[p]; ++i) {
+        float expected =
+            (world - 1) / 2.0f * (step + 1) + static_cast<float>(p + i % 7);
+        if (params[p]->grad_[i] != expected) {
+          return false;
+        }
+      }
+    }
+  }
+  group.barrier();
+  return true;
+}
+
+TEST(GradientBucketerTest, AveragesAcrossRanks) {
+  const size_t world = 3;
+  std::string name = "/focus_test_bucketer_" + std::to_string(getpid());
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < world; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      bool ok = false;
+      try {
+        ok = run_training_rank(name, rank, world);
+      } catch (...) {
+      }
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  for (size_t i = 0; i < pids.size(); ++i) {
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        << "rank " << i;
+  }
+}
+
+TEST(GradientBucketerTest, RejectsMisuse) {
+  ProcessGroup group("/focus_test_bucketer_misuse_" + std::to_string(getpid()),
+                     getpid(), 0, 1);
+  std::vector<float> data(4);
+  size_t size[1] = {4};
+  FloatTensor x(data.data(), size, 1, true);
+  FloatTensor frozen(data.data(), size, 1);
+  FloatTensor other(data.data(), size, 1, true);
+
+  EXPECT_THROW(GradientBucketer(group, {&frozen}), std::invalid_argument);
+
+  GradientBucketer bucketer(group, {&x});
+  EXPECT_THROW(bucketer.wait(), std::logic_error);
+  EXPECT_THROW(bucketer.mark_ready(other), std::invalid_argument);
+  bucketer.mark_ready(x);
+  EXPECT_THROW(bucketer.mark_ready(x), std::invalid_argument);
+  bucketer.wait();
+}
+
+TEST(GradientBucketerTest, DestroyedMidStepDoesNotHang) {
+  std::string name = "/focus_test_bucketer_abort_" + std::to_string(getpid());
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < 2; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      alarm(20);
+      bool ok = false;
+      try {
+        ProcessGroup group(name, getppid(), rank, 2);
+        if (rank == 0) {
+          // Rank 1 never reduces, so the worker blocks in the all-reduce
+          // until the destructor aborts the group.
+          std::vector<float> data(4);
+          size_t size[1] = {4};
+          FloatTensor x(data.data(), size, 1, true);
+          {
+            GradientBucketer bucketer(group, {&x});
+            bucketer.mark_ready(x);
+          }
+          try {
+            group.barrier();
+          } catch (const std::runtime_error &) {
+            ok = true;
+          }
+        } else {
+          ok = true;
+        }
+      } catch (...) {
+      }
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  for (size_t i = 0; i < pids.size(); ++i) {
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0) << "rank " << i;
+  }
+}
+
+TEST(GradientBucketerTest, DestroyedAfterReductionKeepsGroup) {
+  std::string name = "/focus_test_bucketer_done_" + std::to_string(getpid());
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < 2; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      alarm(20);
+      bool ok = false;
+      try {
+        ProcessGroup group(name, getppid(), rank, 2);
+        std::vector<float> data(4);
+        size_t size[1] = {4};
+        FloatTensor x(data.data(), size, 1, true);
+        x.grad_[0] = static_cast<float>(rank);
+        {
+          // Every bucket finishes, but `wait` is never called.
+          GradientBucketer bucketer(group, {&x});
+          bucketer.mark_ready(x);
+          while (!bucketer.finished()) {
+            std::this_thread::yield();
+          }
+        }
+        // The group must still work on both ranks.
+        group.barrier();
+        ok = x.grad_[0] == 0.5f;
+      } catch (...) {
+      }
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  for (size_t i = 0; i < pids.size(); ++i) {
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0) << "rank " << i;
+  }
+}
+
+} // namespace focus
@@ -0,0 +1,238 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// process_group_test.cpp
+//
+// Identification: test/distributed/process_group_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "distributed/process_group.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace focus {
+
+/*
+ * Forks `world_size` ranks that each join one group and run `body`. A rank
+ * reports failure through its exit status. Returns true if every rank passed.
+ */
+bool run_ranks(const std::string &tag, size_t world_size,
+               std::function<bool(ProcessGroup &)> body,
+               size_t buffer_numel = 1 << 10) {
+  std::string name =
+      "/focus_test_pg_" + tag + "_" + std::to_string(getpid());
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < world_size; ++rank) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      bool ok = false;
+      try {
+        ProcessGroup group(name, getppid(), rank, world_size, buffer_numel);
+        ok = body(group);
+        group.barrier();
+      } catch (...) {
+      }
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  bool ok = true;
+  for (size_t i = 0; i < pids.size(); ++i) {
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+  return ok;
+}
+
+// Rank `r` contributes `r + 1 + i` at index `i`.
+std::vector<float> rank_values(size_t rank, size_t count) {
+  std::vector<float> out(count);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = static_cast<float>(rank + 1 + i % 97);
+  }
+  return out;
+}
+
+bool check_all_reduce(ProcessGroup &group, size_t count,
+                      AllReduceAlgorithm algorithm) {
+  size_t w = group.world_size();
+  std::vector<float> data = rank_values(group.rank(), count);
+  group.all_reduce(data.data(), count, algorithm);
+  for (size_t i = 0; i < count; ++i) {
+    float expected = static_cast<float>(w * (w + 1) / 2 + w * (i % 97));
+    if (data[i] != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(ProcessGroupTest, RingAllReduce) {
+  for (size_t world : {2, 3, 4}) {
+    EXPECT_TRUE(run_ranks("ring", world, [](ProcessGroup &group) {
+      return check_all_reduce(group, 1000, AllReduceAlgorithm::RING) &&
+             check_all_reduce(group, 5, AllReduceAlgorithm::RING);
+    })) << "world " << world;
+  }
+}
+
+TEST(ProcessGroupTest, TreeAllReduce) {
+  for (size_t world : {2, 3, 5}) {
+    EXPECT_TRUE(run_ranks("tree", world, [](ProcessGroup &group) {
+      return check_all_reduce(group, 1000, AllReduceAlgorithm::TREE) &&
+             check_all_reduce(group, 1, AllReduceAlgorithm::TREE);
+    })) << "world " << world;
+  }
+}
+
+TEST(ProcessGroupTest, AllReduceLargerThanBuffer) {
+  EXPECT_TRUE(run_ranks("large", 3, [](ProcessGroup &group) {
+    return check_all_reduce(group, 10000, AllReduceAlgorithm::RING) &&
+           check_all_reduce(group, 10000, AllReduceAlgorithm::TREE);
+  }));
+}
+
+TEST(ProcessGroupTest, AllReduceGrad) {
+  EXPECT_TRUE(run_ranks("grad", 2, [](ProcessGroup &group) {
+    std::vector<float> data(6);
+    size_t size[2] = {2, 3};
+    FloatTensor x(data.data(), size, 2, true);
+    for (size_t i = 0; i < x.numel_; ++i) {
+      x.grad_[i] = group.rank() + 1.0f;
+    }
+    group.all_reduce_grad(x);
+    for (size_t i = 0; i < x.numel_; ++i) {
+      if (x.grad_[i] != 3) {
+        return false;
+      }
+    }
+    return true;
+  }));
+}
+
+TEST(ProcessGroupTest, Broadcast) {
+  EXPECT_TRUE(run_ranks("bcast", 4, [](ProcessGroup &group) {
+    std::vector<float> data = rank_values(group.rank(), 3000);
+    group.broadcast(data.data(), data.size(), 2);
+    return data == rank_values(2, 3000);
+  }));
+}
+
+TEST(ProcessGroupTest, ReduceScatter) {
+  EXPECT_TRUE(run_ranks("rs", 3, [](ProcessGroup &group) {
+    const size_t count = 700;
+    size_t w = group.world_size();
+    std::vector<float> input = rank_values(group.rank(), w * count);
+    std::vector<float> output(count);
+    group.reduce_scatter(input.data(), output.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      size_t index = group.rank() * count + i;
+      float expected = static_cast<float>(w * (w + 1) / 2 + w * (index % 97));
+      if (output[i] != expected) {
+        return false;
+      }
+    }
+    return true;
+  }));
+}
+
+TEST(ProcessGroupTest, SingleRank) {
+  ProcessGroup group("/focus_test_pg_single_" + std::to_string(getpid()),
+                     getpid(), 0, 1);
+  std::vector<float> data = rank_values(0, 10);
+  group.all_reduce(data.data(), data.size());
+  EXPECT_EQ(data, rank_values(0, 10));
+}
+
+TEST(ProcessGroupTest, InvalidRank) {
+  EXPECT_THROW(ProcessGroup("/focus_test_pg_invalid", 1, 2, 2),
+               std::invalid_argument);
+}
+
+TEST(ProcessGroupTest, SkipsStaleSegment) {
+  // A leftover segment from an earlier run, larger than the new one so only
+  // the session stamp tells them apart.
+  std::string name = "/focus_test_pg_stale_" + std::to_string(getpid());
+  ProcessGroup stale(name, 1, 0, 1, 4096);
+
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < 2; ++i) {
+    // Rank 1 starts first and must wait for rank 0's fresh segment.
+    size_t rank = 1 - i;
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      alarm(20);
+      bool ok = false;
+      try {
+        ProcessGroup group(name, 2, rank, 2, 1024);
+        std::vector<float> data = rank_values(rank, 10);
+        group.all_reduce(data.data(), data.size());
+        ok = data[0] == 3.0f;
+        group.barrier();
+      } catch (...) {
+      }
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+    usleep(50000);
+  }
+  for (size_t i = 0; i < pids.size(); ++i) {
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0) << "child " << i;
+  }
+}
+
+TEST(ProcessGroupTest, AbortFailsBlockedCollectives) {
+  std::string name = "/focus_test_pg_abort_" + std::to_string(getpid());
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < 2; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      alarm(20);
+      bool ok = false;
+      try {
+        ProcessGroup group(name, getppid(), rank, 2);
+        if (rank == 0) {
+          // Rank 1 has gone away; the barrier must give up once aborted.
+          std::thread aborter([&group] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            group.abort();
+          });
+          try {
+            group.barrier();
+          } catch (const std::runtime_error &) {
+            ok = true;
+          }
+          aborter.join();
+        } else {
+          ok = true;
+        }
+      } catch (...) {
+      }
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  for (size_t i = 0; i < pids.size(); ++i) {
+    int status = 0;
+    waitpid(pids[i], &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0) << "rank " << i;
+  }
+}
+
+} // namespace focus
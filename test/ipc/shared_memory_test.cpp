@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// shared_memory_test.cpp
+//
+// Identification: test/ipc/shared_memory_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ipc/shared_memory.h"
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace focus {
+
+std::string unique_segment_name(const std::string &tag) {
+  return "/focus_test_" + tag + "_" + std::to_string(getpid());
+}
+
+TEST(SharedMemoryTest, SharedMemorySegmentCreateAndOpen) {
+  std::string name = unique_segment_name("segment");
+  SharedMemorySegment owner(name, 4096);
+  static_cast<char *>(owner.data())[100] = 42;
+
+  SharedMemorySegment other(name);
+  EXPECT_EQ(other.size(), 4096);
+  EXPECT_EQ(static_cast<char *>(other.data())[100], 42);
+  EXPECT_THROW(SharedMemorySegment(name, 4096), std::system_error);
+}
+
+TEST(SharedMemoryTest, SharedMemorySegmentUnlinkedByOwner) {
+  std::string name = unique_segment_name("unlink");
+  { SharedMemorySegment owner(name, 4096); }
+  EXPECT_THROW(SharedMemorySegment other(name), std::system_error);
+}
+
+TEST(SharedMemoryTest, SharedTensorArenaZeroCopy) {
+  std::string name = unique_segment_name("arena");
+  SharedTensorArena arena(name, 1 << 16);
+  size_t size[2] = {2, 3};
+  SharedTensorHandle handle = arena.allocate(size, 2);
+
+  SharedTensorArena attached(name);
+  auto x = FloatTensor(attached.data(handle), attached.size(handle),
+                       attached.ndim(handle));
+  EXPECT_EQ(x.numel_, 6);
+  for (size_t i = 0; i < x.numel_; ++i) {
+    EXPECT_EQ(x.data_[i], 0);
+  }
+
+  x.add_(2);
+  auto y = FloatTensor(arena.data(handle), arena.size(handle), 2);
+  EXPECT_EQ(y.sum_(), 12);
+}
+
+TEST(SharedMemoryTest, SharedTensorArenaAcrossProcesses) {
+  std::string name = unique_segment_name("fork");
+  SharedTensorArena arena(name, 1 << 16);
+  size_t size[1] = {4};
+  SharedTensorHandle handle = arena.allocate(size, 1);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // The child attaches by name and writes through the handle.
+    SharedTensorArena child(name);
+    auto x = FloatTensor(child.data(handle), child.size(handle), 1);
+    for (size_t i = 0; i < x.numel_; ++i) {
+      x.data_[i] = static_cast<float>(i + 1);
+    }
+    _exit(0);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  ASSERT_TRUE(WIFEXITED(status));
+  auto x = FloatTensor(arena.data(handle), arena.size(handle), 1);
+  EXPECT_EQ(x.sum_(), 10);
+}
+
+TEST(SharedMemoryTest, SharedTensorArenaExhausted) {
+  std::string name = unique_segment_name("full");
+  SharedTensorArena arena(name, 1024);
+  size_t size[1] = {1024};
+  EXPECT_THROW(arena.allocate(size, 1), std::bad_alloc);
+
+  // The failed request must not consume space a smaller one can still use.
+  size_t small[1] = {4};
+  SharedTensorHandle handle = arena.allocate(small, 1);
+  EXPECT_EQ(arena.size(handle)[0], 4u);
+  EXPECT_EQ(arena.data(handle)[3], 0.0f);
+
+  size_t huge[2] = {std::numeric_limits<size_t>::max() / 2, 4};
+  EXPECT_THROW(arena.allocate(huge, 2), std::bad_alloc);
+}
+
+} // namespace focus
@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// shared_tensor_ring_test.cpp
+//
+// Identification: test/ipc/shared_tensor_ring_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ipc/shared_tensor_ring.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace focus {
+
+std::string unique_ring_name(const std::string &tag) {
+  return "/focus_ring_" + tag + "_" + std::to_string(getpid());
+}
+
+TEST(SharedTensorRingTest, SharedTensorRingFullAndEmpty) {
+  SharedTensorRing ring(unique_ring_name("bounds"), 3, 16);
+  EXPECT_EQ(ring.num_slots(), 4);
+  EXPECT_EQ(ring.slot_numel(), 16);
+
+  SharedTensorSlot slot;
+  EXPECT_FALSE(ring.try_acquire_read(slot));
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.try_acquire_write(slot));
+    *slot.ndim_ = 1;
+    slot.size_[0] = 1;
+    slot.data_[0] = static_cast<float>(i);
+    ring.commit(slot);
+  }
+  EXPECT_FALSE(ring.try_acquire_write(slot));
+
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.try_acquire_read(slot));
+    auto x = FloatTensor(slot.data_, slot.size_, *slot.ndim_);
+    EXPECT_EQ(x.data_[0], static_cast<float>(i));
+    ring.release(slot);
+  }
+  EXPECT_FALSE(ring.try_acquire_read(slot));
+}
+
+TEST(SharedTensorRingTest, SharedTensorRingAcrossProcesses) {
+  std::string name = unique_ring_name("fork");
+  SharedTensorRing ring(name, 4, 6);
+  const size_t count = 200;
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // Producer process: write 2x3 tensors straight into the slots.
+    SharedTensorRing producer(name);
+    SharedTensorSlot slot;
+    for (size_t n = 0; n < count; ++n) {
+      while (!producer.try_acquire_write(slot)) {
+        std::this_thread::yield();
+      }
+      *slot.ndim_ = 2;
+      slot.size_[0] = 2;
+      slot.size_[1] = 3;
+      for (size_t i = 0; i < 6; ++i) {
+        slot.data_[i] = static_cast<float>(n);
+      }
+      producer.commit(slot);
+    }
+    _exit(0);
+  }
+
+  SharedTensorSlot slot;
+  for (size_t n = 0; n < count; ++n) {
+    while (!ring.try_acquire_read(slot)) {
+      std::this_thread::yield();
+    }
+    auto x = FloatTensor(slot.data_, slot.size_, *slot.ndim_);
+    EXPECT_EQ(x.numel_, 6);
+    EXPECT_EQ(x.sum_(), 6.0f * n);
+    ring.release(slot);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status));
+}
+
+} // namespace focus
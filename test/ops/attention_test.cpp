@@ -0,0 +1,161 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// attention_test.cpp
+//
+// Identification: test/ops/attention_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/attention.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+void fill_pattern(std::vector<float> &v, float seed) {
+  for (size_t i = 0; i < v.size(); ++i) {
+    v[i] = std::sin(seed + 0.37f * i);
+  }
+}
+
+/*
+ * Materializes the full score matrix per (batch, head) and applies a plain
+ * softmax, as the reference for the tiled kernel.
+ */
+std::vector<float> reference_attention(const std::vector<float> &q,
+                                       const std::vector<float> &k,
+                                       const std::vector<float> &v, size_t b,
+                                       size_t h, size_t lq, size_t lk,
+                                       size_t d, size_t dv,
+                                       const size_t *key_lengths,
+                                       bool causal) {
+  std::vector<float> out(b * h * lq * dv, 0);
+  float scale = 1.0f / std::sqrt(float(d));
+  for (size_t bh = 0; bh < b * h; ++bh) {
+    size_t valid = key_lengths ? key_lengths[bh / h] : lk;
+    for (size_t i = 0; i < lq; ++i) {
+      std::vector<float> scores;
+      std::vector<size_t> keys;
+      for (size_t j = 0; j < valid; ++j) {
+        if (causal && long(j) > long(i) + long(lk) - long(lq)) {
+          continue;
+        }
+        float s = 0;
+        for (size_t x = 0; x < d; ++x) {
+          s += q[(bh * lq + i) * d + x] * k[(bh * lk + j) * d + x];
+        }
+        scores.push_back(s * scale);
+        keys.push_back(j);
+      }
+      if (scores.empty()) {
+        continue;
+      }
+      float m = *std::max_element(scores.begin(), scores.end());
+      float total = 0;
+      for (size_t c = 0; c < scores.size(); ++c) {
+        scores[c] = std::exp(scores[c] - m);
+        total += scores[c];
+      }
+      for (size_t c = 0; c < scores.size(); ++c) {
+        for (size_t y = 0; y < dv; ++y) {
+          out[(bh * lq + i) * dv + y] +=
+              scores[c] / total * v[(bh * lk + keys[c]) * dv + y];
+        }
+      }
+    }
+  }
+  return out;
+}
+
+void check_attention(size_t b, size_t h, size_t lq, size_t lk, size_t d,
+                     size_t dv, const size_t *key_lengths, bool causal) {
+  std::vector<float> q(b * h * lq * d), k(b * h * lk * d), v(b * h * lk * dv);
+  std::vector<float> out(b * h * lq * dv, -1);
+  fill_pattern(q, 0.1f);
+  fill_pattern(k, 1.3f);
+  fill_pattern(v, 2.7f);
+  size_t q_size[4] = {b, h, lq, d};
+  size_t k_size[4] = {b, h, lk, d};
+  size_t v_size[4] = {b, h, lk, dv};
+  size_t out_size[4] = {b, h, lq, dv};
+  auto query = FloatTensor(q.data(), q_size, 4);
+  auto key = FloatTensor(k.data(), k_size, 4);
+  auto value = FloatTensor(v.data(), v_size, 4);
+  auto output = FloatTensor(out.data(), out_size, 4);
+
+  AttentionParams params;
+  params.causal_ = causal;
+  scaled_dot_product_attention(query, key, value, key_lengths, output,
+                               params);
+  std::vector<float> expected =
+      reference_attention(q, k, v, b, h, lq, lk, d, dv, key_lengths, causal);
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_NEAR(out[i], expected[i], 1e-4) << "index " << i;
+  }
+}
+
+TEST(AttentionTest, AttentionMatchesReference) {
+  check_attention(2, 3, 5, 7, 4, 6, nullptr, false);
+}
+
+TEST(AttentionTest, AttentionSpansSeveralTiles) {
+  check_attention(1, 2, 100, 150, 16, 8, nullptr, false);
+}
+
+TEST(AttentionTest, AttentionCausal) {
+  check_attention(2, 2, 70, 70, 8, 8, nullptr, true);
+  // Fewer queries than keys: the queries are the tail of the sequence.
+  check_attention(1, 1, 40, 130, 8, 4, nullptr, true);
+  // More queries than keys: the leading queries see nothing.
+  check_attention(1, 1, 50, 20, 8, 4, nullptr, true);
+}
+
+TEST(AttentionTest, AttentionKeyPadding) {
+  size_t key_lengths[3] = {90, 1, 0};
+  check_attention(3, 2, 33, 100, 8, 8, key_lengths, false);
+  check_attention(3, 2, 100, 100, 8, 8, key_lengths, true);
+}
+
+TEST(AttentionTest, AttentionLargeScores) {
+  // Scores far beyond the range of exp must not overflow the running sums.
+  std::vector<float> q(64 * 4, 30), k(64 * 4, 30), v(64 * 2);
+  std::vector<float> out(64 * 2);
+  fill_pattern(v, 0.5f);
+  size_t q_size[4] = {1, 1, 64, 4};
+  size_t v_size[4] = {1, 1, 64, 2};
+  auto query = FloatTensor(q.data(), q_size, 4);
+  auto key = FloatTensor(k.data(), q_size, 4);
+  auto value = FloatTensor(v.data(), v_size, 4);
+  auto output = FloatTensor(out.data(), v_size, 4);
+  scaled_dot_product_attention(query, key, value, nullptr, output);
+
+  float mean[2] = {0, 0};
+  for (size_t j = 0; j < 64; ++j) {
+    mean[0] += v[j * 2] / 64;
+    mean[1] += v[j * 2 + 1] / 64;
+  }
+  for (size_t i = 0; i < 64; ++i) {
+    EXPECT_NEAR(out[i * 2], mean[0], 1e-4);
+    EXPECT_NEAR(out[i * 2 + 1], mean[1], 1e-4);
+  }
+}
+
+TEST(AttentionTest, AttentionShapeMismatch) {
+  std::vector<float> buf(64);
+  size_t q_size[4] = {1, 1, 4, 4};
+  size_t k_size[4] = {1, 1, 4, 2};
+  auto query = FloatTensor(buf.data(), q_size, 4);
+  auto key = FloatTensor(buf.data(), k_size, 4);
+  auto output = FloatTensor(buf.data(), q_size, 4);
+  EXPECT_THROW(
+      scaled_dot_product_attention(query, key, query, nullptr, output),
+      std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// batched_gemm_test.cpp
+//
+// Identification: test/ops/batched_gemm_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/batched_gemm.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+void fill_pattern(std::vector<float> &v, float seed) {
+  for (size_t i = 0; i < v.size(); ++i) {
+    v[i] = std::sin(seed + 0.53f * i);
+  }
+}
+
+void check_batched_gemm(size_t batch, size_t m, size_t n, size_t k,
+                        size_t batch_a, size_t batch_b) {
+  std::vector<float> a(batch_a * m * k), b(batch_b * k * n);
+  std::vector<float> c(batch * m * n, -1);
+  fill_pattern(a, 0.2f);
+  fill_pattern(b, 1.9f);
+  size_t a_size[3] = {batch_a, m, k};
+  size_t b_size[3] = {batch_b, k, n};
+  size_t c_size[3] = {batch, m, n};
+  auto ta = FloatTensor(a.data(), a_size, 3);
+  auto tb = FloatTensor(b.data(), b_size, 3);
+  auto tc = FloatTensor(c.data(), c_size, 3);
+  batched_gemm(ta, tb, tc);
+
+  for (size_t x = 0; x < batch; ++x) {
+    const float *ma = a.data() + (batch_a == 1 ? 0 : x * m * k);
+    const float *mb = b.data() + (batch_b == 1 ? 0 : x * k * n);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        float expected = 0;
+        for (size_t p = 0; p < k; ++p) {
+          expected += ma[i * k + p] * mb[p * n + j];
+        }
+        ASSERT_NEAR(c[(x * m + i) * n + j], expected, 1e-4)
+            << m << "x" << n << "x" << k << " matrix " << x;
+      }
+    }
+  }
+}
+
+TEST(BatchedGemmTest, SpecializedShapes) {
+  // 203 leaves a partial group of matrices after the interleaved ones.
+  check_batched_gemm(203, 2, 2, 2, 203, 203);
+  check_batched_gemm(203, 3, 3, 3, 203, 203);
+  check_batched_gemm(203, 4, 4, 4, 203, 203);
+  check_batched_gemm(203, 8, 8, 8, 203, 203);
+  check_batched_gemm(203, 3, 1, 3, 203, 203);
+  check_batched_gemm(203, 4, 1, 4, 203, 203);
+  check_batched_gemm(37, 16, 16, 16, 37, 37);
+  check_batched_gemm(19, 32, 32, 32, 19, 19);
+}
+
+TEST(BatchedGemmTest, GenericShapes) {
+  check_batched_gemm(50, 5, 7, 3, 50, 50);
+  check_batched_gemm(9, 1, 12, 6, 9, 9);
+  check_batched_gemm(3, 0, 4, 4, 3, 3);
+}
+
+TEST(BatchedGemmTest, BroadcastBatch) {
+  // One shared transform applied to many points, and the reverse.
+  check_batched_gemm(100, 4, 1, 4, 1, 100);
+  check_batched_gemm(100, 4, 4, 4, 100, 1);
+  check_batched_gemm(30, 6, 5, 2, 1, 30);
+}
+
+TEST(BatchedGemmTest, BatchedGemmShapeMismatch) {
+  std::vector<float> buf(64);
+  size_t a_size[3] = {2, 2, 3};
+  size_t b_size[3] = {2, 2, 2};
+  size_t c_size[3] = {3, 2, 2};
+  auto a = FloatTensor(buf.data(), a_size, 3);
+  auto b = FloatTensor(buf.data(), b_size, 3);
+  auto c = FloatTensor(buf.data(), c_size, 3);
+  EXPECT_THROW(batched_gemm(a, b, c), std::invalid_argument);
+  EXPECT_THROW(batched_gemm(b, b, c), std::invalid_argument);
+}
+
+} // namespace focus
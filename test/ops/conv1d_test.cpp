@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// conv1d_test.cpp
+//
+// Identification: test/ops/conv1d_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/conv1d.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+TEST(Conv1dTest, StridedAndPadded) {
+  float a[6] = {1, 2, 3, 4, 5, 6};
+  float k[3] = {1, 0, -1};
+  float bias[1] = {10};
+  size_t in_size[3] = {1, 1, 6};
+  size_t w_size[3] = {1, 1, 3};
+  size_t b_size[1] = {1};
+  size_t out_size[3] = {1, 1, 3};
+  auto x = FloatTensor(a, in_size, 3);
+  auto w = FloatTensor(k, w_size, 3);
+  auto b = FloatTensor(bias, b_size, 1);
+  float out[3];
+  auto y = FloatTensor(out, out_size, 3);
+
+  // Padded input is 0 1 2 3 4 5 6 0; taps start at 0, 2 and 4.
+  Conv1dParams params;
+  params.stride_ = 2;
+  params.pad_ = 1;
+  conv1d(x, w, &b, y, params);
+  float expected[3] = {10 - 2, 10 + 2 - 4, 10 + 4 - 6};
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(out[i], expected[i]);
+  }
+}
+
+TEST(Conv1dTest, LongKernelMatchesDirectSum) {
+  // Long enough kernels are eligible for the FFT path; the result must not
+  // depend on which path the tuner picks.
+  size_t c_in = 2, c_out = 3, l = 600, kn = 64;
+  size_t ol = l - kn + 1;
+  std::vector<float> a(c_in * l), k(c_out * c_in * kn), out(c_out * ol);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>((i * 5) % 11) - 5;
+  }
+  for (size_t i = 0; i < k.size(); ++i) {
+    k[i] = 0.125f * static_cast<float>((i * 3) % 7) - 0.375f;
+  }
+  size_t in_size[3] = {1, c_in, l};
+  size_t w_size[3] = {c_out, c_in, kn};
+  size_t out_size[3] = {1, c_out, ol};
+  auto x = FloatTensor(a.data(), in_size, 3);
+  auto w = FloatTensor(k.data(), w_size, 3);
+  auto y = FloatTensor(out.data(), out_size, 3);
+  conv1d(x, w, nullptr, y);
+
+  for (size_t oc = 0; oc < c_out; ++oc) {
+    for (size_t t = 0; t < ol; ++t) {
+      float acc = 0;
+      for (size_t ic = 0; ic < c_in; ++ic) {
+        for (size_t j = 0; j < kn; ++j) {
+          acc += a[ic * l + t + j] * k[(oc * c_in + ic) * kn + j];
+        }
+      }
+      EXPECT_NEAR(out[oc * ol + t], acc, 1e-3);
+    }
+  }
+}
+
+TEST(Conv1dTest, ShapeMismatch) {
+  float a[8] = {0};
+  size_t in_size[3] = {1, 2, 4};
+  size_t w_size[3] = {1, 1, 2};
+  size_t out_size[3] = {1, 1, 3};
+  auto x = FloatTensor(a, in_size, 3);
+  auto w = FloatTensor(a, w_size, 3);
+  float out[3];
+  auto y = FloatTensor(out, out_size, 3);
+  EXPECT_THROW(conv1d(x, w, nullptr, y), std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,345 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// conv2d_test.cpp
+//
+// Identification: test/ops/conv2d_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/conv2d.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+void fill_sequence(std::vector<float> &values, float scale) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = scale * static_cast<float>((i * 7) % 13) - 3;
+  }
+}
+
+// Straightforward seven-loop convolution used as the reference.
+void reference_conv2d(const std::vector<float> &in, const std::vector<float> &w,
+                      const std::vector<float> &bias, std::vector<float> &out,
+                      size_t n, size_t c_in, size_t h, size_t wd,
+                      size_t c_out, size_t k, const Conv2dParams &p) {
+  size_t oh_n = conv2d_output_size(h, k, p.stride_h_, p.pad_h_);
+  size_t ow_n = conv2d_output_size(wd, k, p.stride_w_, p.pad_w_);
+  size_t cig = c_in / p.groups_;
+  size_t cog = c_out / p.groups_;
+  out.assign(n * c_out * oh_n * ow_n, 0);
+  for (size_t b = 0; b < n; ++b) {
+    for (size_t oc = 0; oc < c_out; ++oc) {
+      size_t g = oc / cog;
+      for (size_t oh = 0; oh < oh_n; ++oh) {
+        for (size_t ow = 0; ow < ow_n; ++ow) {
+          float acc = bias[oc];
+          for (size_t ic = 0; ic < cig; ++ic) {
+            for (size_t kh = 0; kh < k; ++kh) {
+              for (size_t kw = 0; kw < k; ++kw) {
+                long ih = long(oh * p.stride_h_ + kh) - long(p.pad_h_);
+                long iw = long(ow * p.stride_w_ + kw) - long(p.pad_w_);
+                if (ih < 0 || iw < 0 || ih >= long(h) || iw >= long(wd)) {
+                  continue;
+                }
+                acc += in[((b * c_in + g * cig + ic) * h + ih) * wd + iw] *
+                       w[((oc * cig + ic) * k + kh) * k + kw];
+              }
+            }
+          }
+          out[((b * c_out + oc) * oh_n + oh) * ow_n + ow] = acc;
+        }
+      }
+    }
+  }
+}
+
+void check_against_reference(size_t n, size_t c_in, size_t h, size_t wd,
+                             size_t c_out, size_t k, const Conv2dParams &p) {
+  std::vector<float> in(n * c_in * h * wd);
+  std::vector<float> w(c_out * (c_in / p.groups_) * k * k);
+  std::vector<float> bias(c_out);
+  fill_sequence(in, 0.5f);
+  fill_sequence(w, 0.25f);
+  fill_sequence(bias, 1.0f);
+
+  size_t oh = conv2d_output_size(h, k, p.stride_h_, p.pad_h_);
+  size_t ow = conv2d_output_size(wd, k, p.stride_w_, p.pad_w_);
+  std::vector<float> out(n * c_out * oh * ow);
+  std::vector<float> expected;
+  reference_conv2d(in, w, bias, expected, n, c_in, h, wd, c_out, k, p);
+
+  size_t in_size[4] = {n, c_in, h, wd};
+  size_t w_size[4] = {c_out, c_in / p.groups_, k, k};
+  size_t b_size[1] = {c_out};
+  size_t out_size[4] = {n, c_out, oh, ow};
+  auto x = FloatTensor(in.data(), in_size, 4);
+  auto weight = FloatTensor(w.data(), w_size, 4);
+  auto b = FloatTensor(bias.data(), b_size, 1);
+  auto y = FloatTensor(out.data(), out_size, 4);
+  conv2d(x, weight, &b, y, p);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_NEAR(y.data_[i], expected[i], 1e-4);
+  }
+}
+
+TEST(Conv2dTest, Conv2dSingleChannel) {
+  // clang-format off
+  float in[1][1][3][3] = {
+    {
+      {
+        {1, 2, 3},
+        {4, 5, 6},
+        {7, 8, 9}
+      }
+    }
+  };
+  float w[1][1][2][2] = {
+    {
+      {
+        {1, 0},
+        {0, 1}
+      }
+    }
+  };
+  // clang-format on
+  float out[1][1][2][2] = {};
+  float expected_values[4] = {6, 8, 12, 14};
+  size_t in_size[4] = {1, 1, 3, 3};
+  size_t w_size[4] = {1, 1, 2, 2};
+  size_t out_size[4] = {1, 1, 2, 2};
+  auto x = FloatTensor(&in[0][0][0][0], in_size, 4);
+  auto weight = FloatTensor(&w[0][0][0][0], w_size, 4);
+  auto y = FloatTensor(&out[0][0][0][0], out_size, 4);
+  conv2d(x, weight, nullptr, y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], expected_values[i]);
+  }
+}
+
+TEST(Conv2dTest, Conv2dDepthwise) {
+  size_t kernels[2] = {3, 5};
+  size_t strides[2] = {1, 2};
+  for (size_t ki = 0; ki < 2; ++ki) {
+    for (size_t si = 0; si < 2; ++si) {
+      Conv2dParams p;
+      p.stride_h_ = p.stride_w_ = strides[si];
+      p.pad_h_ = p.pad_w_ = kernels[ki] / 2;
+      p.groups_ = 6;
+      check_against_reference(2, 6, 11, 13, 6, kernels[ki], p);
+    }
+  }
+
+  {
+    // Unpadded with odd extents exercises the clipped row ranges.
+    Conv2dParams p;
+    p.stride_h_ = p.stride_w_ = 2;
+    p.groups_ = 4;
+    check_against_reference(1, 4, 9, 10, 4, 3, p);
+  }
+
+  {
+    // Kernel sizes without a specialization take the generic path.
+    Conv2dParams p;
+    p.pad_h_ = p.pad_w_ = 3;
+    p.groups_ = 3;
+    check_against_reference(1, 3, 8, 8, 3, 7, p);
+  }
+}
+
+TEST(Conv2dTest, Conv2dGrouped) {
+  {
+    Conv2dParams p;
+    p.pad_h_ = p.pad_w_ = 1;
+    p.groups_ = 2;
+    check_against_reference(2, 4, 7, 6, 6, 3, p);
+  }
+
+  {
+    Conv2dParams p;
+    p.stride_h_ = 2;
+    p.stride_w_ = 1;
+    p.pad_h_ = 0;
+    p.pad_w_ = 2;
+    p.groups_ = 1;
+    check_against_reference(1, 3, 9, 9, 2, 5, p);
+  }
+
+  {
+    // Depthwise with a channel multiplier of two.
+    Conv2dParams p;
+    p.pad_h_ = p.pad_w_ = 1;
+    p.groups_ = 3;
+    check_against_reference(1, 3, 6, 6, 6, 3, p);
+  }
+}
+
+// Reference gradients of `reference_conv2d` with respect to input, weight and
+// bias, given the output gradient `gout`.
+void reference_conv2d_backward(const std::vector<float> &in,
+                               const std::vector<float> &w,
+                               const std::vector<float> &gout,
+                               std::vector<float> &gin, std::vector<float> &gw,
+                               std::vector<float> &gb, size_t n, size_t c_in,
+                               size_t h, size_t wd, size_t c_out, size_t k,
+                               const Conv2dParams &p) {
+  size_t oh_n = conv2d_output_size(h, k, p.stride_h_, p.pad_h_);
+  size_t ow_n = conv2d_output_size(wd, k, p.stride_w_, p.pad_w_);
+  size_t cig = c_in / p.groups_;
+  size_t cog = c_out / p.groups_;
+  gin.assign(in.size(), 0);
+  gw.assign(w.size(), 0);
+  gb.assign(c_out, 0);
+  for (size_t b = 0; b < n; ++b) {
+    for (size_t oc = 0; oc < c_out; ++oc) {
+      size_t g = oc / cog;
+      for (size_t oh = 0; oh < oh_n; ++oh) {
+        for (size_t ow = 0; ow < ow_n; ++ow) {
+          float go = gout[((b * c_out + oc) * oh_n + oh) * ow_n + ow];
+          gb[oc] += go;
+          for (size_t ic = 0; ic < cig; ++ic) {
+            for (size_t kh = 0; kh < k; ++kh) {
+              for (size_t kw = 0; kw < k; ++kw) {
+                long ih = long(oh * p.stride_h_ + kh) - long(p.pad_h_);
+                long iw = long(ow * p.stride_w_ + kw) - long(p.pad_w_);
+                if (ih < 0 || iw < 0 || ih >= long(h) || iw >= long(wd)) {
+                  continue;
+                }
+                size_t ii = ((b * c_in + g * cig + ic) * h + ih) * wd + iw;
+                size_t wi = ((oc * cig + ic) * k + kh) * k + kw;
+                gin[ii] += go * w[wi];
+                gw[wi] += go * in[ii];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void check_backward_against_reference(size_t n, size_t c_in, size_t h,
+                                      size_t wd, size_t c_out, size_t k,
+                                      const Conv2dParams &p) {
+  size_t oh = conv2d_output_size(h, k, p.stride_h_, p.pad_h_);
+  size_t ow = conv2d_output_size(wd, k, p.stride_w_, p.pad_w_);
+  std::vector<float> in(n * c_in * h * wd);
+  std::vector<float> w(c_out * (c_in / p.groups_) * k * k);
+  std::vector<float> bias(c_out);
+  std::vector<float> out(n * c_out * oh * ow);
+  fill_sequence(in, 0.5f);
+  fill_sequence(w, 0.25f);
+
+  size_t in_size[4] = {n, c_in, h, wd};
+  size_t w_size[4] = {c_out, c_in / p.groups_, k, k};
+  size_t b_size[1] = {c_out};
+  size_t out_size[4] = {n, c_out, oh, ow};
+  auto x = FloatTensor(in.data(), in_size, 4, true);
+  auto weight = FloatTensor(w.data(), w_size, 4, true);
+  auto b = FloatTensor(bias.data(), b_size, 1, true);
+  auto y = FloatTensor(out.data(), out_size, 4, true);
+  std::vector<float> gout(y.numel_);
+  fill_sequence(gout, 0.125f);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    y.grad_[i] = gout[i];
+  }
+
+  std::vector<float> gin;
+  std::vector<float> gw;
+  std::vector<float> gb;
+  reference_conv2d_backward(in, w, gout, gin, gw, gb, n, c_in, h, wd, c_out, k,
+                            p);
+  conv2d_backward_data(y, weight, x, p);
+  conv2d_backward_weight(x, y, weight, &b, p);
+  for (size_t i = 0; i < x.numel_; ++i) {
+    EXPECT_NEAR(x.grad_[i], gin[i], 1e-3);
+  }
+  for (size_t i = 0; i < weight.numel_; ++i) {
+    EXPECT_NEAR(weight.grad_[i], gw[i], 1e-3);
+  }
+  for (size_t i = 0; i < b.numel_; ++i) {
+    EXPECT_NEAR(b.grad_[i], gb[i], 1e-3);
+  }
+
+  // Gradients accumulate across calls.
+  conv2d_backward_weight(x, y, weight, &b, p);
+  for (size_t i = 0; i < b.numel_; ++i) {
+    EXPECT_NEAR(b.grad_[i], 2 * gb[i], 1e-3);
+  }
+}
+
+TEST(Conv2dTest, Conv2dBackward) {
+  {
+    Conv2dParams p;
+    p.pad_h_ = p.pad_w_ = 1;
+    check_backward_against_reference(5, 3, 7, 6, 4, 3, p);
+  }
+
+  {
+    Conv2dParams p;
+    p.stride_h_ = p.stride_w_ = 2;
+    p.pad_h_ = p.pad_w_ = 2;
+    p.groups_ = 4;
+    check_backward_against_reference(3, 4, 9, 11, 4, 5, p);
+  }
+
+  {
+    Conv2dParams p;
+    p.stride_h_ = 1;
+    p.stride_w_ = 3;
+    p.groups_ = 2;
+    check_backward_against_reference(4, 4, 6, 10, 6, 2, p);
+  }
+}
+
+TEST(Conv2dTest, Conv2dTranspose) {
+  float in[1][1][2][2] = {{{{1, 2}, {3, 4}}}};
+  float w[1][1][2][2] = {{{{1, 1}, {1, 1}}}};
+  float bias[1] = {1};
+  float out[1][1][4][4] = {};
+  // clang-format off
+  float expected_values[16] = {
+    2, 2, 3, 3,
+    2, 2, 3, 3,
+    4, 4, 5, 5,
+    4, 4, 5, 5
+  };
+  // clang-format on
+  size_t in_size[4] = {1, 1, 2, 2};
+  size_t w_size[4] = {1, 1, 2, 2};
+  size_t b_size[1] = {1};
+  size_t out_size[4] = {1, 1, 4, 4};
+  auto x = FloatTensor(&in[0][0][0][0], in_size, 4);
+  auto weight = FloatTensor(&w[0][0][0][0], w_size, 4);
+  auto b = FloatTensor(bias, b_size, 1);
+  auto y = FloatTensor(&out[0][0][0][0], out_size, 4);
+  Conv2dParams p;
+  p.stride_h_ = p.stride_w_ = 2;
+  conv_transpose2d(x, weight, &b, y, p);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], expected_values[i]);
+  }
+}
+
+TEST(Conv2dTest, Conv2dShapeMismatch) {
+  std::vector<float> in(1 * 4 * 5 * 5);
+  std::vector<float> w(4 * 1 * 3 * 3);
+  std::vector<float> out(1 * 4 * 2 * 2);
+  size_t in_size[4] = {1, 4, 5, 5};
+  size_t w_size[4] = {4, 1, 3, 3};
+  size_t out_size[4] = {1, 4, 2, 2};
+  auto x = FloatTensor(in.data(), in_size, 4);
+  auto weight = FloatTensor(w.data(), w_size, 4);
+  auto y = FloatTensor(out.data(), out_size, 4);
+  Conv2dParams p;
+  p.groups_ = 4;
+  EXPECT_THROW(conv2d(x, weight, nullptr, y, p), std::invalid_argument);
+  p.groups_ = 3;
+  EXPECT_THROW(conv2d(x, weight, nullptr, y, p), std::invalid_argument);
+}
+
+} // namespace focus
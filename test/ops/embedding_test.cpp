@@ -0,0 +1,165 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// embedding_test.cpp
+//
+// Identification: test/ops/embedding_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/embedding.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+// clang-format off
+float E[4][3] = {
+  {1,  2,  3},
+  {4,  5,  6},
+  {7,  8,  9},
+  {10, 11, 12}
+};
+// clang-format on
+
+TEST(EmbeddingTest, EmbeddingIndexSelect) {
+  size_t table_size[2] = {4, 3};
+  auto table = FloatTensor(&E[0][0], table_size, 2);
+  size_t indices[3] = {2, 0, 2};
+  float out[3][3] = {};
+  float expected_values[9] = {7, 8, 9, 1, 2, 3, 7, 8, 9};
+  size_t out_size[2] = {3, 3};
+  auto y = FloatTensor(&out[0][0], out_size, 2);
+  index_select(table, indices, 3, y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], expected_values[i]);
+  }
+
+  size_t bad[3] = {0, 4, 1};
+  EXPECT_THROW(index_select(table, bad, 3, y), std::out_of_range);
+}
+
+TEST(EmbeddingTest, EmbeddingIndexAdd) {
+  float t[4][2] = {};
+  size_t table_size[2] = {4, 2};
+  auto table = FloatTensor(&t[0][0], table_size, 2);
+
+  // Many duplicates so several segments need more than one row.
+  size_t num_indices = 40;
+  std::vector<size_t> indices(num_indices);
+  std::vector<float> src(num_indices * 2);
+  std::vector<float> expected(8, 0);
+  for (size_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 3) % 4;
+    src[2 * i] = static_cast<float>(i);
+    src[2 * i + 1] = 1;
+    expected[indices[i] * 2] += src[2 * i];
+    expected[indices[i] * 2 + 1] += 1;
+  }
+  size_t src_size[2] = {num_indices, 2};
+  auto s = FloatTensor(src.data(), src_size, 2);
+  index_add_(table, indices.data(), num_indices, s);
+  for (size_t i = 0; i < table.numel_; ++i) {
+    EXPECT_EQ(table.data_[i], expected[i]);
+  }
+}
+
+TEST(EmbeddingTest, EmbeddingGather) {
+  float in[2][3] = {{1, 2, 3}, {4, 5, 6}};
+  size_t index[2][2] = {{2, 0}, {1, 1}};
+  float out[2][2] = {};
+  float expected_values[4] = {3, 1, 5, 5};
+  size_t in_size[2] = {2, 3};
+  size_t out_size[2] = {2, 2};
+  auto x = FloatTensor(&in[0][0], in_size, 2);
+  auto y = FloatTensor(&out[0][0], out_size, 2);
+  gather(x, &index[0][0], y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], expected_values[i]);
+  }
+}
+
+TEST(EmbeddingTest, EmbeddingScatterAdd) {
+  float out[2][3] = {};
+  size_t index[2][3] = {{0, 2, 0}, {1, 1, 2}};
+  float src[2][3] = {{1, 2, 3}, {4, 5, 6}};
+  float expected_values[6] = {4, 0, 2, 0, 9, 6};
+  size_t size[2] = {2, 3};
+  auto y = FloatTensor(&out[0][0], size, 2);
+  auto s = FloatTensor(&src[0][0], size, 2);
+  scatter_add_(y, &index[0][0], s);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], expected_values[i]);
+  }
+}
+
+TEST(EmbeddingTest, EmbeddingBag) {
+  size_t table_size[2] = {4, 3};
+  auto table = FloatTensor(&E[0][0], table_size, 2);
+  size_t indices[6] = {0, 1, 3, 2, 2, 0};
+  size_t offsets[3] = {0, 2, 3};
+  float out[3][3] = {};
+  size_t out_size[2] = {3, 3};
+  auto y = FloatTensor(&out[0][0], out_size, 2);
+
+  float expected_sum[9] = {5, 7, 9, 10, 11, 12, 15, 18, 21};
+  embedding_bag(table, indices, 6, offsets, 3, EmbeddingBagMode::SUM, y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], expected_sum[i]);
+  }
+
+  float expected_mean[9] = {2.5f, 3.5f, 4.5f, 10, 11, 12, 5, 6, 7};
+  embedding_bag(table, indices, 6, offsets, 3, EmbeddingBagMode::MEAN, y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_FLOAT_EQ(y.data_[i], expected_mean[i]);
+  }
+}
+
+TEST(EmbeddingTest, EmbeddingBagBackward) {
+  size_t table_size[2] = {4, 3};
+  auto table = FloatTensor(&E[0][0], table_size, 2, true);
+  size_t indices[6] = {0, 1, 3, 2, 2, 0};
+  size_t offsets[3] = {0, 2, 3};
+  float out[3][3] = {};
+  size_t out_size[2] = {3, 3};
+  auto y = FloatTensor(&out[0][0], out_size, 2, true);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    y.grad_[i] = static_cast<float>(i / 3 + 1);
+  }
+
+  // Row 0 is in bags 0 and 2, row 2 twice in bag 2.
+  float expected_values[12] = {0.5f + 1, 0.5f + 1, 0.5f + 1, 0.5f, 0.5f, 0.5f,
+                               2,        2,        2,        2,    2,    2};
+  embedding_bag_backward(y, indices, 6, offsets, 3, EmbeddingBagMode::MEAN,
+                         table);
+  for (size_t i = 0; i < table.numel_; ++i) {
+    EXPECT_FLOAT_EQ(table.grad_[i], expected_values[i]);
+  }
+}
+
+TEST(EmbeddingTest, EmbeddingRejectsMissingBagsAndRows) {
+  size_t table_size[2] = {4, 3};
+  auto table = FloatTensor(&E[0][0], table_size, 2, true);
+  size_t indices[2] = {0, 1};
+  size_t offsets[1] = {0};
+  float out[1] = {};
+  size_t out_size[2] = {0, 3};
+  auto y = FloatTensor(out, out_size, 2, true);
+  EXPECT_THROW(embedding_bag(table, indices, 2, offsets, 0,
+                             EmbeddingBagMode::SUM, y),
+               std::invalid_argument);
+  EXPECT_THROW(embedding_bag_backward(y, indices, 2, offsets, 0,
+                                      EmbeddingBagMode::SUM, table),
+               std::invalid_argument);
+
+  // A 0-D tensor has no rows to select.
+  float scalar[1] = {1};
+  auto flat = FloatTensor(scalar, table_size, 0);
+  auto z = FloatTensor(out, out_size, 2);
+  EXPECT_THROW(index_select(flat, indices, 0, z), std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// fft_conv_test.cpp
+//
+// Identification: test/ops/fft_conv_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/fft_conv.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+void fill_signal(std::vector<float> &values, float freq) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = std::sin(freq * i) + 0.25f * static_cast<float>(i % 7) - 0.5f;
+  }
+}
+
+// Direct 2-D correlation at stride 1 used as the reference; 1-D problems use
+// `h = kh = 1`.
+std::vector<float> reference_correlate(const std::vector<float> &in,
+                                       const std::vector<float> &w,
+                                       const std::vector<float> &bias, size_t n,
+                                       size_t c_in, size_t h, size_t wd,
+                                       size_t c_out, size_t kh, size_t kw,
+                                       size_t ph, size_t pw) {
+  size_t oh_n = h + 2 * ph - kh + 1;
+  size_t ow_n = wd + 2 * pw - kw + 1;
+  std::vector<float> out(n * c_out * oh_n * ow_n);
+  for (size_t b = 0; b < n; ++b) {
+    for (size_t oc = 0; oc < c_out; ++oc) {
+      for (size_t oh = 0; oh < oh_n; ++oh) {
+        for (size_t ow = 0; ow < ow_n; ++ow) {
+          double acc = bias[oc];
+          for (size_t ic = 0; ic < c_in; ++ic) {
+            for (size_t i = 0; i < kh; ++i) {
+              for (size_t j = 0; j < kw; ++j) {
+                long y = static_cast<long>(oh + i) - static_cast<long>(ph);
+                long x = static_cast<long>(ow + j) - static_cast<long>(pw);
+                if (y < 0 || x < 0 || y >= static_cast<long>(h) ||
+                    x >= static_cast<long>(wd)) {
+                  continue;
+                }
+                acc += in[((b * c_in + ic) * h + y) * wd + x] *
+                       w[((oc * c_in + ic) * kh + i) * kw + j];
+              }
+            }
+          }
+          out[((b * c_out + oc) * oh_n + oh) * ow_n + ow] =
+              static_cast<float>(acc);
+        }
+      }
+    }
+  }
+  return out;
+}
+
+TEST(FftConvTest, Conv1dLongSignalSpansTiles) {
+  // 5000 outputs need several overlap-save tiles.
+  size_t n = 2, c_in = 3, c_out = 2, l = 5000, k = 65, pad = 10;
+  size_t ol = l + 2 * pad - k + 1;
+  std::vector<float> in(n * c_in * l), w(c_out * c_in * k), bias = {0.5f, -1};
+  fill_signal(in, 0.013f);
+  fill_signal(w, 0.7f);
+  std::vector<float> out(n * c_out * ol);
+
+  size_t in_size[3] = {n, c_in, l};
+  size_t w_size[3] = {c_out, c_in, k};
+  size_t b_size[1] = {c_out};
+  size_t out_size[3] = {n, c_out, ol};
+  auto x = FloatTensor(in.data(), in_size, 3);
+  auto weight = FloatTensor(w.data(), w_size, 3);
+  auto b = FloatTensor(bias.data(), b_size, 1);
+  auto y = FloatTensor(out.data(), out_size, 3);
+  Conv1dParams params;
+  params.pad_ = pad;
+  fft_conv1d(x, weight, &b, y, params);
+
+  std::vector<float> expected = reference_correlate(
+      in, w, bias, n, c_in, 1, l, c_out, 1, k, 0, pad);
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_NEAR(out[i], expected[i], 2e-3) << "i=" << i;
+  }
+}
+
+TEST(FftConvTest, Conv2dMatchesDirect) {
+  // Odd, non-square extents exercise partial edge tiles in both dimensions.
+  size_t n = 2, c_in = 3, c_out = 4, h = 45, wd = 70, kh = 9, kw = 7;
+  size_t ph = 4, pw = 2;
+  size_t oh = h + 2 * ph - kh + 1;
+  size_t ow = wd + 2 * pw - kw + 1;
+  std::vector<float> in(n * c_in * h * wd), w(c_out * c_in * kh * kw);
+  std::vector<float> bias = {0, 1, -2, 0.25f};
+  fill_signal(in, 0.11f);
+  fill_signal(w, 0.9f);
+  std::vector<float> out(n * c_out * oh * ow);
+
+  size_t in_size[4] = {n, c_in, h, wd};
+  size_t w_size[4] = {c_out, c_in, kh, kw};
+  size_t b_size[1] = {c_out};
+  size_t out_size[4] = {n, c_out, oh, ow};
+  auto x = FloatTensor(in.data(), in_size, 4);
+  auto weight = FloatTensor(w.data(), w_size, 4);
+  auto b = FloatTensor(bias.data(), b_size, 1);
+  auto y = FloatTensor(out.data(), out_size, 4);
+  Conv2dParams params;
+  params.pad_h_ = ph;
+  params.pad_w_ = pw;
+  fft_conv2d(x, weight, &b, y, params);
+
+  std::vector<float> expected = reference_correlate(
+      in, w, bias, n, c_in, h, wd, c_out, kh, kw, ph, pw);
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_NEAR(out[i], expected[i], 2e-3) << "i=" << i;
+  }
+
+  // The dispatching entry point agrees whichever path it picks.
+  std::vector<float> dispatched(out.size());
+  auto z = FloatTensor(dispatched.data(), out_size, 4);
+  conv2d(x, weight, &b, z, params);
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_NEAR(dispatched[i], expected[i], 2e-3) << "i=" << i;
+  }
+}
+
+TEST(FftConvTest, RejectsUnsupportedParams) {
+  float a[16] = {0};
+  size_t in_size[4] = {1, 2, 2, 4};
+  size_t w_size[4] = {2, 1, 1, 1};
+  size_t out_size[4] = {1, 2, 2, 4};
+  auto x = FloatTensor(a, in_size, 4);
+  auto weight = FloatTensor(a, w_size, 4);
+  float out[16];
+  auto y = FloatTensor(out, out_size, 4);
+  Conv2dParams params;
+  params.groups_ = 2;
+  EXPECT_THROW(fft_conv2d(x, weight, nullptr, y, params),
+               std::invalid_argument);
+
+  size_t in1[3] = {1, 1, 8};
+  size_t w1[3] = {1, 1, 2};
+  size_t out1[3] = {1, 1, 4};
+  auto x1 = FloatTensor(a, in1, 3);
+  auto weight1 = FloatTensor(a, w1, 3);
+  auto y1 = FloatTensor(out, out1, 3);
+  Conv1dParams strided;
+  strided.stride_ = 2;
+  EXPECT_THROW(fft_conv1d(x1, weight1, nullptr, y1, strided),
+               std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// fft_test.cpp
+//
+// Identification: test/ops/fft_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/fft.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+// O(n^2) transform in double precision used as the reference.
+std::vector<std::complex<double>> reference_dft(const std::vector<Complex> &x) {
+  const double pi = 3.14159265358979323846;
+  size_t n = x.size();
+  std::vector<std::complex<double>> out(n);
+  for (size_t k = 0; k < n; ++k) {
+    std::complex<double> acc = 0;
+    for (size_t j = 0; j < n; ++j) {
+      double phase = -2 * pi * static_cast<double>(j * k % n) / n;
+      acc += std::complex<double>(x[j]) *
+             std::complex<double>(std::cos(phase), std::sin(phase));
+    }
+    out[k] = acc;
+  }
+  return out;
+}
+
+std::vector<Complex> test_signal(size_t n) {
+  std::vector<Complex> x(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = Complex(std::sin(0.37f * i) + 0.1f * (i % 5),
+                   std::cos(1.3f * i) - 0.2f * (i % 3));
+  }
+  return x;
+}
+
+TEST(FftTest, MatchesReferenceForMixedRadixLengths) {
+  // Powers of two and four, 3- and 5-smooth lengths, and prime factors that
+  // take the generic pass.
+  size_t lengths[] = {1, 2, 3, 4, 5, 6, 8, 12, 16, 30, 45, 64, 77, 97, 120,
+                      256, 360, 1024};
+  for (size_t n : lengths) {
+    std::vector<Complex> x = test_signal(n);
+    std::vector<Complex> y(n);
+    FftPlan plan(n);
+    plan.forward(x.data(), y.data());
+    std::vector<std::complex<double>> expected = reference_dft(x);
+    for (size_t k = 0; k < n; ++k) {
+      EXPECT_NEAR(y[k].real(), expected[k].real(), 1e-3 * std::sqrt(n))
+          << "n=" << n << " k=" << k;
+      EXPECT_NEAR(y[k].imag(), expected[k].imag(), 1e-3 * std::sqrt(n))
+          << "n=" << n << " k=" << k;
+    }
+
+    std::vector<Complex> back(n);
+    plan.inverse(y.data(), back.data());
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(back[i].real(), x[i].real(), 1e-4);
+      EXPECT_NEAR(back[i].imag(), x[i].imag(), 1e-4);
+    }
+  }
+}
+
+TEST(FftTest, RealTransformMatchesComplexTransform) {
+  size_t lengths[] = {2, 6, 10, 16, 48, 154, 1000};
+  for (size_t n : lengths) {
+    std::vector<float> x(n);
+    std::vector<Complex> xc(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = std::sin(0.21f * i * i) + 0.5f;
+      xc[i] = x[i];
+    }
+    std::vector<Complex> y(n / 2 + 1);
+    RealFftPlan plan(n);
+    plan.forward(x.data(), y.data());
+    std::vector<std::complex<double>> expected = reference_dft(xc);
+    for (size_t k = 0; k <= n / 2; ++k) {
+      EXPECT_NEAR(y[k].real(), expected[k].real(), 1e-3 * std::sqrt(n));
+      EXPECT_NEAR(y[k].imag(), expected[k].imag(), 1e-3 * std::sqrt(n));
+    }
+
+    std::vector<float> back(n);
+    plan.inverse(y.data(), back.data());
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(back[i], x[i], 1e-4);
+    }
+  }
+}
+
+TEST(FftTest, CachedPlansAreShared) {
+  std::shared_ptr<const FftPlan> a = FftPlan::cached(96);
+  std::shared_ptr<const FftPlan> b = FftPlan::cached(96);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_EQ(a->size(), 96u);
+  EXPECT_EQ(RealFftPlan::cached(96).get(), RealFftPlan::cached(96).get());
+}
+
+TEST(FftTest, GoodSizeIsFiveSmooth) {
+  EXPECT_EQ(FftPlan::good_size(0), 1u);
+  EXPECT_EQ(FftPlan::good_size(7), 8u);
+  EXPECT_EQ(FftPlan::good_size(11), 12u);
+  EXPECT_EQ(FftPlan::good_size(97), 100u);
+  EXPECT_EQ(FftPlan::good_size(1025), 1080u);
+}
+
+TEST(FftTest, RejectsInvalidLengths) {
+  EXPECT_THROW(FftPlan(0), std::invalid_argument);
+  EXPECT_THROW(RealFftPlan(7), std::invalid_argument);
+}
+
+} // namespace focus
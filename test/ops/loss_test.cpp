@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// loss_test.cpp
+//
+// Identification: test/ops/loss_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/loss.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+TEST(LossTest, SoftmaxCrossEntropy) {
+  // clang-format off
+  float a[2][3] = {
+    {1, 2, 3},
+    {1, 1, 1}
+  };
+  // clang-format on
+  size_t size[2] = {2, 3};
+  auto x = FloatTensor(&a[0][0], size, 2, true);
+  size_t targets[2] = {2, 0};
+
+  float lse0 = std::log(std::exp(1.0f) + std::exp(2.0f) + std::exp(3.0f));
+  float lse1 = 1 + std::log(3.0f);
+  float expected = ((lse0 - 3) + (lse1 - 1)) / 2;
+  EXPECT_NEAR(softmax_cross_entropy(x, targets), expected, 1e-6);
+
+  // d/dz = (softmax - onehot) / N.
+  for (size_t r = 0; r < 2; ++r) {
+    float lse = r == 0 ? lse0 : lse1;
+    for (size_t j = 0; j < 3; ++j) {
+      float p = std::exp(a[r][j] - lse);
+      float onehot = j == targets[r] ? 1.0f : 0.0f;
+      EXPECT_NEAR(x.grad_[r * 3 + j], (p - onehot) / 2, 1e-6);
+    }
+  }
+}
+
+TEST(LossTest, SoftmaxCrossEntropyLabelSmoothing) {
+  size_t rows = 64;
+  size_t classes = 1000;
+  std::vector<float> a(rows * classes);
+  std::vector<size_t> targets(rows);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = 20 * std::sin(0.37f * i);
+  }
+  for (size_t r = 0; r < rows; ++r) {
+    targets[r] = (r * 131) % classes;
+  }
+  size_t size[2] = {rows, classes};
+  auto x = FloatTensor(a.data(), size, 2, true);
+  float eps = 0.1f;
+  float loss = softmax_cross_entropy(x, targets.data(), eps);
+
+  double expected = 0;
+  for (size_t r = 0; r < rows; ++r) {
+    const float *z = a.data() + r * classes;
+    double max = z[0];
+    for (size_t j = 1; j < classes; ++j) {
+      max = std::max<double>(max, z[j]);
+    }
+    double sum = 0;
+    for (size_t j = 0; j < classes; ++j) {
+      sum += std::exp(z[j] - max);
+    }
+    double lse = max + std::log(sum);
+    for (size_t j = 0; j < classes; ++j) {
+      double q = eps / classes + (j == targets[r] ? 1 - eps : 0);
+      expected -= q * (z[j] - lse);
+      double grad = (std::exp(z[j] - lse) - q) / rows;
+      ASSERT_NEAR(x.grad_[r * classes + j], grad, 1e-6);
+    }
+  }
+  EXPECT_NEAR(loss, expected / rows, 1e-3);
+}
+
+TEST(LossTest, SoftmaxCrossEntropyInvalidTarget) {
+  float a[3] = {};
+  size_t size[2] = {1, 3};
+  auto x = FloatTensor(a, size, 2);
+  size_t targets[1] = {3};
+  EXPECT_THROW(softmax_cross_entropy(x, targets), std::out_of_range);
+}
+
+TEST(LossTest, MseLossAccumulatesGradient) {
+  float a[4] = {1, 2, 3, 4};
+  float b[4] = {0, 2, 5, 3};
+  size_t size[1] = {4};
+  auto x = FloatTensor(a, size, 1, true);
+  auto y = FloatTensor(b, size, 1);
+  EXPECT_FLOAT_EQ(mse_loss(x, y), (1 + 0 + 4 + 1) / 4.0f);
+  float expected_grad[4] = {0.5f, 0, -1, 0.5f};
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(x.grad_[i], expected_grad[i]);
+  }
+  mse_loss(x, y);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(x.grad_[i], 2 * expected_grad[i]);
+  }
+}
+
+TEST(LossTest, BinaryCrossEntropyWithLogits) {
+  float a[4] = {0, 2, -3, 100};
+  float b[4] = {1, 0, 0.5f, 1};
+  size_t size[1] = {4};
+  auto x = FloatTensor(a, size, 1, true);
+  auto y = FloatTensor(b, size, 1);
+  float loss = binary_cross_entropy_with_logits(x, y);
+
+  double expected = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    double p = 1 / (1 + std::exp(-double(a[i])));
+    double term = -(b[i] * std::log(p) + (1 - b[i]) * std::log1p(-p));
+    expected += std::isfinite(term) ? term : 0;
+    EXPECT_NEAR(x.grad_[i], (p - b[i]) / 4, 1e-6);
+  }
+  EXPECT_NEAR(loss, expected / 4, 1e-5);
+  EXPECT_TRUE(std::isfinite(loss));
+}
+
+TEST(LossTest, LossShapeMismatch) {
+  float a[4] = {};
+  size_t size[1] = {4};
+  size_t other_size[2] = {2, 2};
+  auto x = FloatTensor(a, size, 1);
+  auto y = FloatTensor(a, other_size, 2);
+  EXPECT_THROW(mse_loss(x, y), std::invalid_argument);
+  EXPECT_THROW(binary_cross_entropy_with_logits(x, y), std::invalid_argument);
+}
+
+} // namespace focus
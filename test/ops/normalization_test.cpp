@@ -0,0 +1,248 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// normalization_test.cpp
+//
+// Identification: test/ops/normalization_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/normalization.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+void fill_pattern(float *v, size_t n, float seed) {
+  for (size_t i = 0; i < n; ++i) {
+    v[i] = 3 + 2 * std::sin(seed + 0.61f * i);
+  }
+}
+
+/*
+ * Checks `grad_` of `t` against central differences of
+ * `sum(dy * forward())`, where `forward` reruns the op on the current data.
+ * The step is large enough that float rounding in the forward stays well
+ * below the tolerance.
+ */
+void check_gradient(FloatTensor &t, const std::vector<float> &dy,
+                    std::function<std::vector<float>()> forward) {
+  const float h = 5e-2f;
+  for (size_t i = 0; i < t.numel_; ++i) {
+    float saved = t.data_[i];
+    t.data_[i] = saved + h;
+    std::vector<float> up = forward();
+    t.data_[i] = saved - h;
+    std::vector<float> down = forward();
+    t.data_[i] = saved;
+    double numeric = 0;
+    for (size_t j = 0; j < dy.size(); ++j) {
+      numeric += dy[j] * (double(up[j]) - down[j]) / (2 * h);
+    }
+    EXPECT_NEAR(t.grad_[i], numeric, 2e-3) << "element " << i;
+  }
+}
+
+TEST(NormalizationTest, BatchNormTraining) {
+  size_t n = 4, c = 3, s = 10;
+  std::vector<float> in(n * c * s), out(n * c * s);
+  fill_pattern(in.data(), in.size(), 0.5f);
+  float w[3] = {1, 2, 0.5f}, b[3] = {0, -1, 3};
+  float rm[3] = {0, 0, 0}, rv[3] = {1, 1, 1};
+  float mean[3], invstd[3];
+  size_t size[3] = {n, c, s};
+  size_t c_size[1] = {c};
+  auto x = FloatTensor(in.data(), size, 3);
+  auto y = FloatTensor(out.data(), size, 3);
+  auto weight = FloatTensor(w, c_size, 1);
+  auto bias = FloatTensor(b, c_size, 1);
+  auto running_mean = FloatTensor(rm, c_size, 1);
+  auto running_var = FloatTensor(rv, c_size, 1);
+  batch_norm(x, &weight, &bias, &running_mean, &running_var, mean, invstd,
+             y);
+
+  for (size_t ch = 0; ch < c; ++ch) {
+    double sum = 0, sq = 0;
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t i = 0; i < s; ++i) {
+        double v = in[(k * c + ch) * s + i];
+        sum += v;
+        sq += v * v;
+      }
+    }
+    double m = sum / (n * s);
+    double var = sq / (n * s) - m * m;
+    EXPECT_NEAR(mean[ch], m, 1e-5);
+    EXPECT_NEAR(invstd[ch], 1 / std::sqrt(var + 1e-5), 1e-4);
+    EXPECT_NEAR(rm[ch], 0.1 * m, 1e-5);
+    EXPECT_NEAR(rv[ch], 0.9 + 0.1 * var * (n * s) / (n * s - 1), 1e-5);
+
+    // The output has the requested mean and scale.
+    double out_sum = 0, out_sq = 0;
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t i = 0; i < s; ++i) {
+        double v = out[(k * c + ch) * s + i];
+        out_sum += v;
+        out_sq += v * v;
+      }
+    }
+    double out_mean = out_sum / (n * s);
+    EXPECT_NEAR(out_mean, b[ch], 1e-4);
+    EXPECT_NEAR(std::sqrt(out_sq / (n * s) - out_mean * out_mean), w[ch],
+                1e-3);
+  }
+
+  // Evaluation uses the running statistics.
+  BatchNormParams eval;
+  eval.training_ = false;
+  batch_norm(x, nullptr, nullptr, &running_mean, &running_var, nullptr,
+             nullptr, y, eval);
+  EXPECT_NEAR(out[0], (in[0] - rm[0]) / std::sqrt(rv[0] + 1e-5f), 1e-5);
+  EXPECT_THROW(batch_norm(x, nullptr, nullptr, nullptr, nullptr, nullptr,
+                          nullptr, y, eval),
+               std::invalid_argument);
+
+  // Frozen running statistics may be read in evaluation but not updated.
+  running_mean.freeze_();
+  running_var.freeze_();
+  batch_norm(x, nullptr, nullptr, &running_mean, &running_var, nullptr,
+             nullptr, y, eval);
+  EXPECT_THROW(batch_norm(x, nullptr, nullptr, &running_mean, &running_var,
+                          nullptr, nullptr, y),
+               std::logic_error);
+  y.freeze_();
+  EXPECT_THROW(batch_norm(x, nullptr, nullptr, &running_mean, &running_var,
+                          nullptr, nullptr, y, eval),
+               std::logic_error);
+}
+
+TEST(NormalizationTest, BatchNormBackward) {
+  size_t n = 3, c = 2, s = 4;
+  std::vector<float> in(n * c * s), out(n * c * s), dy(n * c * s);
+  fill_pattern(in.data(), in.size(), 1.5f);
+  fill_pattern(dy.data(), dy.size(), 4.0f);
+  float w[2] = {1.5f, -0.5f}, b[2] = {0.2f, 0.1f};
+  float mean[2], invstd[2];
+  size_t size[3] = {n, c, s};
+  size_t c_size[1] = {c};
+  auto x = FloatTensor(in.data(), size, 3, true);
+  auto y = FloatTensor(out.data(), size, 3, true);
+  auto weight = FloatTensor(w, c_size, 1, true);
+  auto bias = FloatTensor(b, c_size, 1, true);
+  auto forward = [&] {
+    batch_norm(x, &weight, &bias, nullptr, nullptr, mean, invstd, y);
+    return out;
+  };
+  forward();
+  std::copy(dy.begin(), dy.end(), y.grad_);
+  batch_norm_backward(y, mean, invstd, x, &weight, &bias);
+  check_gradient(x, dy, forward);
+  check_gradient(weight, dy, forward);
+  check_gradient(bias, dy, forward);
+}
+
+TEST(NormalizationTest, LayerNormForwardBackward) {
+  size_t rows = 5, d = 37;
+  std::vector<float> in(rows * d), out(rows * d), dy(rows * d);
+  std::vector<float> w(d), b(d), mean(rows), invstd(rows);
+  fill_pattern(in.data(), in.size(), 0.1f);
+  fill_pattern(dy.data(), dy.size(), 2.3f);
+  fill_pattern(w.data(), d, 5.0f);
+  fill_pattern(b.data(), d, 6.0f);
+  size_t size[2] = {rows, d};
+  size_t d_size[1] = {d};
+  auto x = FloatTensor(in.data(), size, 2, true);
+  auto y = FloatTensor(out.data(), size, 2, true);
+  auto weight = FloatTensor(w.data(), d_size, 1, true);
+  auto bias = FloatTensor(b.data(), d_size, 1, true);
+  auto forward = [&] {
+    layer_norm(x, &weight, &bias, 1e-5f, mean.data(), invstd.data(), y);
+    return out;
+  };
+  forward();
+
+  for (size_t r = 0; r < rows; ++r) {
+    double sum = 0, sq = 0;
+    for (size_t j = 0; j < d; ++j) {
+      sum += in[r * d + j];
+      sq += double(in[r * d + j]) * in[r * d + j];
+    }
+    double m = sum / d;
+    double inv = 1 / std::sqrt(sq / d - m * m + 1e-5);
+    for (size_t j = 0; j < d; ++j) {
+      EXPECT_NEAR(out[r * d + j], (in[r * d + j] - m) * inv * w[j] + b[j],
+                  1e-4);
+    }
+  }
+
+  std::copy(dy.begin(), dy.end(), y.grad_);
+  layer_norm_backward(y, mean.data(), invstd.data(), x, &weight, &bias);
+  check_gradient(x, dy, forward);
+  check_gradient(weight, dy, forward);
+  check_gradient(bias, dy, forward);
+}
+
+TEST(NormalizationTest, GroupNormForwardBackward) {
+  size_t n = 2, c = 6, s = 5, groups = 3;
+  std::vector<float> in(n * c * s), out(n * c * s), dy(n * c * s);
+  std::vector<float> mean(n * groups), invstd(n * groups);
+  float w[6] = {1, 2, 3, -1, 0.5f, 1}, b[6] = {0, 1, 0, 1, 0, 1};
+  fill_pattern(in.data(), in.size(), 0.9f);
+  fill_pattern(dy.data(), dy.size(), 3.1f);
+  size_t size[3] = {n, c, s};
+  size_t c_size[1] = {c};
+  auto x = FloatTensor(in.data(), size, 3, true);
+  auto y = FloatTensor(out.data(), size, 3, true);
+  auto weight = FloatTensor(w, c_size, 1, true);
+  auto bias = FloatTensor(b, c_size, 1, true);
+  auto forward = [&] {
+    group_norm(x, groups, &weight, &bias, 1e-5f, mean.data(), invstd.data(),
+               y);
+    return out;
+  };
+  forward();
+
+  // Each group of two channels has the statistics of its 10 elements.
+  for (size_t p = 0; p < n * groups; ++p) {
+    double sum = 0;
+    for (size_t i = 0; i < 2 * s; ++i) {
+      sum += in[p * 2 * s + i];
+    }
+    EXPECT_NEAR(mean[p], sum / (2 * s), 1e-5);
+  }
+
+  std::copy(dy.begin(), dy.end(), y.grad_);
+  group_norm_backward(y, groups, mean.data(), invstd.data(), x, &weight,
+                      &bias);
+  check_gradient(x, dy, forward);
+  check_gradient(weight, dy, forward);
+  check_gradient(bias, dy, forward);
+
+  EXPECT_THROW(group_norm(x, 4, nullptr, nullptr, 1e-5f, nullptr, nullptr, y),
+               std::invalid_argument);
+}
+
+TEST(NormalizationTest, WelfordLargeOffset) {
+  // A large common offset defeats the naive sum-of-squares formula in float.
+  size_t d = 1000;
+  std::vector<float> in(d), out(d);
+  for (size_t i = 0; i < d; ++i) {
+    in[i] = 10000 + (i % 2 ? 1.0f : -1.0f);
+  }
+  float mean, invstd;
+  size_t size[2] = {1, d};
+  auto x = FloatTensor(in.data(), size, 2);
+  auto y = FloatTensor(out.data(), size, 2);
+  layer_norm(x, nullptr, nullptr, 0, &mean, &invstd, y);
+  EXPECT_NEAR(mean, 10000, 1e-3);
+  EXPECT_NEAR(invstd, 1, 1e-3);
+  EXPECT_NEAR(out[0], -1, 1e-3);
+  EXPECT_NEAR(out[1], 1, 1e-3);
+}
+
+} // namespace focus
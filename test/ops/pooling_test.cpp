@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// pooling_test.cpp
+//
+// Identification: test/ops/pooling_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/conv2d.h"
+#include "ops/pooling.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+// Reference pooling that visits every window position directly.
+std::vector<float> reference_pool(const std::vector<float> &in, size_t planes,
+                                  size_t h, size_t w,
+                                  const Pool2dParams &params, bool max) {
+  size_t oh = conv2d_output_size(h, params.kernel_h_, params.stride_h_,
+                                 params.pad_h_);
+  size_t ow = conv2d_output_size(w, params.kernel_w_, params.stride_w_,
+                                 params.pad_w_);
+  std::vector<float> out(planes * oh * ow);
+  for (size_t p = 0; p < planes; ++p) {
+    for (size_t y = 0; y < oh; ++y) {
+      for (size_t x = 0; x < ow; ++x) {
+        float acc = max ? -std::numeric_limits<float>::infinity() : 0;
+        size_t count = 0;
+        for (size_t kh = 0; kh < params.kernel_h_; ++kh) {
+          for (size_t kw = 0; kw < params.kernel_w_; ++kw) {
+            long ih = long(y * params.stride_h_ + kh) - long(params.pad_h_);
+            long iw = long(x * params.stride_w_ + kw) - long(params.pad_w_);
+            if (ih < 0 || iw < 0 || ih >= long(h) || iw >= long(w)) {
+              continue;
+            }
+            float v = in[(p * h + ih) * w + iw];
+            acc = max ? std::max(acc, v) : acc + v;
+            ++count;
+          }
+        }
+        out[(p * oh + y) * ow + x] = max ? acc : acc / count;
+      }
+    }
+  }
+  return out;
+}
+
+void check_pool(size_t n, size_t c, size_t h, size_t w,
+                const Pool2dParams &params) {
+  std::vector<float> in(n * c * h * w);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = std::sin(0.7f * i);
+  }
+  size_t oh = conv2d_output_size(h, params.kernel_h_, params.stride_h_,
+                                 params.pad_h_);
+  size_t ow = conv2d_output_size(w, params.kernel_w_, params.stride_w_,
+                                 params.pad_w_);
+  std::vector<float> out(n * c * oh * ow);
+  size_t in_size[4] = {n, c, h, w};
+  size_t out_size[4] = {n, c, oh, ow};
+  auto x = FloatTensor(in.data(), in_size, 4);
+  auto y = FloatTensor(out.data(), out_size, 4);
+
+  max_pool2d(x, y, params);
+  std::vector<float> expected = reference_pool(in, n * c, h, w, params, true);
+  for (size_t i = 0; i < out.size(); ++i) {
+    ASSERT_EQ(out[i], expected[i]) << "max index " << i;
+  }
+  avg_pool2d(x, y, params);
+  expected = reference_pool(in, n * c, h, w, params, false);
+  for (size_t i = 0; i < out.size(); ++i) {
+    ASSERT_NEAR(out[i], expected[i], 1e-6) << "avg index " << i;
+  }
+}
+
+TEST(PoolingTest, Pool2dDefault) {
+  // clang-format off
+  float a[1][1][4][4] = {{{
+    {1,  2,  3,  4},
+    {5,  6,  7,  8},
+    {9,  10, 11, 12},
+    {13, 14, 15, 16}
+  }}};
+  // clang-format on
+  size_t in_size[4] = {1, 1, 4, 4};
+  size_t out_size[4] = {1, 1, 2, 2};
+  float out[4];
+  auto x = FloatTensor(&a[0][0][0][0], in_size, 4);
+  auto y = FloatTensor(out, out_size, 4);
+  max_pool2d(x, y);
+  float expected_max[4] = {6, 8, 14, 16};
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(out[i], expected_max[i]);
+  }
+  avg_pool2d(x, y);
+  float expected_avg[4] = {3.5f, 5.5f, 11.5f, 13.5f};
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(out[i], expected_avg[i]);
+  }
+}
+
+TEST(PoolingTest, Pool2dStrideAndPadding) {
+  Pool2dParams params;
+  params.kernel_h_ = 3;
+  params.kernel_w_ = 3;
+  params.stride_h_ = 1;
+  params.stride_w_ = 1;
+  params.pad_h_ = 1;
+  params.pad_w_ = 1;
+  check_pool(2, 3, 7, 9, params);
+
+  params.stride_h_ = 2;
+  params.stride_w_ = 3;
+  check_pool(1, 4, 10, 11, params);
+
+  params.kernel_h_ = 2;
+  params.kernel_w_ = 5;
+  params.pad_h_ = 0;
+  params.pad_w_ = 2;
+  check_pool(2, 2, 6, 13, params);
+}
+
+TEST(PoolingTest, GlobalPool2d) {
+  size_t n = 2, c = 3, h = 5, w = 7;
+  std::vector<float> in(n * c * h * w);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = std::cos(0.3f * i);
+  }
+  size_t in_size[4] = {n, c, h, w};
+  size_t out_size[2] = {n, c};
+  std::vector<float> out(n * c);
+  auto x = FloatTensor(in.data(), in_size, 4);
+  auto y = FloatTensor(out.data(), out_size, 2);
+
+  global_avg_pool2d(x, y);
+  for (size_t p = 0; p < n * c; ++p) {
+    float sum = 0;
+    for (size_t i = 0; i < h * w; ++i) {
+      sum += in[p * h * w + i];
+    }
+    EXPECT_NEAR(out[p], sum / (h * w), 1e-6);
+  }
+  global_max_pool2d(x, y);
+  for (size_t p = 0; p < n * c; ++p) {
+    EXPECT_EQ(out[p], *std::max_element(in.begin() + p * h * w,
+                                        in.begin() + (p + 1) * h * w));
+  }
+}
+
+TEST(PoolingTest, PoolShapeMismatch) {
+  float a[16] = {};
+  size_t in_size[4] = {1, 1, 4, 4};
+  size_t out_size[4] = {1, 1, 3, 3};
+  auto x = FloatTensor(a, in_size, 4);
+  auto y = FloatTensor(a, out_size, 4);
+  EXPECT_THROW(max_pool2d(x, y), std::invalid_argument);
+  EXPECT_THROW(global_avg_pool2d(x, y), std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// preprocess_test.cpp
+//
+// Identification: test/ops/preprocess_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/preprocess.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+// clang-format off
+uint8_t P[2][3][2] = {
+  {{10, 20}, {30, 40}, {50, 60}},
+  {{70, 80}, {90, 100}, {110, 120}}
+};
+// clang-format on
+
+ImageView make_view(const uint8_t *data, size_t h, size_t w, size_t c) {
+  ImageView view;
+  view.data_ = data;
+  view.height_ = h;
+  view.width_ = w;
+  view.channels_ = c;
+  return view;
+}
+
+TEST(PreprocessTest, PreprocessNormalizeAndTranspose) {
+  ImageView image = make_view(&P[0][0][0], 2, 3, 2);
+  PreprocessParams params;
+  params.scale_ = 1;
+  params.mean_ = {10, 20};
+  params.std_ = {10, 20};
+  float out[1][2][2][3];
+  size_t size[4] = {1, 2, 2, 3};
+  auto batch = FloatTensor(&out[0][0][0][0], size, 4);
+  preprocess_images(&image, 1, params, batch);
+  float expected_values[12] = {0, 2, 4, 6, 8, 10, 0, 1, 2, 3, 4, 5};
+  for (size_t i = 0; i < batch.numel_; ++i) {
+    EXPECT_FLOAT_EQ(batch.data_[i], expected_values[i]);
+  }
+}
+
+TEST(PreprocessTest, PreprocessCenterCrop) {
+  ImageView image = make_view(&P[0][0][0], 2, 3, 2);
+  PreprocessParams params;
+  params.scale_ = 1;
+  params.crop_h_ = 1;
+  params.crop_w_ = 1;
+  float out[1][2][1][1];
+  size_t size[4] = {1, 2, 1, 1};
+  auto batch = FloatTensor(&out[0][0][0][0], size, 4);
+  preprocess_images(&image, 1, params, batch);
+  EXPECT_FLOAT_EQ(batch.data_[0], 30);
+  EXPECT_FLOAT_EQ(batch.data_[1], 40);
+}
+
+TEST(PreprocessTest, PreprocessBilinearResize) {
+  uint8_t pixels[2][2] = {{0, 100}, {100, 200}};
+  ImageView image = make_view(&pixels[0][0], 2, 2, 1);
+  PreprocessParams params;
+  params.scale_ = 1;
+  float out[1][1][4][4];
+  size_t size[4] = {1, 1, 4, 4};
+  auto batch = FloatTensor(&out[0][0][0][0], size, 4);
+  preprocess_images(&image, 1, params, batch);
+  // clang-format off
+  float expected_values[16] = {
+    0,   25,  75,  100,
+    25,  50,  100, 125,
+    75,  100, 150, 175,
+    100, 125, 175, 200
+  };
+  // clang-format on
+  for (size_t i = 0; i < batch.numel_; ++i) {
+    EXPECT_FLOAT_EQ(batch.data_[i], expected_values[i]);
+  }
+}
+
+TEST(PreprocessTest, PreprocessRandomCropBatch) {
+  // Pixel value encodes its position so the crop origin can be recovered.
+  std::vector<uint8_t> pixels(8 * 8);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i);
+  }
+  ImageView images[3];
+  for (size_t i = 0; i < 3; ++i) {
+    images[i] = make_view(pixels.data(), 8, 8, 1);
+  }
+  PreprocessParams params;
+  params.scale_ = 1;
+  params.crop_h_ = 4;
+  params.crop_w_ = 4;
+  params.crop_mode_ = CropMode::RANDOM;
+  params.seed_ = 7;
+  std::vector<float> out(3 * 16);
+  std::vector<float> again(3 * 16);
+  size_t size[4] = {3, 1, 4, 4};
+  auto batch = FloatTensor(out.data(), size, 4);
+  auto repeat = FloatTensor(again.data(), size, 4);
+  preprocess_images(images, 3, params, batch);
+  preprocess_images(images, 3, params, repeat);
+
+  for (size_t i = 0; i < 3; ++i) {
+    const float *crop = out.data() + i * 16;
+    size_t origin = static_cast<size_t>(crop[0]);
+    EXPECT_LE(origin / 8, 4);
+    EXPECT_LE(origin % 8, 4);
+    for (size_t y = 0; y < 4; ++y) {
+      for (size_t x = 0; x < 4; ++x) {
+        EXPECT_EQ(crop[y * 4 + x], origin + y * 8 + x);
+      }
+    }
+  }
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i], again[i]);
+  }
+}
+
+TEST(PreprocessTest, PreprocessShapeMismatch) {
+  ImageView image = make_view(&P[0][0][0], 2, 3, 2);
+  PreprocessParams params;
+  params.crop_h_ = 3;
+  float out[1][2][3][3];
+  size_t size[4] = {1, 2, 3, 3};
+  auto batch = FloatTensor(&out[0][0][0][0], size, 4);
+  EXPECT_THROW(preprocess_images(&image, 1, params, batch),
+               std::invalid_argument);
+}
+
+} // namespace focus
@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// recurrent_test.cpp
+//
+// Identification: test/ops/recurrent_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/recurrent.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace focus {
+
+void fill_pattern(std::vector<float> &v, float seed) {
+  for (size_t i = 0; i < v.size(); ++i) {
+    v[i] = 0.5f * std::sin(seed + 0.71f * i);
+  }
+}
+
+float reference_sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+// gates[j] = w[j] . x + b[j]
+std::vector<float> affine(const std::vector<float> &w, const float *x,
+                          size_t in, const std::vector<float> &b) {
+  std::vector<float> out(b);
+  for (size_t j = 0; j < out.size(); ++j) {
+    for (size_t i = 0; i < in; ++i) {
+      out[j] += w[j * in + i] * x[i];
+    }
+  }
+  return out;
+}
+
+struct RnnCase {
+  size_t steps_, batch_, input_, hidden_;
+  std::vector<float> x_, w_ih_, w_hh_, b_ih_, b_hh_, h_, c_;
+
+  RnnCase(size_t t, size_t b, size_t in, size_t hs, size_t gates)
+      : steps_(t), batch_(b), input_(in), hidden_(hs), x_(t * b * in),
+        w_ih_(gates * hs * in), w_hh_(gates * hs * hs), b_ih_(gates * hs),
+        b_hh_(gates * hs), h_(b * hs), c_(b * hs) {
+    fill_pattern(x_, 0.3f);
+    fill_pattern(w_ih_, 1.1f);
+    fill_pattern(w_hh_, 2.9f);
+    fill_pattern(b_ih_, 0.7f);
+    fill_pattern(b_hh_, 4.2f);
+    fill_pattern(h_, 5.5f);
+    fill_pattern(c_, 6.1f);
+  }
+};
+
+void check_lstm(size_t t, size_t b, size_t in, size_t hs) {
+  RnnCase rc(t, b, in, hs, 4);
+
+  // Step-by-step reference.
+  std::vector<float> ref_h = rc.h_, ref_c = rc.c_, ref_out(t * b * hs);
+  for (size_t step = 0; step < t; ++step) {
+    for (size_t row = 0; row < b; ++row) {
+      std::vector<float> gx =
+          affine(rc.w_ih_, &rc.x_[(step * b + row) * in], in, rc.b_ih_);
+      std::vector<float> gh =
+          affine(rc.w_hh_, &ref_h[row * hs], hs, rc.b_hh_);
+      for (size_t k = 0; k < hs; ++k) {
+        float i = reference_sigmoid(gx[k] + gh[k]);
+        float f = reference_sigmoid(gx[hs + k] + gh[hs + k]);
+        float g = std::tanh(gx[2 * hs + k] + gh[2 * hs + k]);
+        float o = reference_sigmoid(gx[3 * hs + k] + gh[3 * hs + k]);
+        float &c = ref_c[row * hs + k];
+        c = f * c + i * g;
+        ref_out[(step * b + row) * hs + k] = o * std::tanh(c);
+      }
+      for (size_t k = 0; k < hs; ++k) {
+        ref_h[row * hs + k] = ref_out[(step * b + row) * hs + k];
+      }
+    }
+  }
+
+  size_t x_size[3] = {t, b, in};
+  size_t w_ih_size[2] = {4 * hs, in};
+  size_t w_hh_size[2] = {4 * hs, hs};
+  size_t b_size[1] = {4 * hs};
+  size_t h_size[2] = {b, hs};
+  size_t out_size[3] = {t, b, hs};
+  std::vector<float> out(t * b * hs);
+  auto x = FloatTensor(rc.x_.data(), x_size, 3);
+  auto w_ih = FloatTensor(rc.w_ih_.data(), w_ih_size, 2);
+  auto w_hh = FloatTensor(rc.w_hh_.data(), w_hh_size, 2);
+  auto b_ih = FloatTensor(rc.b_ih_.data(), b_size, 1);
+  auto b_hh = FloatTensor(rc.b_hh_.data(), b_size, 1);
+  auto h = FloatTensor(rc.h_.data(), h_size, 2);
+  auto c = FloatTensor(rc.c_.data(), h_size, 2);
+  auto y = FloatTensor(out.data(), out_size, 3);
+  lstm(x, w_ih, w_hh, &b_ih, &b_hh, h, c, y);
+
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_NEAR(out[i], ref_out[i], 1e-5);
+  }
+  for (size_t i = 0; i < rc.h_.size(); ++i) {
+    EXPECT_NEAR(rc.h_[i], ref_h[i], 1e-5);
+    EXPECT_NEAR(rc.c_[i], ref_c[i], 1e-5);
+  }
+}
+
+void check_gru(size_t t, size_t b, size_t in, size_t hs) {
+  RnnCase rc(t, b, in, hs, 3);
+
+  std::vector<float> ref_h = rc.h_, ref_out(t * b * hs);
+  for (size_t step = 0; step < t; ++step) {
+    for (size_t row = 0; row < b; ++row) {
+      std::vector<float> gx =
+          affine(rc.w_ih_, &rc.x_[(step * b + row) * in], in, rc.b_ih_);
+      std::vector<float> gh =
+          affine(rc.w_hh_, &ref_h[row * hs], hs, rc.b_hh_);
+      for (size_t k = 0; k < hs; ++k) {
+        float r = reference_sigmoid(gx[k] + gh[k]);
+        float z = reference_sigmoid(gx[hs + k] + gh[hs + k]);
+        float n = std::tanh(gx[2 * hs + k] + r * gh[2 * hs + k]);
+        ref_out[(step * b + row) * hs + k] =
+            (1 - z) * n + z * ref_h[row * hs + k];
+      }
+      for (size_t k = 0; k < hs; ++k) {
+        ref_h[row * hs + k] = ref_out[(step * b + row) * hs + k];
+      }
+    }
+  }
+
+  size_t x_size[3] = {t, b, in};
+  size_t w_ih_size[2] = {3 * hs, in};
+  size_t w_hh_size[2] = {3 * hs, hs};
+  size_t b_size[1] = {3 * hs};
+  size_t h_size[2] = {b, hs};
+  size_t out_size[3] = {t, b, hs};
+  std::vector<float> out(t * b * hs);
+  auto x = FloatTensor(rc.x_.data(), x_size, 3);
+  auto w_ih = FloatTensor(rc.w_ih_.data(), w_ih_size, 2);
+  auto w_hh = FloatTensor(rc.w_hh_.data(), w_hh_size, 2);
+  auto b_ih = FloatTensor(rc.b_ih_.data(), b_size, 1);
+  auto b_hh = FloatTensor(rc.b_hh_.data(), b_size, 1);
+  auto h = FloatTensor(rc.h_.data(), h_size, 2);
+  auto y = FloatTensor(out.data(), out_size, 3);
+  gru(x, w_ih, w_hh, &b_ih, &b_hh, h, y);
+
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_NEAR(out[i], ref_out[i], 1e-5);
+  }
+  for (size_t i = 0; i < rc.h_.size(); ++i) {
+    EXPECT_NEAR(rc.h_[i], ref_h[i], 1e-5);
+  }
+}
+
+TEST(RecurrentTest, LstmMatchesReference) {
+  check_lstm(3, 2, 5, 4);
+  // Enough batch rows to span several blocks and threads.
+  check_lstm(7, 37, 70, 20);
+}
+
+TEST(RecurrentTest, GruMatchesReference) {
+  check_gru(3, 2, 5, 4);
+  check_gru(7, 37, 70, 20);
+}
+
+TEST(RecurrentTest, RecurrentShapeMismatch) {
+  std::vector<float> buf(256);
+  size_t x_size[3] = {2, 1, 3};
+  size_t w_size[2] = {8, 3};
+  size_t h_size[2] = {1, 2};
+  size_t out_size[3] = {2, 1, 2};
+  auto x = FloatTensor(buf.data(), x_size, 3);
+  auto w = FloatTensor(buf.data(), w_size, 2);
+  auto h = FloatTensor(buf.data(), h_size, 2);
+  auto y = FloatTensor(buf.data(), out_size, 3);
+  // `w_hh` must be `[4H, H]`, not `[4H, I]`.
+  EXPECT_THROW(lstm(x, w, w, nullptr, nullptr, h, h, y),
+               std::invalid_argument);
+  // A 3-D hidden state is reported as such, not as a bad input.
+  size_t w2_size[2] = {6, 3};
+  auto w2 = FloatTensor(buf.data(), w2_size, 2);
+  auto h3 = FloatTensor(buf.data(), out_size, 3);
+  try {
+    gru(x, w2, w2, nullptr, nullptr, h3, y);
+    FAIL() << "expected std::invalid_argument";
+  } catch (const std::invalid_argument &e) {
+    EXPECT_NE(std::string(e.what()).find("hidden state"), std::string::npos);
+  }
+}
+
+} // namespace focus
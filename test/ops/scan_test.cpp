@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// scan_test.cpp
+//
+// Identification: test/ops/scan_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/scan.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+TEST(ScanTest, CumsumAlongEachDim) {
+  // clang-format off
+  float a[2][3] = {
+    {1, 2, 3},
+    {4, 5, 6}
+  };
+  // clang-format on
+  size_t size[2] = {2, 3};
+  auto x = FloatTensor(&a[0][0], size, 2);
+
+  float out[6];
+  auto y = FloatTensor(out, size, 2);
+  float along_rows[6] = {1, 3, 6, 4, 9, 15};
+  cumsum(x, 1, y);
+  for (size_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(out[i], along_rows[i]);
+  }
+
+  float along_cols[6] = {1, 2, 3, 5, 7, 9};
+  cumsum(x, 0, y);
+  for (size_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(out[i], along_cols[i]);
+  }
+}
+
+TEST(ScanTest, CumprodInPlace) {
+  float a[5] = {1, 2, 3, 0.5f, -1};
+  size_t size[1] = {5};
+  auto x = FloatTensor(a, size, 1);
+  cumprod(x, 0, x);
+  float expected[5] = {1, 2, 6, 3, -3};
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(a[i], expected[i]);
+  }
+}
+
+TEST(ScanTest, CumsumLongRowIsBlocked) {
+  // One long lane takes the two-pass blocked path; small integers keep the
+  // sums exact regardless of association order.
+  size_t n = 100003;
+  std::vector<float> a(n), out(n);
+  for (size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<float>(i % 3);
+  }
+  size_t size[1] = {n};
+  auto x = FloatTensor(a.data(), size, 1);
+  auto y = FloatTensor(out.data(), size, 1);
+  cumsum(x, 0, y);
+  float expected = 0;
+  for (size_t i = 0; i < n; ++i) {
+    expected += a[i];
+    ASSERT_EQ(out[i], expected) << "index " << i;
+  }
+}
+
+TEST(ScanTest, CumprodMiddleDim) {
+  size_t size[3] = {2, 4, 300};
+  std::vector<float> a(2 * 4 * 300), out(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(1 + i % 3);
+  }
+  auto x = FloatTensor(a.data(), size, 3);
+  auto y = FloatTensor(out.data(), size, 3);
+  cumprod(x, 1, y);
+  for (size_t o = 0; o < 2; ++o) {
+    for (size_t j = 0; j < 300; ++j) {
+      float expected = 1;
+      for (size_t i = 0; i < 4; ++i) {
+        size_t at = (o * 4 + i) * 300 + j;
+        expected *= a[at];
+        EXPECT_EQ(out[at], expected);
+      }
+    }
+  }
+}
+
+TEST(ScanTest, ScanInvalidArguments) {
+  float a[4] = {};
+  size_t size[2] = {2, 2};
+  size_t other_size[2] = {4, 1};
+  auto x = FloatTensor(a, size, 2);
+  auto y = FloatTensor(a, other_size, 2);
+  EXPECT_THROW(cumsum(x, 2, x), std::out_of_range);
+  EXPECT_THROW(cumsum(x, 0, y), std::invalid_argument);
+
+  auto z = FloatTensor(a, size, 2);
+  z.freeze_();
+  EXPECT_THROW(cumprod(x, 1, z), std::logic_error);
+}
+
+} // namespace focus
@@ -0,0 +1,208 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sort_test.cpp
+//
+// Identification: test/ops/sort_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/sort.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+// Values with many duplicates so stability matters.
+std::vector<float> scores(size_t n) {
+  std::vector<float> out(n);
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<float>((i * 7919) % 1009) - 500;
+  }
+  return out;
+}
+
+// Stable ascending or descending order of one row.
+std::vector<size_t> reference_order(const std::vector<float> &row,
+                                    bool descending) {
+  std::vector<size_t> order(row.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return descending ? row[a] > row[b] : row[a] < row[b];
+  });
+  return order;
+}
+
+void check_sort_row(size_t n, bool descending) {
+  std::vector<float> a = scores(n), out(n);
+  std::vector<size_t> indices(n);
+  size_t size[1] = {n};
+  auto x = FloatTensor(a.data(), size, 1);
+  auto y = FloatTensor(out.data(), size, 1);
+  sort(x, 0, descending, y, indices.data());
+
+  std::vector<size_t> expected = reference_order(a, descending);
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(indices[i], expected[i]) << "n " << n << " index " << i;
+    ASSERT_EQ(out[i], a[expected[i]]);
+  }
+}
+
+TEST(SortTest, SortSmallRowsUseNetwork) {
+  for (size_t n = 1; n <= 33; ++n) {
+    check_sort_row(n, false);
+    check_sort_row(n, true);
+  }
+}
+
+TEST(SortTest, SortLongRow) {
+  check_sort_row(1000, false);
+  // Long enough for the parallel chunked merge sort.
+  check_sort_row(100000, true);
+}
+
+TEST(SortTest, SortAlongFirstDim) {
+  // clang-format off
+  float a[3][2] = {
+    {3, 1},
+    {1, 2},
+    {2, 0}
+  };
+  // clang-format on
+  size_t size[2] = {3, 2};
+  auto x = FloatTensor(&a[0][0], size, 2);
+  float out[6];
+  size_t indices[6];
+  auto y = FloatTensor(out, size, 2);
+  sort(x, 0, false, y, indices);
+  float expected_values[6] = {1, 0, 2, 1, 3, 2};
+  size_t expected_indices[6] = {1, 2, 2, 0, 0, 1};
+  for (size_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(out[i], expected_values[i]);
+    EXPECT_EQ(indices[i], expected_indices[i]);
+  }
+
+  argsort(x, 1, true, indices);
+  size_t expected_argsort[6] = {0, 1, 1, 0, 0, 1};
+  for (size_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(indices[i], expected_argsort[i]);
+  }
+}
+
+TEST(SortTest, TopkRows) {
+  size_t rows = 16;
+  size_t n = 500;
+  size_t k = 10;
+  std::vector<float> a = scores(rows * n);
+  std::vector<float> out(rows * k);
+  std::vector<size_t> indices(rows * k);
+  size_t size[2] = {rows, n};
+  size_t out_size[2] = {rows, k};
+  auto x = FloatTensor(a.data(), size, 2);
+  auto y = FloatTensor(out.data(), out_size, 2);
+  for (bool largest : {true, false}) {
+    topk(x, 1, k, largest, y, indices.data());
+    for (size_t r = 0; r < rows; ++r) {
+      std::vector<float> row(a.begin() + r * n, a.begin() + (r + 1) * n);
+      std::vector<size_t> expected = reference_order(row, largest);
+      for (size_t i = 0; i < k; ++i) {
+        EXPECT_EQ(indices[r * k + i], expected[i]);
+        EXPECT_EQ(out[r * k + i], row[expected[i]]);
+      }
+    }
+  }
+}
+
+TEST(SortTest, TopkLongRow) {
+  // A single row of millions-of-scores shape takes the parallel selection.
+  size_t n = 200000;
+  size_t k = 25;
+  std::vector<float> a = scores(n);
+  std::vector<float> out(k);
+  std::vector<size_t> indices(k);
+  size_t size[1] = {n};
+  size_t out_size[1] = {k};
+  auto x = FloatTensor(a.data(), size, 1);
+  auto y = FloatTensor(out.data(), out_size, 1);
+  topk(x, 0, k, true, y, indices.data());
+  std::vector<size_t> expected = reference_order(a, true);
+  for (size_t i = 0; i < k; ++i) {
+    EXPECT_EQ(indices[i], expected[i]);
+    EXPECT_EQ(out[i], a[expected[i]]);
+  }
+}
+
+/*
+ * Rows of `scores` with about a third of the values, scattered, replaced by
+ * NaN. The expected order
+ * puts the numbers first, stably, then the NaNs in their original order.
+ */
+void check_nan_row(size_t n, bool descending, size_t k) {
+  std::vector<float> a = scores(n);
+  for (size_t i = 0; i < n; ++i) {
+    if ((i * 2654435761u >> 7) % 3 == 0) {
+      a[i] = std::numeric_limits<float>::quiet_NaN();
+    }
+  }
+  std::vector<size_t> expected(n);
+  for (size_t i = 0; i < n; ++i) {
+    expected[i] = i;
+  }
+  std::stable_sort(expected.begin(), expected.end(), [&](size_t x, size_t y) {
+    if (std::isnan(a[x]) || std::isnan(a[y])) {
+      return !std::isnan(a[x]) && std::isnan(a[y]);
+    }
+    return descending ? a[x] > a[y] : a[x] < a[y];
+  });
+
+  size_t size[1] = {n};
+  auto x = FloatTensor(a.data(), size, 1);
+  std::vector<float> out(n);
+  std::vector<size_t> indices(n);
+  auto y = FloatTensor(out.data(), size, 1);
+  sort(x, 0, descending, y, indices.data());
+  EXPECT_EQ(indices, expected) << "sort n " << n;
+
+  std::vector<size_t> order(n);
+  argsort(x, 0, descending, order.data());
+  EXPECT_EQ(order, expected) << "argsort n " << n;
+
+  size_t out_size[1] = {k};
+  std::vector<float> top(k);
+  std::vector<size_t> top_indices(k);
+  auto t = FloatTensor(top.data(), out_size, 1);
+  topk(x, 0, k, descending, t, top_indices.data());
+  EXPECT_EQ(top_indices,
+            std::vector<size_t>(expected.begin(), expected.begin() + k))
+      << "topk n " << n;
+}
+
+TEST(SortTest, NanSortsLast) {
+  for (bool descending : {false, true}) {
+    // The bitonic network, std::sort, and topk reaching into the NaNs.
+    check_nan_row(20, descending, 16);
+    check_nan_row(2885, descending, 40);
+    check_nan_row(2885, descending, 2000);
+  }
+}
+
+TEST(SortTest, TopkInvalidArguments) {
+  float a[4] = {};
+  size_t size[1] = {4};
+  size_t out_size[1] = {2};
+  auto x = FloatTensor(a, size, 1);
+  auto y = FloatTensor(a, out_size, 1);
+  EXPECT_THROW(topk(x, 0, 5, true, y, nullptr), std::out_of_range);
+  EXPECT_THROW(topk(x, 0, 3, true, y, nullptr), std::invalid_argument);
+  EXPECT_THROW(topk(x, 1, 2, true, y, nullptr), std::out_of_range);
+}
+
+} // namespace focus
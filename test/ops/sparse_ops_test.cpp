@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sparse_ops_test.cpp
+//
+// Identification: test/ops/sparse_ops_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "ops/sparse_ops.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace focus {
+
+// Roughly 10% dense matrix with a skewed first row.
+std::vector<float> make_sparse_values(size_t rows, size_t cols) {
+  std::vector<float> out(rows * cols, 0);
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < cols; ++c) {
+      if (r == 0 || (r * 31 + c * 17) % 10 == 0) {
+        out[r * cols + c] = static_cast<float>((r + 2 * c) % 7) - 3;
+      }
+    }
+  }
+  return out;
+}
+
+TEST(SparseOpsTest, SparseOpsSpmv) {
+  size_t rows = 37;
+  size_t cols = 23;
+  std::vector<float> a = make_sparse_values(rows, cols);
+  std::vector<float> x(cols);
+  for (size_t i = 0; i < cols; ++i) {
+    x[i] = 0.5f * i;
+  }
+  std::vector<float> y(rows);
+  size_t a_size[2] = {rows, cols};
+  size_t x_size[1] = {cols};
+  size_t y_size[1] = {rows};
+  auto a_t = FloatTensor(a.data(), a_size, 2);
+  auto x_t = FloatTensor(x.data(), x_size, 1);
+  auto y_t = FloatTensor(y.data(), y_size, 1);
+  CsrTensor csr(a_t);
+  spmv(csr, x_t, y_t);
+  for (size_t r = 0; r < rows; ++r) {
+    float expected = 0;
+    for (size_t c = 0; c < cols; ++c) {
+      expected += a[r * cols + c] * x[c];
+    }
+    EXPECT_NEAR(y[r], expected, 1e-3);
+  }
+}
+
+TEST(SparseOpsTest, SparseOpsSpmm) {
+  size_t m = 29;
+  size_t k = 19;
+  size_t n = 13;
+  std::vector<float> a = make_sparse_values(m, k);
+  std::vector<float> b(k * n);
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(i % 5) - 2;
+  }
+  std::vector<float> c(m * n);
+  size_t a_size[2] = {m, k};
+  size_t b_size[2] = {k, n};
+  size_t c_size[2] = {m, n};
+  auto a_t = FloatTensor(a.data(), a_size, 2);
+  auto b_t = FloatTensor(b.data(), b_size, 2);
+  auto c_t = FloatTensor(c.data(), c_size, 2);
+  CsrTensor csr(a_t);
+  spmm(csr, b_t, c_t);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      float expected = 0;
+      for (size_t p = 0; p < k; ++p) {
+        expected += a[i * k + p] * b[p * n + j];
+      }
+      EXPECT_NEAR(c[i * n + j], expected, 1e-3);
+    }
+  }
+
+  size_t wrong_size[2] = {n, k};
+  auto wrong = FloatTensor(b.data(), wrong_size, 2);
+  EXPECT_THROW(spmm(csr, wrong, c_t), std::invalid_argument);
+}
+
+TEST(SparseOpsTest, SparseOpsAddSparse) {
+  float s[2][3] = {{0, 1, 0}, {2, 0, 0}};
+  float d[2][3] = {{1, 1, 1}, {1, 1, 1}};
+  float expected_values[6] = {1, 3, 1, 5, 1, 1};
+  size_t size[2] = {2, 3};
+  auto s_t = FloatTensor(&s[0][0], size, 2);
+  auto d_t = FloatTensor(&d[0][0], size, 2);
+  CsrTensor csr(s_t);
+  add_sparse_(d_t, csr, 2);
+  for (size_t i = 0; i < d_t.numel_; ++i) {
+    EXPECT_EQ(d_t.data_[i], expected_values[i]);
+  }
+}
+
+TEST(SparseOpsTest, SparseOpsMulDense) {
+  float s[2][3] = {{0, 1, 0}, {2, 0, 4}};
+  float d[2][3] = {{5, 3, 5}, {4, 5, 0.5f}};
+  float expected_values[3] = {3, 8, 2};
+  size_t size[2] = {2, 3};
+  auto s_t = FloatTensor(&s[0][0], size, 2);
+  auto d_t = FloatTensor(&d[0][0], size, 2);
+  CsrTensor csr(s_t);
+  mul_dense_(csr, d_t);
+  EXPECT_EQ(csr.nnz(), 3);
+  for (size_t i = 0; i < csr.nnz(); ++i) {
+    EXPECT_EQ(csr.values_[i], expected_values[i]);
+  }
+}
+
+} // namespace focus
@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// stream_test.cpp
+//
+// Identification: test/runtime/stream_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "runtime/stream.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace focus {
+
+TEST(StreamTest, StreamRunsInOrder) {
+  ThreadPool pool(4);
+  Scheduler scheduler(pool);
+  Stream stream(scheduler);
+
+  float a[4] = {1, 2, 3, 4};
+  float b[4] = {1, 1, 1, 1};
+  float expected_values[4] = {4, 6, 8, 10};
+  size_t size[1] = {4};
+  auto x = FloatTensor(a, size, 1);
+  auto y = FloatTensor(b, size, 1);
+  stream.add_(x, y);
+  stream.mul_(x, 2);
+  float total = 0;
+  stream.sum_(x, &total);
+  stream.synchronize();
+  for (size_t i = 0; i < x.numel_; ++i) {
+    EXPECT_EQ(x.data_[i], expected_values[i]);
+  }
+  EXPECT_EQ(total, 28);
+}
+
+TEST(StreamTest, StreamIndependentOpsOverlap) {
+  ThreadPool pool(4);
+  Scheduler scheduler(pool);
+  Stream first(scheduler);
+  Stream second(scheduler);
+
+  float a[1] = {0};
+  float b[1] = {0};
+  size_t size[1] = {1};
+  auto x = FloatTensor(a, size, 1);
+  auto y = FloatTensor(b, size, 1);
+
+  // The first op can only finish once the second one has started, which
+  // requires them to run concurrently.
+  std::promise<void> started;
+  std::shared_future<void> signal = started.get_future().share();
+  Event waiting = first.enqueue({}, {&x}, [signal] {
+    if (signal.wait_for(std::chrono::seconds(10)) !=
+        std::future_status::ready) {
+      throw std::runtime_error("ops were serialized");
+    }
+  });
+  second.enqueue({}, {&y}, [&started] { started.set_value(); });
+  EXPECT_NO_THROW(waiting.wait());
+  scheduler.synchronize();
+}
+
+TEST(StreamTest, StreamConflictingOpsAreOrdered) {
+  ThreadPool pool(4);
+  Scheduler scheduler(pool);
+  Stream writer(scheduler);
+  Stream reader(scheduler);
+
+  float a[2] = {1, 1};
+  size_t size[1] = {2};
+  auto x = FloatTensor(a, size, 1);
+
+  // Read-after-write across streams.
+  writer.enqueue({}, {&x}, [&x] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    x.mul_(3);
+  });
+  float total = 0;
+  reader.sum_(x, &total);
+  reader.synchronize();
+  EXPECT_EQ(total, 6);
+
+  // Write-after-read across streams.
+  std::atomic<bool> read_done(false);
+  reader.enqueue({&x}, {}, [&read_done] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    read_done.store(true);
+  });
+  bool saw_read = false;
+  writer.enqueue({}, {&x}, [&] { saw_read = read_done.load(); });
+  scheduler.synchronize();
+  EXPECT_TRUE(saw_read);
+}
+
+TEST(StreamTest, StreamPropagatesErrors) {
+  ThreadPool pool(2);
+  Scheduler scheduler(pool);
+  Stream stream(scheduler);
+
+  float a[1] = {1};
+  size_t size[1] = {1};
+  auto x = FloatTensor(a, size, 1);
+  Event failed = stream.enqueue(
+      {}, {&x}, [] { throw std::runtime_error("op failed"); });
+  bool ran = false;
+  Event skipped = stream.enqueue({&x}, {}, [&ran] { ran = true; });
+  EXPECT_THROW(failed.wait(), std::runtime_error);
+  EXPECT_THROW(skipped.wait(), std::runtime_error);
+  EXPECT_FALSE(ran);
+}
+
+TEST(StreamTest, StreamRecoversAfterSynchronize) {
+  ThreadPool pool(2);
+  Scheduler scheduler(pool);
+  Stream stream(scheduler);
+
+  float a[1] = {1};
+  float b[1] = {1};
+  size_t size[1] = {1};
+  auto x = FloatTensor(a, size, 1);
+  auto y = FloatTensor(b, size, 1);
+  stream.enqueue({}, {&x}, [] { throw std::runtime_error("op failed"); });
+  EXPECT_THROW(stream.synchronize(), std::runtime_error);
+
+  // The failure is surfaced once; untouched buffers work right away.
+  stream.mul_(y, 3);
+  EXPECT_NO_THROW(stream.synchronize());
+  EXPECT_EQ(b[0], 3);
+
+  // The failed buffer works again once the scheduler has synchronized.
+  scheduler.synchronize();
+  stream.mul_(x, 2);
+  EXPECT_NO_THROW(stream.synchronize());
+  EXPECT_EQ(a[0], 2);
+}
+
+TEST(StreamTest, StreamForgetsFinishedBuffers) {
+  ThreadPool pool(2);
+  Scheduler scheduler(pool);
+  Stream stream(scheduler);
+
+  float values[64] = {};
+  size_t size[1] = {1};
+  std::vector<Event> events;
+  for (size_t i = 0; i < 64; ++i) {
+    FloatTensor x(values + i, size, 1);
+    events.push_back(stream.mul_(x, 2));
+    events.back().wait();
+  }
+  EXPECT_EQ(scheduler.tracked_buffers(), 0u);
+
+  // A failed writer is remembered until synchronization.
+  float a[1] = {1};
+  auto y = FloatTensor(a, size, 1);
+  Event failed = stream.enqueue(
+      {}, {&y}, [] { throw std::runtime_error("op failed"); });
+  EXPECT_THROW(failed.wait(), std::runtime_error);
+  EXPECT_EQ(scheduler.tracked_buffers(), 1u);
+  scheduler.synchronize();
+  EXPECT_EQ(scheduler.tracked_buffers(), 0u);
+}
+
+} // namespace focus
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// batch_scheduler_test.cpp
+//
+// Identification: test/serving/batch_scheduler_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "serving/batch_scheduler.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace focus {
+
+// Doubles every element, and records the largest batch it was handed.
+struct DoubleForward {
+  size_t *max_seen;
+  void operator()(FloatTensor &input, FloatTensor &output) {
+    if (input.size_[0] > *max_seen) {
+      *max_seen = input.size_[0];
+    }
+    for (size_t i = 0; i < input.numel_; ++i) {
+      output.data_[i] = 2 * input.data_[i];
+    }
+  }
+};
+
+// Synthetic load generator: `num_threads` clients each submit
+// `requests_per_thread` samples back to back and check every result.
+void run_synthetic_load(BatchScheduler &scheduler, size_t num_threads,
+                        size_t requests_per_thread, size_t sample_numel) {
+  std::vector<std::thread> clients;
+  for (size_t t = 0; t < num_threads; ++t) {
+    clients.push_back(std::thread([&, t] {
+      std::vector<float> in(sample_numel);
+      std::vector<float> out(sample_numel);
+      size_t size[1] = {sample_numel};
+      FloatTensor input(in.data(), size, 1);
+      FloatTensor output(out.data(), size, 1);
+      for (size_t r = 0; r < requests_per_thread; ++r) {
+        for (size_t i = 0; i < sample_numel; ++i) {
+          in[i] = static_cast<float>(t * 1000 + r + i);
+        }
+        scheduler.submit(input, output).get();
+        for (size_t i = 0; i < sample_numel; ++i) {
+          EXPECT_EQ(out[i], 2 * in[i]);
+        }
+      }
+    }));
+  }
+  for (size_t t = 0; t < clients.size(); ++t) {
+    clients[t].join();
+  }
+}
+
+TEST(BatchSchedulerTest, BatchSchedulerSingleRequest) {
+  size_t max_seen = 0;
+  size_t input_size[2] = {2, 3};
+  size_t output_size[2] = {2, 3};
+  BatchScheduler scheduler(DoubleForward{&max_seen}, input_size, 2,
+                           output_size, 2);
+
+  float in[2][3] = {{1, 2, 3}, {4, 5, 6}};
+  float out[2][3] = {};
+  float expected_values[6] = {2, 4, 6, 8, 10, 12};
+  auto input = FloatTensor(&in[0][0], input_size, 2);
+  auto output = FloatTensor(&out[0][0], output_size, 2);
+  scheduler.submit(input, output).get();
+  for (size_t i = 0; i < output.numel_; ++i) {
+    EXPECT_EQ(output.data_[i], expected_values[i]);
+  }
+  EXPECT_EQ(max_seen, 1);
+}
+
+TEST(BatchSchedulerTest, BatchSchedulerSyntheticLoad) {
+  size_t max_seen = 0;
+  size_t sample_size[1] = {8};
+  BatchSchedulerOptions options;
+  options.max_batch_size_ = 4;
+  options.max_latency_ = std::chrono::microseconds(2000);
+  BatchScheduler scheduler(DoubleForward{&max_seen}, sample_size, 1,
+                           sample_size, 1, options);
+
+  size_t num_threads = 8;
+  size_t requests_per_thread = 50;
+  run_synthetic_load(scheduler, num_threads, requests_per_thread, 8);
+
+  auto stats = scheduler.stats();
+  EXPECT_EQ(stats.num_requests_, num_threads * requests_per_thread);
+  EXPECT_LE(stats.num_batches_, stats.num_requests_);
+  EXPECT_LE(max_seen, options.max_batch_size_);
+  EXPECT_GT(stats.throughput_, 0);
+  EXPECT_LE(stats.p50_latency_us_, stats.p90_latency_us_);
+  EXPECT_LE(stats.p90_latency_us_, stats.p99_latency_us_);
+}
+
+TEST(BatchSchedulerTest, BatchSchedulerShapeMismatch) {
+  size_t max_seen = 0;
+  size_t sample_size[1] = {4};
+  BatchScheduler scheduler(DoubleForward{&max_seen}, sample_size, 1,
+                           sample_size, 1);
+
+  float in[3] = {1, 2, 3};
+  float out[4] = {};
+  size_t wrong_size[1] = {3};
+  auto input = FloatTensor(in, wrong_size, 1);
+  auto output = FloatTensor(out, sample_size, 1);
+  EXPECT_THROW(scheduler.submit(input, output), std::invalid_argument);
+}
+
+TEST(BatchSchedulerTest, BatchSchedulerForwardError) {
+  size_t sample_size[1] = {2};
+  BatchScheduler scheduler(
+      [](FloatTensor &, FloatTensor &) {
+        throw std::runtime_error("forward failed");
+      },
+      sample_size, 1, sample_size, 1);
+
+  float in[2] = {1, 2};
+  float out[2] = {};
+  auto input = FloatTensor(in, sample_size, 1);
+  auto output = FloatTensor(out, sample_size, 1);
+  auto result = scheduler.submit(input, output);
+  EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+} // namespace focus
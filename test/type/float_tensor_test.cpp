@@ -11,6 +11,10 @@
 #include "type/float_tensor.h"
 #include "gtest/gtest.h"
 
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 namespace focus {
 
 // clang-format off
@@ -774,4 +778,49 @@ TEST(FloatTensorTest, FloatTensorSum) {
   }
 }
 
+TEST(FloatTensorTest, FrozenTensorRejectsWrites) {
+  reset_A();
+  size_t size[2] = {2, 2};
+  size_t ndim = 2;
+  auto x = FloatTensor(&A[0][0], size, ndim);
+  auto y = FloatTensor(&A[0][0], size, ndim);
+  x.freeze_();
+  EXPECT_TRUE(x.frozen_);
+  EXPECT_THROW(x.add_(1), std::logic_error);
+  EXPECT_THROW(x.add_(y), std::logic_error);
+  EXPECT_THROW(x.sub_(1), std::logic_error);
+  EXPECT_THROW(x -= 1, std::logic_error);
+  EXPECT_THROW(x.mul_(2), std::logic_error);
+  EXPECT_THROW(x /= 2, std::logic_error);
+  EXPECT_EQ(x.sum_(), 10);
+
+  // A frozen tensor can still be the source of another tensor's update.
+  auto z = FloatTensor(&A[0][0], size, ndim, false, true);
+  z.add_(x);
+  EXPECT_EQ(z.sum_(), 20);
+}
+
+TEST(FloatTensorTest, FrozenPlacedTensorIsSharedAcrossThreads) {
+  std::vector<float> values(1 << 16);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i % 4);
+  }
+  size_t size[1] = {values.size()};
+  FloatTensor storage(values.data(), size, 1, PlacementOptions());
+  storage.freeze_();
+  const FloatTensor &weights = storage;
+
+  std::vector<float> sums(4);
+  std::vector<std::thread> readers;
+  for (size_t t = 0; t < sums.size(); ++t) {
+    readers.emplace_back([&, t] { sums[t] = weights.sum_(); });
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  for (size_t t = 0; t < sums.size(); ++t) {
+    EXPECT_EQ(sums[t], 1.5f * values.size());
+  }
+}
+
 } // namespace focus
@@ -0,0 +1,164 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// paged_tensor_test.cpp
+//
+// Identification: test/type/paged_tensor_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/paged_tensor.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace focus {
+
+PagedTensorOptions small_chunks(size_t chunk_numel, size_t budget_chunks) {
+  PagedTensorOptions options;
+  options.chunk_numel_ = chunk_numel;
+  options.memory_budget_ = budget_chunks * chunk_numel * sizeof(float);
+  return options;
+}
+
+TEST(PagedTensorTest, SpillsAndFaultsBackUnderBudget) {
+  size_t size[2] = {100, 103};
+  PagedTensor x(size, 2, small_chunks(1000, 3));
+  EXPECT_EQ(x.numel_, 10300u);
+  EXPECT_EQ(x.num_chunks(), 11u);
+  EXPECT_EQ(x.chunk_size(10), 300u);
+
+  std::vector<float> values(x.numel_);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i % 101);
+  }
+  x.copy_from(values.data());
+  EXPECT_LE(x.resident_chunks(), 3u);
+
+  x.mul_(2);
+  x.add_(1);
+  std::vector<float> out(x.numel_);
+  x.copy_to(out.data());
+  double expected_sum = 0;
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i], 2 * values[i] + 1);
+    expected_sum += out[i];
+  }
+  EXPECT_FLOAT_EQ(x.sum_(), static_cast<float>(expected_sum));
+
+  PagedTensorStats stats = x.stats();
+  EXPECT_GT(stats.evictions_, 0u);
+  EXPECT_GT(stats.writebacks_, 0u);
+  EXPECT_GT(stats.faults_, 0u);
+  EXPECT_LE(x.resident_chunks(), 3u);
+}
+
+TEST(PagedTensorTest, UnwrittenChunksReadAsZero) {
+  size_t size[1] = {5000};
+  PagedTensor x(size, 1, small_chunks(512, 2));
+  EXPECT_EQ(x.sum_(), 0);
+  PagedTensorStats stats = x.stats();
+  EXPECT_EQ(stats.writebacks_, 0u);
+  EXPECT_EQ(stats.faults_, 0u);
+}
+
+TEST(PagedTensorTest, PinnedChunksExceedBudget) {
+  size_t size[1] = {4096};
+  PagedTensor x(size, 1, small_chunks(1024, 1));
+  float *a = x.pin(0, true);
+  float *b = x.pin(1, true);
+  float *c = x.pin(2, true);
+  a[0] = 1;
+  b[0] = 2;
+  c[0] = 3;
+  EXPECT_EQ(x.resident_chunks(), 3u);
+  x.unpin(0);
+  x.unpin(1);
+  x.unpin(2);
+
+  // The next fault trims back down to the budget.
+  x.pin(3, false);
+  x.unpin(3);
+  EXPECT_EQ(x.resident_chunks(), 1u);
+  EXPECT_EQ(x.pin(1, false)[0], 2);
+  x.unpin(1);
+
+  EXPECT_THROW(x.unpin(1), std::logic_error);
+  EXPECT_THROW(x.pin(4, false), std::out_of_range);
+}
+
+TEST(PagedTensorTest, AddAcrossDifferentChunkGrids) {
+  size_t size[1] = {3001};
+  PagedTensor x(size, 1, small_chunks(700, 2));
+  PagedTensor y(size, 1, small_chunks(256, 3));
+  std::vector<float> a(3001), b(3001);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i);
+    b[i] = 0.5f * static_cast<float>(i % 17);
+  }
+  x.copy_from(a.data());
+  y.copy_from(b.data());
+  x.add_(y);
+  std::vector<float> out(3001);
+  x.copy_to(out.data());
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i], a[i] + b[i]);
+  }
+
+  size_t other_size[1] = {3000};
+  PagedTensor z(other_size, 1, small_chunks(256, 3));
+  EXPECT_THROW(x.add_(z), std::invalid_argument);
+}
+
+TEST(PagedTensorTest, PrefetchLoadsInBackground) {
+  size_t size[1] = {8192};
+  PagedTensor x(size, 1, small_chunks(1024, 4));
+  std::vector<float> values(8192, 3);
+  x.copy_from(values.data());
+
+  // Chunk 0 was spilled by the sequential copy.
+  x.prefetch(0);
+  for (size_t i = 0; i < 2000 && x.stats().prefetches_ == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_GT(x.stats().prefetches_, 0u);
+  EXPECT_EQ(x.pin(0, false)[1023], 3);
+  x.unpin(0);
+}
+
+TEST(PagedTensorTest, ConcurrentReadersSeeConsistentData) {
+  size_t size[1] = {64 * 128};
+  PagedTensor x(size, 1, small_chunks(128, 4));
+  std::vector<float> values(x.numel_);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i);
+  }
+  x.copy_from(values.data());
+
+  std::vector<std::thread> readers;
+  std::vector<size_t> mismatches(4, 0);
+  for (size_t t = 0; t < 4; ++t) {
+    readers.emplace_back([&, t] {
+      for (size_t step = 0; step < 200; ++step) {
+        size_t chunk = (step * 7 + t * 13) % x.num_chunks();
+        const float *data = x.pin(chunk, false);
+        for (size_t i = 0; i < 128; ++i) {
+          mismatches[t] += data[i] != values[chunk * 128 + i];
+        }
+        x.unpin(chunk);
+      }
+    });
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  for (size_t t = 0; t < 4; ++t) {
+    EXPECT_EQ(mismatches[t], 0u);
+  }
+}
+
+} // namespace focus
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//               Foundational Operations for Convolutions (FOCUS)
+//
+// sparse_tensor_test.cpp
+//
+// Identification: test/type/sparse_tensor_test.cpp
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/sparse_tensor.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+namespace focus {
+
+// clang-format off
+float S[3][4] = {
+  {0, 1, 0, 0},
+  {0, 0, 0, 0},
+  {2, 0, 0, 3}
+};
+// clang-format on
+
+TEST(SparseTensorTest, CsrFromDense) {
+  size_t size[2] = {3, 4};
+  auto x = FloatTensor(&S[0][0], size, 2);
+  CsrTensor csr(x);
+  size_t expected_row_ptr[4] = {0, 1, 1, 3};
+  uint32_t expected_cols[3] = {1, 0, 3};
+  float expected_values[3] = {1, 2, 3};
+  EXPECT_EQ(csr.nnz(), 3);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(csr.row_ptr_[i], expected_row_ptr[i]);
+  }
+  for (size_t i = 0; i < csr.nnz(); ++i) {
+    EXPECT_EQ(csr.col_indices_[i], expected_cols[i]);
+    EXPECT_EQ(csr.values_[i], expected_values[i]);
+  }
+}
+
+TEST(SparseTensorTest, CsrToDense) {
+  size_t size[2] = {3, 4};
+  auto x = FloatTensor(&S[0][0], size, 2);
+  CsrTensor csr(x);
+  float out[3][4];
+  auto y = FloatTensor(&out[0][0], size, 2);
+  csr.to_dense(y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], x.data_[i]);
+  }
+}
+
+TEST(SparseTensorTest, CooRoundTrip) {
+  size_t size[2] = {3, 4};
+  auto x = FloatTensor(&S[0][0], size, 2);
+  CooTensor coo(x);
+  EXPECT_EQ(coo.nnz(), 3);
+  float out[3][4];
+  auto y = FloatTensor(&out[0][0], size, 2);
+  coo.to_dense(y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], x.data_[i]);
+  }
+
+  CooTensor back = CsrTensor(coo).to_coo();
+  EXPECT_EQ(back.nnz(), 3);
+  back.to_dense(y);
+  for (size_t i = 0; i < y.numel_; ++i) {
+    EXPECT_EQ(y.data_[i], x.data_[i]);
+  }
+}
+
+TEST(SparseTensorTest, CsrFromUnsortedCoo) {
+  CooTensor coo(2, 3);
+  coo.push_back(1, 2, 1);
+  coo.push_back(0, 1, 2);
+  coo.push_back(1, 0, 3);
+  coo.push_back(1, 2, 4);
+  CsrTensor csr(coo);
+  size_t expected_row_ptr[3] = {0, 1, 3};
+  uint32_t expected_cols[3] = {1, 0, 2};
+  float expected_values[3] = {2, 3, 5};
+  EXPECT_EQ(csr.nnz(), 3);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(csr.row_ptr_[i], expected_row_ptr[i]);
+  }
+  for (size_t i = 0; i < csr.nnz(); ++i) {
+    EXPECT_EQ(csr.col_indices_[i], expected_cols[i]);
+    EXPECT_EQ(csr.values_[i], expected_values[i]);
+  }
+  EXPECT_THROW(coo.push_back(2, 0, 1), std::out_of_range);
+}
+
+} // namespace focus